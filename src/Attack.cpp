@@ -21,8 +21,7 @@
 #include "Attack.h"
 
 Attack::Attack() {
-	fileName = wxT("DUMMY");
-	fullPath = wxT("DUMMY");
+	m_path = SamplePath(wxT("DUMMY"));
 	loadRelease = true;
 	attackVelocity = 0;
 	maxTimeSinceLastRelease = -1;
@@ -31,23 +30,7 @@ Attack::Attack() {
 	attackStart = 0;
 	cuePoint = -1;
 	releaseEnd = -1;
-}
-
-Attack::Attack(const Attack& att) {
-	fileName = att.fileName;
-	fullPath = att.fullPath;
-	loadRelease = att.loadRelease;
-	attackVelocity = att.attackVelocity;
-	maxTimeSinceLastRelease = att.maxTimeSinceLastRelease;
-	isTremulant = att.isTremulant;
-	maxKeyPressTime = att.maxKeyPressTime;
-	attackStart = att.attackStart;
-	cuePoint = att.cuePoint;
-	releaseEnd = att.releaseEnd;
-}
-
-Attack::~Attack() {
-
+	releaseMarkerConfidence = -1;
 }
 
 Loop* Attack::getLoopAt(unsigned index) {
@@ -64,3 +47,27 @@ void Attack::removeLoopAt(unsigned index) {
 	std::advance(it, index);
 	m_loops.erase(it);
 }
+
+wxString Attack::getFileName() const {
+	return m_path.getRelativePath();
+}
+
+wxString Attack::getFullPath() const {
+	return m_path.getFullPath();
+}
+
+void Attack::setFullPath(wxString fullPath) {
+	m_path = SamplePath(fullPath);
+}
+
+const SamplePath& Attack::getSamplePath() const {
+	return m_path;
+}
+
+bool Attack::isDummy() const {
+	return m_path.isDummy();
+}
+
+bool Attack::isReference() const {
+	return m_path.isReference();
+}
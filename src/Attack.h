@@ -23,20 +23,23 @@
 
 #include <wx/wx.h>
 #include "Loop.h"
+#include "SamplePath.h"
 #include <list>
 
 class Attack {
 public:
 	Attack();
-	Attack(const Attack& att);
-	~Attack();
 
 	Loop* getLoopAt(unsigned index);
 	void addNewLoop(Loop l);
 	void removeLoopAt(unsigned index);
+	wxString getFileName() const;
+	wxString getFullPath() const;
+	void setFullPath(wxString fullPath);
+	const SamplePath& getSamplePath() const;
+	bool isDummy() const;
+	bool isReference() const;
 
-	wxString fileName;
-	wxString fullPath;
 	bool loadRelease;
 	int attackVelocity;
 	int maxTimeSinceLastRelease;
@@ -45,8 +48,14 @@ public:
 	int attackStart;
 	int cuePoint;
 	int releaseEnd;
+	// how certain the analysis was of the cue point and release end it set,
+	// -1 when they weren't set by analysis. It's never written to the odf.
+	float releaseMarkerConfidence;
 	std::list<Loop> m_loops;
 
+private:
+	SamplePath m_path;
+
 };
 
 #endif
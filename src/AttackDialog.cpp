@@ -22,7 +22,9 @@
 #include "GOODFFunctions.h"
 #include "GOODF.h"
 #include <wx/statline.h>
-#include "WAVfileParser.h"
+#include <wx/choicdlg.h>
+#include "LoopFinder.h"
+#include "ReleaseMarkerDetector.h"
 
 IMPLEMENT_CLASS(AttackDialog, wxDialog)
 
@@ -40,6 +42,7 @@ BEGIN_EVENT_TABLE(AttackDialog, wxDialog)
 	EVT_SPINCTRL(ID_ATK_DIALOG_END_SPIN, AttackDialog::OnReleaseEndSpin)
 	EVT_LISTBOX(ID_ATK_DIALOG_LOOP_LIST, AttackDialog::OnLoopListSelection)
 	EVT_BUTTON(ID_ATK_DIALOG_ADD_LOOP_BTN, AttackDialog::OnAddLoopBtn)
+	EVT_BUTTON(ID_ATK_DIALOG_FIND_LOOP_BTN, AttackDialog::OnFindLoopBtn)
 	EVT_BUTTON(ID_ATK_DIALOG_DELETE_LOOP_BTN, AttackDialog::OnRemoveLoopBtn)
 	EVT_SPINCTRL(ID_ATK_DIALOG_LOOP_START_SPIN, AttackDialog::OnLoopStartSpin)
 	EVT_SPINCTRL(ID_ATK_DIALOG_LOOP_END_SPIN, AttackDialog::OnLoopEndSpin)
@@ -318,6 +321,13 @@ void AttackDialog::CreateControls() {
 	fifthRow->Add(m_releaseEndSpin, 0, wxEXPAND|wxALL, 5);
 	mainSizer->Add(fifthRow, 0, wxGROW);
 
+	m_releaseMarkerText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxEmptyString
+	);
+	mainSizer->Add(m_releaseMarkerText, 0, wxGROW|wxALL, 5);
+
 	wxBoxSizer *sixthRow = new wxBoxSizer(wxHORIZONTAL);
 	wxBoxSizer *loopListContainer = new wxBoxSizer(wxVERTICAL);
 	wxStaticText *loopListText = new wxStaticText (
@@ -340,6 +350,12 @@ void AttackDialog::CreateControls() {
 		wxT("Create a new loop")
 	);
 	loopBtnContainer->Add(m_addNewLoopBtn, 0, wxGROW|wxALIGN_CENTER|wxALL, 5);
+	m_findLoopBtn = new wxButton(
+		this,
+		ID_ATK_DIALOG_FIND_LOOP_BTN,
+		wxT("Find a loop in the sample...")
+	);
+	loopBtnContainer->Add(m_findLoopBtn, 0, wxGROW|wxALIGN_CENTER|wxALL, 5);
 	m_deleteLoopBtn = new wxButton(
 		this,
 		ID_ATK_DIALOG_DELETE_LOOP_BTN,
@@ -505,11 +521,15 @@ void AttackDialog::OnAttackStartSpin(wxSpinEvent& WXUNUSED(event)) {
 
 void AttackDialog::OnCuePointSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_currentAttack->cuePoint = m_cuePointSpin->GetValue();
+	m_currentAttack->releaseMarkerConfidence = -1;
+	UpdateReleaseMarkerText();
 	m_copyPropertiesBtn->Enable();
 }
 
 void AttackDialog::OnReleaseEndSpin(wxSpinEvent& WXUNUSED(event)) {
 	m_currentAttack->releaseEnd = m_releaseEndSpin->GetValue();
+	m_currentAttack->releaseMarkerConfidence = -1;
+	UpdateReleaseMarkerText();
 	m_copyPropertiesBtn->Enable();
 }
 
@@ -540,6 +560,48 @@ void AttackDialog::OnAddLoopBtn(wxCommandEvent& WXUNUSED(event)) {
 	LoopInListSelected();
 }
 
+void AttackDialog::OnFindLoopBtn(wxCommandEvent& WXUNUSED(event)) {
+	LoopFinder finder;
+	bool found;
+	{
+		wxBusyCursor busy;
+		found = finder.findLoops(m_currentAttack->getFullPath(), m_currentAttack->attackStart, m_currentAttack->cuePoint);
+	}
+	if (!found) {
+		wxMessageDialog msg(this, finder.getErrorMessage(), wxT("No loop found"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+		return;
+	}
+
+	const std::vector<LoopCandidate> &candidates = finder.getCandidates();
+	wxArrayString candidateChoices;
+	for (const LoopCandidate& candidate : candidates) {
+		candidateChoices.Add(wxString::Format(
+			wxT("%d - %d (%d frames), seam error %.2f %%, correlation %.4f"),
+			candidate.loop.start,
+			candidate.loop.end,
+			candidate.loop.end - candidate.loop.start + 1,
+			candidate.seamError * 100,
+			candidate.correlation
+		));
+	}
+	wxSingleChoiceDialog loopDialog(
+		this,
+		wxT("The loops with the smallest seam error come first."),
+		wxT("Pick a loop to add"),
+		candidateChoices
+	);
+	if (loopDialog.ShowModal() != wxID_OK)
+		return;
+
+	m_currentAttack->addNewLoop(candidates[loopDialog.GetSelection()].loop);
+	UpdateLoopChoices();
+	unsigned lastLoopIndex = m_loopsList->GetCount() - 1;
+	m_loopsList->SetSelection(lastLoopIndex);
+	m_selectedLoop = m_currentAttack->getLoopAt(lastLoopIndex);
+	LoopInListSelected();
+}
+
 void AttackDialog::OnRemoveLoopBtn(wxCommandEvent& WXUNUSED(event)) {
 	if (m_loopsList->GetSelection() != wxNOT_FOUND) {
 		unsigned indexToRemove = m_loopsList->GetSelection();
@@ -595,9 +657,9 @@ void AttackDialog::SetButtonState() {
 
 void AttackDialog::TransferAttackValuesToWindow() {
 	m_attackLabel->SetLabel(wxString::Format(wxT("Attack%s"), GOODF_functions::number_format(m_selectedAttackIndex + 1)));
-	m_attackName->SetLabel(m_currentAttack->fileName);
-	m_attackPath->SetLabel(m_currentAttack->fullPath);
-	if (m_currentAttack->fullPath.IsSameAs(wxT("DUMMY"))) {
+	m_attackName->SetLabel(m_currentAttack->getFileName());
+	m_attackPath->SetLabel(m_currentAttack->getFullPath());
+	if (m_currentAttack->isDummy()) {
 		// almoast everything should be set to default and disabled
 		m_loadReleaseYes->SetValue(true);
 		m_loadReleaseNo->SetValue(false);
@@ -619,13 +681,14 @@ void AttackDialog::TransferAttackValuesToWindow() {
 		m_cuePointSpin->Disable();
 		m_releaseEndSpin->Disable();
 		m_addNewLoopBtn->Disable();
+		m_findLoopBtn->Disable();
 		m_deleteLoopBtn->Disable();
 		m_loopStartSpin->Disable();
 		m_loopEndSpin->Disable();
 	} else {
-		WAVfileParser sample(m_currentAttack->fullPath);
-		if (sample.isWavOk()) {
-			m_maxSampleFrames = sample.getNumberOfFrames() - 1;
+		SampleMetadata sample;
+		if (::wxGetApp().m_sampleMetadataCache->getMetadata(m_currentAttack->getFullPath(), sample) && sample.isOk) {
+			m_maxSampleFrames = sample.numberOfFrames - 1;
 			m_attackStartSpin->SetRange(0, m_maxSampleFrames);
 			m_cuePointSpin->SetRange(-1, m_maxSampleFrames);
 			m_releaseEndSpin->SetRange(-1, m_maxSampleFrames);
@@ -636,6 +699,7 @@ void AttackDialog::TransferAttackValuesToWindow() {
 		} else {
 			m_maxSampleFrames = 158760000;
 		}
+		m_findLoopBtn->Enable(!m_currentAttack->isReference());
 
 		if (m_currentAttack->loadRelease) {
 			m_loadReleaseYes->SetValue(true);
@@ -654,6 +718,18 @@ void AttackDialog::TransferAttackValuesToWindow() {
 
 		UpdateLoopChoices();
 	}
+	UpdateReleaseMarkerText();
+}
+
+void AttackDialog::UpdateReleaseMarkerText() {
+	// markers set by hand are trusted and once edited the analysis no longer matters
+	float confidence = m_currentAttack->releaseMarkerConfidence;
+	if (confidence < 0)
+		m_releaseMarkerText->SetLabel(wxEmptyString);
+	else if (confidence < DOUBTFUL_RELEASE_CONFIDENCE)
+		m_releaseMarkerText->SetLabel(wxString::Format(wxT("Cuepoint and release end were found by analysis with a low confidence of %.2f, please listen to them!"), confidence));
+	else
+		m_releaseMarkerText->SetLabel(wxString::Format(wxT("Cuepoint and release end were found by analysis with a confidence of %.2f."), confidence));
 }
 
 void AttackDialog::SetLoopStartAndEndRanges() {
@@ -665,7 +741,7 @@ void AttackDialog::UpdateLoopChoices() {
 	m_currentAttack = GetAttackIterator(m_selectedAttackIndex);
 	loopChoices.Empty();
 	unsigned counter = 0;
-	for (Loop l : m_currentAttack->m_loops) {
+	for (const Loop& l : m_currentAttack->m_loops) {
 		counter++;
 		loopChoices.Add(wxString::Format(wxT("Loop%s"), GOODF_functions::number_format(counter)));
 	}
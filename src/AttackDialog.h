@@ -89,8 +89,10 @@ private:
 	wxSpinCtrl *m_attackStartSpin; // 0 - 158760000
 	wxSpinCtrl *m_cuePointSpin; // -1 - 158760000
 	wxSpinCtrl *m_releaseEndSpin; // -1 - 158760000
+	wxStaticText *m_releaseMarkerText;
 	wxListBox *m_loopsList;
 	wxButton *m_addNewLoopBtn;
+	wxButton *m_findLoopBtn;
 	wxButton *m_deleteLoopBtn;
 	wxSpinCtrl *m_loopStartSpin;
 	wxSpinCtrl *m_loopEndSpin;
@@ -109,6 +111,7 @@ private:
 	void OnReleaseEndSpin(wxSpinEvent& event);
 	void OnLoopListSelection(wxCommandEvent& event);
 	void OnAddLoopBtn(wxCommandEvent& event);
+	void OnFindLoopBtn(wxCommandEvent& event);
 	void OnRemoveLoopBtn(wxCommandEvent& event);
 	void OnLoopStartSpin(wxSpinEvent& event);
 	void OnLoopEndSpin(wxSpinEvent& event);
@@ -117,6 +120,7 @@ private:
 	std::list<Attack>::iterator GetAttackIterator(unsigned index);
 	void SetButtonState();
 	void TransferAttackValuesToWindow();
+	void UpdateReleaseMarkerText();
 	void SetLoopStartAndEndRanges();
 	void UpdateLoopChoices();
 	void LoopInListSelected();
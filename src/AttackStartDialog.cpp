@@ -0,0 +1,166 @@
+/*
+ * AttackStartDialog.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "AttackStartDialog.h"
+#include <wx/statline.h>
+
+IMPLEMENT_CLASS(AttackStartDialog, wxDialog)
+
+AttackStartDialog::AttackStartDialog() {
+	Init();
+}
+
+AttackStartDialog::AttackStartDialog(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init();
+	Create(parent, id, caption, pos, size, style);
+}
+
+AttackStartDialog::~AttackStartDialog() {
+
+}
+
+void AttackStartDialog::Init() {
+	m_thresholdSpin = NULL;
+	m_marginSpin = NULL;
+	m_replaceExistingBox = NULL;
+}
+
+bool AttackStartDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void AttackStartDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxStaticText *infoText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("The attack will start where the sound first rises above the threshold, less the margin.")
+	);
+	mainSizer->Add(infoText, 0, wxGROW|wxALL, 5);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *thresholdText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Threshold below the peak of the sample (dB): ")
+	);
+	firstRow->Add(thresholdText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	firstRow->AddStretchSpacer();
+	m_thresholdSpin = new wxSpinCtrl(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		-90,
+		-10,
+		-50
+	);
+	firstRow->Add(m_thresholdSpin, 0, wxEXPAND|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *marginText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Margin kept before the sound (ms): ")
+	);
+	secondRow->Add(marginText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	secondRow->AddStretchSpacer();
+	m_marginSpin = new wxSpinCtrl(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		0,
+		500,
+		5
+	);
+	secondRow->Add(m_marginSpin, 0, wxEXPAND|wxALL, 5);
+	mainSizer->Add(secondRow, 0, wxGROW);
+
+	m_replaceExistingBox = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxT("Also replace attack starts that already are set"),
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_replaceExistingBox->SetValue(false);
+	mainSizer->Add(m_replaceExistingBox, 0, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Find attack starts")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+int AttackStartDialog::GetThreshold() {
+	return m_thresholdSpin->GetValue();
+}
+
+int AttackStartDialog::GetMargin() {
+	return m_marginSpin->GetValue();
+}
+
+bool AttackStartDialog::GetReplaceExisting() {
+	return m_replaceExistingBox->GetValue();
+}
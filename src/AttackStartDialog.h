@@ -0,0 +1,72 @@
+/*
+ * AttackStartDialog.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ATTACKSTARTDIALOG_H
+#define ATTACKSTARTDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/spinctrl.h>
+
+// Asks for the options of an AttackStartFinder
+class AttackStartDialog : public wxDialog {
+	DECLARE_CLASS(AttackStartDialog)
+
+public:
+	// Constructors
+	AttackStartDialog();
+	AttackStartDialog(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Find Attack Starts"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~AttackStartDialog();
+
+	// Initialize our variables
+	void Init();
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Find Attack Starts"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	int GetThreshold();
+	int GetMargin();
+	bool GetReplaceExisting();
+
+private:
+	wxSpinCtrl *m_thresholdSpin;
+	wxSpinCtrl *m_marginSpin;
+	wxCheckBox *m_replaceExistingBox;
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * AttackStartFinder.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "AttackStartFinder.h"
+#include "OnsetDetector.h"
+#include <climits>
+
+AttackStartFinder::AttackStartFinder(double thresholdDb, double marginMs, bool replaceExisting) {
+	m_thresholdDb = thresholdDb;
+	m_marginMs = marginMs;
+	m_replaceExisting = replaceExisting;
+}
+
+AttackStartFinder::~AttackStartFinder() {
+
+}
+
+void AttackStartFinder::addRank(Rank *rank) {
+	for (Pipe& pipe : rank->m_pipes) {
+		for (Attack& atk : pipe.m_attacks) {
+			if (atk.isDummy() || atk.isReference())
+				continue;
+			if (atk.attackStart != 0 && !m_replaceExisting)
+				continue;
+
+			FoundStart start;
+			start.attack = &atk;
+			start.fullPath = atk.getFullPath();
+			start.currentStart = atk.attackStart;
+			start.limit = INT_MAX;
+			for (const Loop& loop : atk.m_loops) {
+				if (loop.start < start.limit)
+					start.limit = loop.start;
+			}
+			if (atk.cuePoint > 0 && atk.cuePoint < start.limit)
+				start.limit = atk.cuePoint;
+			start.isFound = false;
+			start.attackStart = 0;
+			start.bytesPerFrame = 0;
+			m_starts.push_back(start);
+		}
+	}
+}
+
+void AttackStartFinder::addOrgan(Organ *organ) {
+	for (unsigned i = 0; i < organ->getNumberOfRanks(); i++)
+		addRank(organ->getOrganRankAt(i));
+	for (unsigned i = 0; i < organ->getNumberOfStops(); i++) {
+		Stop *stop = organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank() && stop->getInternalRank())
+			addRank(stop->getInternalRank());
+	}
+}
+
+unsigned AttackStartFinder::getNumberOfAttacks() {
+	return m_starts.size();
+}
+
+bool AttackStartFinder::findAttackStarts(WorkerPool &pool, BackgroundTask *task) {
+	if (task)
+		task->setTotalSteps(m_starts.size());
+
+	pool.parallelFor(m_starts.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+		FoundStart &start = m_starts[i];
+		OnsetDetector detector(m_thresholdDb, m_marginMs);
+		if (detector.findOnset(start.fullPath) && (int) detector.getAttackStart() < start.limit) {
+			start.attackStart = detector.getAttackStart();
+			start.bytesPerFrame = detector.getBytesPerFrame();
+			start.isFound = true;
+			if (task)
+				task->addItemsFound(1);
+		}
+		if (task)
+			task->stepDone();
+	});
+
+	return !(task && task->isCancelled());
+}
+
+void AttackStartFinder::applyAttackStarts() {
+	for (FoundStart& start : m_starts) {
+		if (start.isFound)
+			start.attack->attackStart = start.attackStart;
+	}
+}
+
+unsigned AttackStartFinder::getNumberOfAttacksChanged() {
+	unsigned count = 0;
+	for (const FoundStart& start : m_starts) {
+		if (start.isFound && (int) start.attackStart != start.currentStart)
+			count++;
+	}
+	return count;
+}
+
+unsigned AttackStartFinder::getNumberOfFailures() {
+	unsigned count = 0;
+	for (const FoundStart& start : m_starts) {
+		if (!start.isFound)
+			count++;
+	}
+	return count;
+}
+
+long long AttackStartFinder::getFramesSaved() {
+	long long frames = 0;
+	for (const FoundStart& start : m_starts) {
+		if (start.isFound)
+			frames += (long long) start.attackStart - start.currentStart;
+	}
+	return frames;
+}
+
+long long AttackStartFinder::getBytesSaved() {
+	long long bytes = 0;
+	for (const FoundStart& start : m_starts) {
+		if (start.isFound)
+			bytes += ((long long) start.attackStart - start.currentStart) * start.bytesPerFrame;
+	}
+	return bytes;
+}
+
+wxString AttackStartFinder::getSummary() {
+	return wxString::Format(
+		wxT("AttackStart was changed for %u of %u attacks and %u of them couldn't be analysed.\n%lld frames less are now played and %.1f MB less of audio is preloaded."),
+		getNumberOfAttacksChanged(),
+		(unsigned) m_starts.size(),
+		getNumberOfFailures(),
+		getFramesSaved(),
+		getBytesSaved() / 1048576.0
+	);
+}
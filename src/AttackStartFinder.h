@@ -0,0 +1,73 @@
+/*
+ * AttackStartFinder.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ATTACKSTARTFINDER_H
+#define ATTACKSTARTFINDER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "Organ.h"
+#include "BackgroundTask.h"
+#include "WorkerPool.h"
+
+// Sets the AttackStart of the attacks of a rank or a whole organ to where
+// their sound begins, so that the silence recorded before it is neither
+// played nor kept in memory by GrandOrgue. The onsets are found in parallel
+// by OnsetDetectors and only applied afterwards, so nothing is changed if the
+// search is cancelled. An attack start is never put at or after the first
+// loop or the cue point of the attack.
+class AttackStartFinder {
+public:
+	AttackStartFinder(double thresholdDb, double marginMs, bool replaceExisting);
+	~AttackStartFinder();
+
+	void addRank(Rank *rank);
+	// all the ranks of the organ and the internal ranks of its stops
+	void addOrgan(Organ *organ);
+	unsigned getNumberOfAttacks();
+	// false if cancelled
+	bool findAttackStarts(WorkerPool &pool, BackgroundTask *task = NULL);
+	void applyAttackStarts();
+	unsigned getNumberOfAttacksChanged();
+	unsigned getNumberOfFailures();
+	// compared to the attack starts before, negative if more is played now
+	long long getFramesSaved();
+	long long getBytesSaved();
+	wxString getSummary();
+
+private:
+	class FoundStart {
+	public:
+		Attack *attack;
+		wxString fullPath;
+		int currentStart;
+		int limit;
+		bool isFound;
+		unsigned attackStart;
+		unsigned bytesPerFrame;
+	};
+
+	double m_thresholdDb;
+	double m_marginMs;
+	bool m_replaceExisting;
+	std::vector<FoundStart> m_starts;
+};
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * AudioKernels.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "AudioKernels.h"
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+float AudioKernels::peakAbs(const float *samples, size_t count) {
+	size_t i = 0;
+	float peak = 0;
+#ifdef __SSE2__
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	__m128 peaks = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4)
+		peaks = _mm_max_ps(peaks, _mm_andnot_ps(signMask, _mm_loadu_ps(samples + i)));
+	float lanes[4];
+	_mm_storeu_ps(lanes, peaks);
+	for (int lane = 0; lane < 4; lane++) {
+		if (lanes[lane] > peak)
+			peak = lanes[lane];
+	}
+#endif
+	for (; i < count; i++) {
+		float value = std::fabs(samples[i]);
+		if (value > peak)
+			peak = value;
+	}
+	return peak;
+}
+
+double AudioKernels::sumOfSquares(const float *samples, size_t count) {
+	size_t i = 0;
+	double sum = 0;
+#ifdef __SSE2__
+	__m128d sumLow = _mm_setzero_pd();
+	__m128d sumHigh = _mm_setzero_pd();
+	for (; i + 4 <= count; i += 4) {
+		__m128 values = _mm_loadu_ps(samples + i);
+		__m128 squares = _mm_mul_ps(values, values);
+		sumLow = _mm_add_pd(sumLow, _mm_cvtps_pd(squares));
+		sumHigh = _mm_add_pd(sumHigh, _mm_cvtps_pd(_mm_movehl_ps(squares, squares)));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(sumLow, sumHigh));
+	sum = lanes[0] + lanes[1];
+#endif
+	for (; i < count; i++)
+		sum += (double) samples[i] * samples[i];
+	return sum;
+}
+
+double AudioKernels::dotProduct(const float *first, const float *second, size_t count) {
+	size_t i = 0;
+	double sum = 0;
+#ifdef __SSE2__
+	// two accumulators keep the additions from waiting on each other
+	__m128 sumA = _mm_setzero_ps();
+	__m128 sumB = _mm_setzero_ps();
+	for (; i + 8 <= count; i += 8) {
+		sumA = _mm_add_ps(sumA, _mm_mul_ps(_mm_loadu_ps(first + i), _mm_loadu_ps(second + i)));
+		sumB = _mm_add_ps(sumB, _mm_mul_ps(_mm_loadu_ps(first + i + 4), _mm_loadu_ps(second + i + 4)));
+	}
+	float lanes[4];
+	_mm_storeu_ps(lanes, _mm_add_ps(sumA, sumB));
+	sum = (double) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+	for (; i < count; i++)
+		sum += (double) first[i] * second[i];
+	return sum;
+}
+
+void AudioKernels::applyKWeighting(float *samples, size_t numberOfFrames, unsigned channel, unsigned numberOfChannels, unsigned sampleRate) {
+	// the two stages are calculated for the sample rate as in libebur128
+	const double pi = 3.14159265358979323846;
+	double b[2][3];
+	double a[2][3];
+
+	double f0 = 1681.974450955533;
+	double gainDb = 3.999843853973347;
+	double q = 0.7071752369554196;
+	double k = std::tan(pi * f0 / sampleRate);
+	double vh = std::pow(10.0, gainDb / 20.0);
+	double vb = std::pow(vh, 0.4996667741545416);
+	double a0 = 1.0 + k / q + k * k;
+	b[0][0] = (vh + vb * k / q + k * k) / a0;
+	b[0][1] = 2.0 * (k * k - vh) / a0;
+	b[0][2] = (vh - vb * k / q + k * k) / a0;
+	a[0][1] = 2.0 * (k * k - 1.0) / a0;
+	a[0][2] = (1.0 - k / q + k * k) / a0;
+
+	f0 = 38.13547087602444;
+	q = 0.5003270373238773;
+	k = std::tan(pi * f0 / sampleRate);
+	a0 = 1.0 + k / q + k * k;
+	b[1][0] = 1.0;
+	b[1][1] = -2.0;
+	b[1][2] = 1.0;
+	a[1][1] = 2.0 * (k * k - 1.0) / a0;
+	a[1][2] = (1.0 - k / q + k * k) / a0;
+
+	// the filter is recursive so each channel is one serial pass
+	double z[2][2] = { { 0, 0 }, { 0, 0 } };
+	float *sample = samples + channel;
+	for (size_t i = 0; i < numberOfFrames; i++, sample += numberOfChannels) {
+		double value = *sample;
+		for (int stage = 0; stage < 2; stage++) {
+			double out = b[stage][0] * value + z[stage][0];
+			z[stage][0] = b[stage][1] * value - a[stage][1] * out + z[stage][1];
+			z[stage][1] = b[stage][2] * value - a[stage][2] * out;
+			value = out;
+		}
+		*sample = (float) value;
+	}
+}
+
+void AudioKernels::fft(std::vector<std::complex<float>> &data) {
+	size_t size = data.size();
+	for (size_t i = 1, j = 0; i < size; i++) {
+		size_t bit = size >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		if (i < j)
+			std::swap(data[i], data[j]);
+	}
+
+	const double pi = 3.14159265358979323846;
+	for (size_t length = 2; length <= size; length <<= 1) {
+		double angle = -2.0 * pi / length;
+		std::complex<float> step((float) std::cos(angle), (float) std::sin(angle));
+		for (size_t i = 0; i < size; i += length) {
+			std::complex<float> twiddle(1.0f, 0.0f);
+			for (size_t j = 0; j < length / 2; j++) {
+				std::complex<float> even = data[i + j];
+				std::complex<float> odd = data[i + j + length / 2] * twiddle;
+				data[i + j] = even + odd;
+				data[i + j + length / 2] = even - odd;
+				twiddle *= step;
+			}
+		}
+	}
+}
+
+double AudioKernels::toDecibels(double linear) {
+	if (linear <= 1e-10)
+		return -200.0;
+	return 20.0 * std::log10(linear);
+}
@@ -0,0 +1,48 @@
+/*
+ * AudioKernels.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef AUDIOKERNELS_H
+#define AUDIOKERNELS_H
+
+#include <cstddef>
+#include <complex>
+#include <vector>
+
+// The inner loops of the sample analysis. They run on SSE2 when the compiler
+// targets it and fall back to plain loops otherwise, both giving the same
+// results within float rounding.
+class AudioKernels {
+public:
+	// the largest absolute value
+	static float peakAbs(const float *samples, size_t count);
+	// summed in double precision so long samples don't lose the quiet parts
+	static double sumOfSquares(const float *samples, size_t count);
+	static double dotProduct(const float *first, const float *second, size_t count);
+	// filters one channel of interleaved samples in place with the K-weighting
+	// of ITU-R BS.1770, the filter starts from silence
+	static void applyKWeighting(float *samples, size_t numberOfFrames, unsigned channel, unsigned numberOfChannels, unsigned sampleRate);
+
+	// in place radix 2 transform, the size must be a power of two
+	static void fft(std::vector<std::complex<float>> &data);
+
+	static double toDecibels(double linear);
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * BackgroundTask.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "BackgroundTask.h"
+#include <wx/progdlg.h>
+#include <thread>
+#include <exception>
+
+BackgroundTask::BackgroundTask(int totalSteps, wxString stepsLabel) {
+	m_totalSteps = totalSteps > 0 ? totalSteps : 1;
+	m_stepsLabel = stepsLabel;
+	m_cancelled = false;
+	m_finished = false;
+	m_stepsDone = 0;
+	m_itemsFound = 0;
+}
+
+BackgroundTask::~BackgroundTask() {
+
+}
+
+bool BackgroundTask::isCancelled() const {
+	return m_cancelled;
+}
+
+void BackgroundTask::setTotalSteps(int totalSteps) {
+	m_totalSteps = totalSteps > 0 ? totalSteps : 1;
+}
+
+void BackgroundTask::beginStage(wxString stepsLabel, int totalSteps) {
+	{
+		std::lock_guard<std::mutex> lock(m_labelMutex);
+		m_stepsLabel = stepsLabel;
+	}
+	m_stepsDone = 0;
+	setTotalSteps(totalSteps);
+}
+
+void BackgroundTask::stepDone() {
+	m_stepsDone++;
+}
+
+void BackgroundTask::addItemsFound(unsigned count) {
+	m_itemsFound += count;
+}
+
+bool BackgroundTask::runWithProgress(
+	wxWindow *parent,
+	wxString title,
+	wxString message,
+	std::function<void()> work
+) {
+	m_finished = false;
+
+	// whatever the work throws must not keep the dialog waiting for it forever
+	std::thread worker([this, work]() {
+		try {
+			work();
+		} catch (const std::exception &e) {
+			fail(wxString(e.what()));
+		} catch (...) {
+			fail(wxT("Unknown error"));
+		}
+		m_finished = true;
+	});
+
+	wxProgressDialog progress(
+		title,
+		getStatusText(message),
+		m_totalSteps,
+		parent,
+		wxPD_APP_MODAL | wxPD_CAN_ABORT | wxPD_AUTO_HIDE | wxPD_ELAPSED_TIME
+	);
+
+	int range = m_totalSteps;
+	while (!m_finished) {
+		if (range != m_totalSteps) {
+			range = m_totalSteps;
+			progress.SetRange(range);
+		}
+		// reaching the maximum would close the dialog before the work is done
+		int value = m_stepsDone < range ? (int) m_stepsDone : range - 1;
+		if (!m_cancelled && !progress.Update(value, getStatusText(message)))
+			cancel();
+		wxMilliSleep(50);
+	}
+
+	worker.join();
+
+	wxString errorMessage;
+	{
+		std::lock_guard<std::mutex> lock(m_labelMutex);
+		errorMessage = m_errorMessage;
+	}
+	if (errorMessage != wxEmptyString) {
+		wxMessageDialog msg(parent, title + wxT(" failed: ") + errorMessage, wxT("Error"), wxOK|wxCENTRE|wxICON_ERROR);
+		msg.ShowModal();
+	}
+
+	return !m_cancelled;
+}
+
+void BackgroundTask::fail(wxString errorMessage) {
+	{
+		std::lock_guard<std::mutex> lock(m_labelMutex);
+		m_errorMessage = errorMessage;
+	}
+	// anything the work did so far must be thrown away just as after a cancel
+	m_cancelled = true;
+}
+
+void BackgroundTask::cancel() {
+	m_cancelled = true;
+}
+
+int BackgroundTask::getStepsDone() const {
+	return m_stepsDone;
+}
+
+unsigned BackgroundTask::getItemsFound() const {
+	return m_itemsFound;
+}
+
+wxString BackgroundTask::getStatusText(wxString message) const {
+	std::lock_guard<std::mutex> lock(m_labelMutex);
+	return message + wxString::Format(
+		wxT("\nFiles found: %u\n%s: %i of %i"),
+		(unsigned) m_itemsFound,
+		m_stepsLabel,
+		(int) m_stepsDone,
+		(int) m_totalSteps
+	);
+}
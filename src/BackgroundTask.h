@@ -0,0 +1,70 @@
+/*
+ * BackgroundTask.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef BACKGROUNDTASK_H
+#define BACKGROUNDTASK_H
+
+#include <wx/wx.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+// Runs a piece of work on a worker thread while the calling (gui) thread
+// shows a modal progress dialog that can cancel it. The work reports back
+// through the thread safe counters and must check isCancelled() regularly.
+class BackgroundTask {
+public:
+	BackgroundTask(int totalSteps, wxString stepsLabel);
+	~BackgroundTask();
+
+	// called from the worker
+	bool isCancelled() const;
+	void setTotalSteps(int totalSteps);
+	// starts counting the steps of a new stage of the work from zero
+	void beginStage(wxString stepsLabel, int totalSteps);
+	void stepDone();
+	void addItemsFound(unsigned count);
+
+	// called from the gui thread, returns false if the user cancelled or the work threw
+	bool runWithProgress(
+		wxWindow *parent,
+		wxString title,
+		wxString message,
+		std::function<void()> work
+	);
+	void cancel();
+	int getStepsDone() const;
+	unsigned getItemsFound() const;
+
+private:
+	std::atomic<int> m_totalSteps;
+	wxString m_stepsLabel;
+	wxString m_errorMessage;
+	mutable std::mutex m_labelMutex;
+	std::atomic<bool> m_cancelled;
+	std::atomic<bool> m_finished;
+	std::atomic<int> m_stepsDone;
+	std::atomic<unsigned> m_itemsFound;
+
+	wxString getStatusText(wxString message) const;
+	void fail(wxString errorMessage);
+};
+
+#endif
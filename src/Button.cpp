@@ -40,7 +40,7 @@ void Button::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("DisplayInInvertedState=Y"));
 }
 
-void Button::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void Button::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	name = cfg->Read("Name", wxEmptyString);
 	wxString cfgBoolValue = cfg->Read("Displayed", wxEmptyString);
 	displayed = GOODF_functions::parseBoolean(cfgBoolValue, usingOldPanelFormat);
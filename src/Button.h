@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 
 class Button {
 public:
@@ -31,7 +31,7 @@ public:
 	~Button();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat);
+	void read(OdfReader *cfg, bool usingOldPanelFormat);
 
 	wxString getName();
 	bool isDisplayed();
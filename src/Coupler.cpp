@@ -81,7 +81,7 @@ void Coupler::write(wxTextFile *outFile) {
 	}
 }
 
-void Coupler::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual *owning_manual) {
+void Coupler::read(OdfReader *cfg, bool usingOldPanelFormat, Manual *owning_manual) {
 	m_owningManual = owning_manual;
 	Drawstop::read(cfg, usingOldPanelFormat);
 	wxString cfgBoolValue = cfg->Read("UnisonOff", wxEmptyString);
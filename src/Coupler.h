@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include "Drawstop.h"
 #include <list>
 
@@ -35,7 +35,7 @@ public:
 	~Coupler();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual *owning_manual);
+	void read(OdfReader *cfg, bool usingOldPanelFormat, Manual *owning_manual);
 
 	wxString getCouplerType();
 	void setCouplerType(wxString couplerType);
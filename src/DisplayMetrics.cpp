@@ -174,7 +174,7 @@ void DisplayMetrics::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("DispManualKeyWidth=") + wxString::Format(wxT("%i"), m_dispManualKeyWidth));
 }
 
-void DisplayMetrics::read(wxFileConfig *cfg) {
+void DisplayMetrics::read(OdfReader *cfg) {
 	wxString horizSize = cfg->Read("DispScreenSizeHoriz", wxEmptyString);
 	if (horizSize != wxEmptyString) {
 		if (horizSize.IsSameAs(wxT("SMALL"), false)) {
@@ -90,7 +90,7 @@ void Divisional::write(wxTextFile *outFile) {
 	}
 }
 
-void Divisional::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual *owning_manual) {
+void Divisional::read(OdfReader *cfg, bool usingOldPanelFormat, Manual *owning_manual) {
 	m_owningManual = owning_manual;
 	Button::read(cfg, usingOldPanelFormat);
 	wxString cfgBoolValue = cfg->Read("Protected", wxEmptyString);
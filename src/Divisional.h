@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include "Button.h"
 #include <list>
 #include <utility>
@@ -40,7 +40,7 @@ public:
 	~Divisional();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual *owning_manual);
+	void read(OdfReader *cfg, bool usingOldPanelFormat, Manual *owning_manual);
 
 	bool isProtected();
 	void setProtected(bool option);
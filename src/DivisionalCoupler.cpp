@@ -47,7 +47,7 @@ void DivisionalCoupler::write(wxTextFile *outFile) {
 	}
 }
 
-void DivisionalCoupler::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void DivisionalCoupler::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	Drawstop::read(cfg, usingOldPanelFormat);
 	wxString cfgBoolValue = cfg->Read("BiDirectionalCoupling", wxEmptyString);
 	m_biDirectionalCoupling = GOODF_functions::parseBoolean(cfgBoolValue, false);
@@ -32,7 +32,7 @@ public:
 	~DivisionalCoupler();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat);
+	void read(OdfReader *cfg, bool usingOldPanelFormat);
 
 	bool hasBiDirectionalCoupling();
 	void setBiDirectionalCoupling(bool isBiDirectional);
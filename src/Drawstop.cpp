@@ -72,7 +72,7 @@ void Drawstop::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("StoreInGeneral=N"));
 }
 
-void Drawstop::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void Drawstop::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	Button::read(cfg, usingOldPanelFormat);
 	function = cfg->Read("Function", wxT("Input"));
 	// TODO: the switches should really only be available if the function is something else than "Input"
@@ -34,7 +34,7 @@ public:
 	~Drawstop();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat);
+	void read(OdfReader *cfg, bool usingOldPanelFormat);
 
 	bool isDefaultToEngaged();
 	void setDefaultToEngaged(bool defaultToEngaged);
@@ -39,7 +39,7 @@ void Enclosure::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("MIDIInputNumber=") + wxString::Format(wxT("%i"), MIDIInputNumber));
 }
 
-void Enclosure::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void Enclosure::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	setName(cfg->Read("Name", wxEmptyString));
 	int ampMinLvl = static_cast<int>(cfg->ReadLong("AmpMinimumLevel", 1));
 	if (ampMinLvl > -1 && ampMinLvl < 101)
@@ -21,6 +21,7 @@
 #include "GOODF.h"
 #include "GOODFDef.h"
 #include "GoImages.h"
+#include "SampleFolderClassifier.h"
 #include <wx/image.h>
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
@@ -42,6 +43,14 @@ bool GOODF::OnInit() {
 	wxString BaseDir = fn.GetPath();
 	wxString ResourceDir = BaseDir + wxFILE_SEP_PATH + wxT("share");
 
+	// sample metadata is remembered between sessions
+	m_sampleMetadataCache = new SampleMetadataCache(wxStandardPaths::Get().GetUserDataDir() + wxFILE_SEP_PATH + wxT("SampleMetadata.cache"));
+	m_sampleMetadataCache->load();
+	m_workerPool = new WorkerPool();
+
+	// optional rules for classifying sample folders that the prefixes can't describe
+	SampleFolderClassifier::loadUserRules(wxStandardPaths::Get().GetUserDataDir() + wxFILE_SEP_PATH + wxT("SampleFolderRules.txt"));
+
 	// the help controller
 	wxFileSystem::AddHandler(new wxZipFSHandler);
 	m_helpController = new wxHtmlHelpController();
@@ -146,5 +155,8 @@ bool GOODF::OnInit() {
 }
 
 int GOODF::OnExit() {
+	m_sampleMetadataCache->save();
+	delete m_sampleMetadataCache;
+	delete m_workerPool;
 	return wxApp::OnExit();
 }
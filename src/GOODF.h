@@ -23,6 +23,8 @@
 
 #include <wx/wx.h>
 #include "GOODFFrame.h"
+#include "SampleMetadataCache.h"
+#include "WorkerPool.h"
 #include <vector>
 #include <wx/html/helpctrl.h>
 
@@ -37,6 +39,9 @@ public:
 	std::vector<wxBitmap> m_enclosureStyleBitmaps;
 	std::vector<wxBitmap> m_labelBitmaps;
 	wxHtmlHelpController *m_helpController;
+	SampleMetadataCache *m_sampleMetadataCache;
+	// kept for the whole session so the threads aren't started for every task
+	WorkerPool *m_workerPool;
 };
 
 DECLARE_APP(GOODF)
@@ -28,6 +28,19 @@
 #include <wx/button.h>
 #include "Enclosure.h"
 #include "Windchestgroup.h"
+#include "RankBatchImporter.h"
+#include "RankBatchImportDialog.h"
+#include "OpenOrganDialog.h"
+#include "OrganBuilder.h"
+#include "SampleAuditor.h"
+#include "SampleAuditDialog.h"
+#include "AttackStartFinder.h"
+#include "AttackStartDialog.h"
+#include "ReleaseMarkerFinder.h"
+#include "ReleaseMarkerDialog.h"
+#include "OrganFileParser.h"
+#include <wx/dirdlg.h>
+#include <wx/filename.h>
 
 // Event table
 BEGIN_EVENT_TABLE(GOODFFrame, wxFrame)
@@ -36,12 +49,17 @@ BEGIN_EVENT_TABLE(GOODFFrame, wxFrame)
 	EVT_MENU(wxID_EXIT, GOODFFrame::OnQuit)
 	EVT_MENU(ID_WRITE_ODF, GOODFFrame::OnWriteODF)
 	EVT_MENU(ID_NEW_ORGAN, GOODFFrame::OnNewOrgan)
+	EVT_MENU(ID_OPEN_ORGAN, GOODFFrame::OnOpenOrgan)
+	EVT_MENU(ID_AUDIT_SAMPLES, GOODFFrame::OnAuditSamples)
+	EVT_MENU(ID_FIND_ATTACK_STARTS, GOODFFrame::OnFindAttackStarts)
+	EVT_MENU(ID_FIND_RELEASE_MARKERS, GOODFFrame::OnFindReleaseMarkers)
 	EVT_TREE_SEL_CHANGED(ID_ORGAN_TREE, GOODFFrame::OnOrganTreeSelectionChanged)
 	EVT_BUTTON(ID_ADD_ENCLOSURE_BTN, GOODFFrame::OnAddNewEnclosure)
 	EVT_BUTTON(ID_ADD_TREMULANT_BTN, GOODFFrame::OnAddNewTremulant)
 	EVT_BUTTON(ID_ADD_WINDCHEST_BTN, GOODFFrame::OnAddNewWindchestgroup)
 	EVT_BUTTON(ID_ADD_SWITCH_BTN, GOODFFrame::OnAddNewSwitch)
 	EVT_BUTTON(ID_ADD_RANK_BTN, GOODFFrame::OnAddNewRank)
+	EVT_BUTTON(ID_BATCH_IMPORT_RANKS_BTN, GOODFFrame::OnBatchImportRanks)
 	EVT_BUTTON(ID_ADD_MANUAL_BTN, GOODFFrame::OnAddNewManual)
 	EVT_BUTTON(ID_ADD_DIV_CPLR_BTN, GOODFFrame::OnAddNewDivisionalCoupler)
 	EVT_BUTTON(ID_ADD_GENERAL_BTN, GOODFFrame::OnAddNewGeneral)
@@ -52,14 +70,22 @@ END_EVENT_TABLE()
 GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	// Start with an empty organ
 	m_organ = new Organ();
+	// paths are matched as the file system of the platform would match them
+	m_ignoreOdfPathCase = !wxFileName::IsCaseSensitive();
+	m_readPipesOnDemand = true;
+	m_pipesOnDemandLines = OrganFileParser::DEFAULT_PIPES_READ_ON_DEMAND_LINES;
 
 	// Create a file menu
 	m_fileMenu = new wxMenu();
 
 	// Add file menu items
 	m_fileMenu->Append(ID_NEW_ORGAN, wxT("&New Organ\tAlt-N"), wxT("Create a new organ"));
+	m_fileMenu->Append(ID_OPEN_ORGAN, wxT("&Open Organ\tAlt-O"), wxT("Open an existing .organ file"));
 	m_fileMenu->Append(wxID_EXIT, wxT("&Exit\tAlt-X"), wxT("Quit this program"));
 	m_fileMenu->Append(ID_WRITE_ODF, wxT("Write ODF"), wxT("Write the .organ file"));
+	m_fileMenu->Append(ID_AUDIT_SAMPLES, wxT("Audit Samples"), wxT("Check all the samples of the organ"));
+	m_fileMenu->Append(ID_FIND_ATTACK_STARTS, wxT("Find Attack Starts"), wxT("Skip the silence before the attacks of the organ"));
+	m_fileMenu->Append(ID_FIND_RELEASE_MARKERS, wxT("Find Release Markers"), wxT("Set cuepoint and release end of attacks recorded with their release"));
 
 	// Create a help menu
 	m_helpMenu = new wxMenu();
@@ -117,6 +143,8 @@ GOODFFrame::GOODFFrame(const wxString& title) : wxFrame(NULL, wxID_ANY, title) {
 	wxBoxSizer *addRankSizer = new wxBoxSizer(wxVERTICAL);
 	wxButton *addRankBtn = new wxButton(addRank, ID_ADD_RANK_BTN, wxT("Create new rank"));
 	addRankSizer->Add(addRankBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	wxButton *batchImportRanksBtn = new wxButton(addRank, ID_BATCH_IMPORT_RANKS_BTN, wxT("Batch import ranks from sample set"));
+	addRankSizer->Add(batchImportRanksBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
 	addRank->SetSizer(addRankSizer);
 	addRank->Hide();
 
@@ -282,12 +310,95 @@ void GOODFFrame::OnQuit(wxCommandEvent& WXUNUSED(event)) {
 	Close();
 }
 
+void GOODFFrame::OnAuditSamples(wxCommandEvent& WXUNUSED(event)) {
+	if (!ReadUnreadPipes())
+		return;
+
+	SampleAuditor auditor(m_organ, ::wxGetApp().m_sampleMetadataCache);
+	if (auditor.getNumberOfSamples() == 0) {
+		wxMessageDialog msg(this, wxT("The organ has no samples to audit!"), wxT("Nothing to audit"), wxOK|wxCENTRE);
+		msg.ShowModal();
+		return;
+	}
+
+	BackgroundTask task(auditor.getNumberOfSamples(), wxT("Samples audited"));
+	task.runWithProgress(this, wxT("Auditing samples"), wxT("Checking the samples of the organ"), [&]() {
+		auditor.runAudit(&task);
+	});
+
+	if (task.isCancelled())
+		return;
+
+	SampleAuditDialog report(auditor, this);
+	report.ShowModal();
+}
+
+void GOODFFrame::OnFindAttackStarts(wxCommandEvent& WXUNUSED(event)) {
+	AttackStartDialog options(this);
+	if (options.ShowModal() != wxID_OK)
+		return;
+
+	if (!ReadUnreadPipes())
+		return;
+
+	AttackStartFinder finder(options.GetThreshold(), options.GetMargin(), options.GetReplaceExisting());
+	finder.addOrgan(m_organ);
+	if (finder.getNumberOfAttacks() == 0) {
+		wxMessageDialog msg(this, wxT("The organ has no attacks to search!"), wxT("Nothing to search"), wxOK|wxCENTRE);
+		msg.ShowModal();
+		return;
+	}
+
+	BackgroundTask task(finder.getNumberOfAttacks(), wxT("Attacks searched"));
+	task.runWithProgress(this, wxT("Finding attack starts"), wxT("Searching the attacks of the organ"), [&]() {
+		finder.findAttackStarts(*::wxGetApp().m_workerPool, &task);
+	});
+	if (task.isCancelled())
+		return;
+
+	finder.applyAttackStarts();
+	wxMessageDialog msg(this, finder.getSummary(), wxT("Attack starts found"), wxOK|wxCENTRE);
+	msg.ShowModal();
+}
+
+void GOODFFrame::OnFindReleaseMarkers(wxCommandEvent& WXUNUSED(event)) {
+	wxMessageDialog replaceDlg(this, wxT("Should cuepoints that already are set be replaced too?"), wxT("Find release markers"), wxYES_NO|wxCANCEL|wxCENTRE);
+	int answer = replaceDlg.ShowModal();
+	if (answer == wxID_CANCEL)
+		return;
+
+	if (!ReadUnreadPipes())
+		return;
+
+	ReleaseMarkerFinder finder(answer == wxID_YES);
+	finder.addOrgan(m_organ);
+	if (finder.getNumberOfAttacks() == 0) {
+		wxMessageDialog msg(this, wxT("The organ has no attacks to search!"), wxT("Nothing to search"), wxOK|wxCENTRE);
+		msg.ShowModal();
+		return;
+	}
+
+	BackgroundTask task(finder.getNumberOfAttacks(), wxT("Attacks searched"));
+	task.runWithProgress(this, wxT("Finding release markers"), wxT("Searching the attacks of the organ"), [&]() {
+		finder.findMarkers(*::wxGetApp().m_workerPool, &task);
+	});
+	if (task.isCancelled())
+		return;
+
+	ReleaseMarkerDialog report(finder, this);
+	if (report.ShowModal() == wxID_OK)
+		finder.applyMarkers(report.IsSkippingDoubtful() ? DOUBTFUL_RELEASE_CONFIDENCE : 0);
+}
+
 void GOODFFrame::OnWriteODF(wxCommandEvent& WXUNUSED(event)) {
 	if (m_organPanel->getOdfPath().IsEmpty() || m_organPanel->getOdfName().IsEmpty()) {
 		wxMessageDialog incomplete(this, wxT("Path and name for ODF must be set!"), wxT("Cannot write ODF"), wxOK|wxCENTRE);
 		incomplete.ShowModal();
 		return;
 	}
+	// pipes that never were read can only be written as they are next to the ODF they came from
+	if (!m_organ->canCopyUnreadPipes() && !ReadUnreadPipes())
+		return;
 	wxString fullFileName = m_organPanel->getOdfPath() + wxFILE_SEP_PATH + m_organPanel->getOdfName() + wxT(".organ");
 	wxTextFile *odfFile = new wxTextFile(fullFileName);
 	if (odfFile->Exists()) {
@@ -311,6 +422,32 @@ void GOODFFrame::OnWriteODF(wxCommandEvent& WXUNUSED(event)) {
 	delete odfFile;
 }
 
+bool GOODFFrame::ReadUnreadPipes() {
+	if (!m_organ->hasUnreadPipes())
+		return true;
+
+	BackgroundTask task(1, wxT("Ranks and stops with pipes parsed"));
+	task.runWithProgress(this, wxT("Reading pipes"), wxT("Reading the pipes of the organ"), [&]() {
+		m_organ->readAllUnreadPipes(&task);
+	});
+	ReportCaseFoldedPaths();
+	return !task.isCancelled();
+}
+
+void GOODFFrame::ReportCaseFoldedPaths() {
+	// paths that only match files on disk by ignoring case are never used silently
+	unsigned caseFoldedPaths = m_organ->takeNewCaseFoldedPaths();
+	if (caseFoldedPaths > 0) {
+		wxString message;
+		if (m_ignoreOdfPathCase)
+			message = wxString::Format(wxT("%u file paths in the ODF only matched files on disk when upper/lower case was ignored. They will be written with the case of the files on disk."), caseFoldedPaths);
+		else
+			message = wxString::Format(wxT("%u file paths in the ODF were not found as they only match files on disk when upper/lower case is ignored. Open the organ again with that option to use them."), caseFoldedPaths);
+		wxMessageDialog msg(this, message, wxT("Paths differing in case"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+	}
+}
+
 void GOODFFrame::OrganTreeChildItemLabelChanged(wxString label) {
 	wxTreeItemId selected;
 	selected = m_organTreeCtrl->GetSelection();
@@ -1052,6 +1189,19 @@ void GOODFFrame::AddStopItemToTree() {
 	m_organTreeCtrl->SelectItem(newStop);
 }
 
+void GOODFFrame::AppendStopItemToManual(unsigned manualIndex, wxString stopName) {
+	wxTreeItemIdValue cookie;
+	wxTreeItemId manualId = m_organTreeCtrl->GetFirstChild(tree_manuals, cookie);
+	for (unsigned i = 0; i < manualIndex && manualId.IsOk(); i++)
+		manualId = m_organTreeCtrl->GetNextChild(tree_manuals, cookie);
+	if (!manualId.IsOk())
+		return;
+
+	wxTreeItemIdValue stopCookie;
+	wxTreeItemId stopChild = m_organTreeCtrl->GetFirstChild(manualId, stopCookie);
+	m_organTreeCtrl->AppendItem(stopChild, stopName);
+}
+
 void GOODFFrame::AddCouplerItemToTree() {
 	// this is called from a manual that's currently selected in tree
 	wxTreeItemId selectedManual = m_organTreeCtrl->GetSelection();
@@ -1106,6 +1256,134 @@ void GOODFFrame::OnAddNewRank(wxCommandEvent& WXUNUSED(event)) {
 	}
 }
 
+void GOODFFrame::OnBatchImportRanks(wxCommandEvent& WXUNUSED(event)) {
+	wxDirDialog sampleSetDialog(
+		this,
+		wxT("Pick the root directory of the sample set"),
+		m_organ->getOdfRoot(),
+		wxDD_DIR_MUST_EXIST
+	);
+	if (sampleSetDialog.ShowModal() != wxID_OK)
+		return;
+
+	RankBatchImportDialog optionsDialog(sampleSetDialog.GetPath(), this);
+	if (optionsDialog.ShowModal() != wxID_OK)
+		return;
+
+	SamplePattern pattern(optionsDialog.GetSampleFilePattern());
+	if (!pattern.isValid()) {
+		wxMessageDialog msg(this, pattern.getErrorMessage(), wxT("Invalid sample name pattern"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+		return;
+	}
+
+	RankBatchImporter importer(sampleSetDialog.GetPath());
+	importer.setSampleFilePattern(pattern.getPattern());
+	importer.setReadingOptions(
+		optionsDialog.GetExtraAttackFolder(),
+		optionsDialog.GetLoadOnlyOneAttack(),
+		optionsDialog.GetLoadRelease(),
+		optionsDialog.GetReleaseFolderPrefix(),
+		optionsDialog.GetExtractKeyPressTime(),
+		optionsDialog.GetTremulantFolderPrefix()
+	);
+	if (optionsDialog.GetReadLoopsAndCues())
+		importer.setSampleMetadataCache(::wxGetApp().m_sampleMetadataCache);
+
+	bool ranksFound = false;
+	BackgroundTask task(1, wxT("Pipes populated"));
+	task.runWithProgress(this, wxT("Importing ranks"), wxT("Importing ranks from ") + sampleSetDialog.GetPath(), [&]() {
+		ranksFound = importer.importRanks(*::wxGetApp().m_workerPool, &task);
+	});
+
+	if (task.isCancelled())
+		return;
+
+	if (!ranksFound) {
+		wxMessageDialog msg(this, wxT("No rank folders with samples could be found!"), wxT("No ranks found"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+		return;
+	}
+
+	if (optionsDialog.GetBuildWholeOrgan()) {
+		BuildOrganFromImportedRanks(importer);
+		return;
+	}
+
+	int targetManual = optionsDialog.GetTargetManual();
+	unsigned nbrImported = 0;
+	m_organ->beginBatchUpdate();
+	for (unsigned i = 0; i < importer.getNumberOfImportedRanks(); i++) {
+		Rank *rank = importer.getImportedRankAt(i);
+
+		if (targetManual < 0) {
+			if (m_organ->getNumberOfRanks() >= 999)
+				break;
+			wxString rankName = rank->getName();
+			m_organ->addRank(std::move(*rank));
+			m_organTreeCtrl->AppendItem(tree_ranks, rankName);
+		} else {
+			if (m_organ->getNumberOfStops() >= 999)
+				break;
+			Manual *manual = m_organ->getOrganManualAt(targetManual);
+			wxString rankName = rank->getName();
+			Stop stop;
+			stop.setName(rankName);
+			stop.setOwningManual(manual);
+			stop.setNumberOfAccessiblePipes(rank->getNumberOfLogicalPipes());
+			if (rank->getFirstMidiNoteNumber() > manual->getFirstAccessibleKeyMIDINoteNumber())
+				stop.setFirstPipeLogicalKeyNbr(rank->getFirstMidiNoteNumber() - manual->getFirstAccessibleKeyMIDINoteNumber() + 1);
+			*stop.getInternalRank() = std::move(*rank);
+			m_organ->addStop(std::move(stop));
+			manual->addStop(m_organ->getOrganStopAt(m_organ->getNumberOfStops() - 1));
+			AppendStopItemToManual(targetManual, rankName);
+		}
+		nbrImported++;
+	}
+	m_organ->endBatchUpdate();
+
+	if (nbrImported < importer.getNumberOfImportedRanks()) {
+		wxMessageDialog msg(this, wxString::Format(wxT("Only %u of %u ranks could be added to the organ!"), nbrImported, importer.getNumberOfImportedRanks()), wxT("Too many ranks"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+	}
+}
+
+void GOODFFrame::BuildOrganFromImportedRanks(RankBatchImporter &importer) {
+	OrganBuilder builder(importer);
+	wxString errorMessage;
+	if (!builder.canBeAddedTo(m_organ, errorMessage)) {
+		wxMessageDialog msg(this, errorMessage, wxT("Organ cannot be built"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+		return;
+	}
+
+	unsigned firstNewManual = m_organ->getNumberOfManuals();
+	builder.addToOrgan(m_organ);
+
+	// the tree items are added in the same order as the elements in the organ
+	for (unsigned i = 0; i < builder.getNumberOfDivisions(); i++) {
+		const OrganDivision &division = builder.getDivisionAt(i);
+		m_organTreeCtrl->AppendItem(tree_windchestgrps, division.name);
+
+		wxTreeItemId thisManual = m_organTreeCtrl->AppendItem(tree_manuals, division.name);
+		m_organTreeCtrl->AppendItem(thisManual, wxT("Stops"));
+		m_organTreeCtrl->AppendItem(thisManual, wxT("Couplers"));
+		m_organTreeCtrl->AppendItem(thisManual, wxT("Divisionals"));
+
+		for (unsigned j = 0; j < division.rankNames.GetCount(); j++)
+			m_organTreeCtrl->AppendItem(tree_ranks, division.rankNames.Item(j));
+		for (unsigned j = 0; j < division.stopNames.GetCount(); j++)
+			AppendStopItemToManual(firstNewManual + i, division.stopNames.Item(j));
+	}
+
+	const wxArrayString &ranksWithoutStop = builder.getRanksWithoutStop();
+	if (!ranksWithoutStop.IsEmpty()) {
+		wxString message = wxT("These ranks have no pipes within the keys of their manual, so no stops were made for them:\n") + wxJoin(ranksWithoutStop, '\n', '\0');
+		wxMessageDialog msg(this, message, wxT("Ranks without stops"), wxOK|wxCENTRE|wxICON_INFORMATION);
+		msg.ShowModal();
+	}
+}
+
 void GOODFFrame::OnNewOrgan(wxCommandEvent& WXUNUSED(event)) {
 	wxMessageDialog dlg(this, wxT("Are you really sure you want to create a completely new organ?"), wxT("Are you sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 	if (dlg.ShowModal() == wxID_YES) {
@@ -1114,6 +1392,8 @@ void GOODFFrame::OnNewOrgan(wxCommandEvent& WXUNUSED(event)) {
 			m_organ = NULL;
 		}
 		m_organ = new Organ();
+		// the paths of the samples are no longer relative to the old organ
+		m_organ->setOdfRoot(wxEmptyString);
 
 		m_organTreeCtrl->DeleteChildren(tree_manuals);
 		m_organTreeCtrl->DeleteChildren(tree_windchestgrps);
@@ -1134,6 +1414,133 @@ void GOODFFrame::OnNewOrgan(wxCommandEvent& WXUNUSED(event)) {
 	}
 }
 
+void GOODFFrame::OnOpenOrgan(wxCommandEvent& WXUNUSED(event)) {
+	wxMessageDialog dlg(this, wxT("Are you really sure you want to replace the current organ with an opened one?"), wxT("Are you sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
+	if (dlg.ShowModal() != wxID_YES)
+		return;
+
+	wxString defaultPath = m_organPanel->getOdfPath();
+	if (defaultPath == wxEmptyString)
+		defaultPath = wxStandardPaths::Get().GetDocumentsDir();
+
+	wxFileDialog fileDialog(
+		this,
+		wxT("Open an existing organ definition file"),
+		defaultPath,
+		"",
+		"Organ definition files (*.organ)|*.organ",
+		wxFD_OPEN|wxFD_FILE_MUST_EXIST
+	);
+	if (fileDialog.ShowModal() == wxID_CANCEL)
+		return;
+
+	OpenOrganDialog optionsDialog(fileDialog.GetPath(), m_ignoreOdfPathCase, m_readPipesOnDemand, m_pipesOnDemandLines, this);
+	if (optionsDialog.ShowModal() != wxID_OK)
+		return;
+	m_ignoreOdfPathCase = optionsDialog.GetIgnoreCase();
+	m_readPipesOnDemand = optionsDialog.GetReadPipesOnDemand();
+	m_pipesOnDemandLines = optionsDialog.GetPipesOnDemandLines();
+
+	// nothing of the current organ may be shown while it's replaced
+	m_organTreeCtrl->SelectItem(tree_organ);
+
+	// the elements find their organ through the frame while they are read, so
+	// the new organ is the current one until the parsing is done
+	Organ *previousOrgan = m_organ;
+	Organ *openedOrgan = new Organ();
+	m_organ = openedOrgan;
+
+	OrganFileParser parser(fileDialog.GetPath(), openedOrgan);
+	parser.setIgnoreCase(m_ignoreOdfPathCase);
+	parser.setPipesReadOnDemand(m_readPipesOnDemand, m_pipesOnDemandLines);
+	BackgroundTask task(1, wxT("Sections parsed"));
+	task.runWithProgress(this, wxT("Opening organ"), wxT("Reading ") + fileDialog.GetPath(), [&]() {
+		parser.parse(&task);
+	});
+
+	if (!parser.isOrganReady()) {
+		m_organ = previousOrgan;
+		m_organ->setOdfRoot(m_organ->getOdfRoot());
+		delete openedOrgan;
+		if (!task.isCancelled()) {
+			wxMessageDialog msg(this, parser.getErrorMessage(), wxT("Organ could not be opened"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+			msg.ShowModal();
+		}
+		return;
+	}
+
+	// the panels and their GUI elements can only be made on this thread
+	parser.createPanels();
+	delete previousOrgan;
+	RebuildOrganTree();
+
+	wxFileName odf(fileDialog.GetPath());
+	m_organPanel->setCurrentOrgan(m_organ);
+	m_organPanel->setOdfPath(odf.GetPath());
+	m_organPanel->setOdfName(odf.GetName());
+
+	ReportCaseFoldedPaths();
+}
+
+void GOODFFrame::RebuildOrganTree() {
+	// all the items are added in one go so that the tree is only redrawn once
+	m_organTreeCtrl->Freeze();
+	m_organTreeCtrl->DeleteChildren(tree_manuals);
+	m_organTreeCtrl->DeleteChildren(tree_windchestgrps);
+	m_organTreeCtrl->DeleteChildren(tree_enclosures);
+	m_organTreeCtrl->DeleteChildren(tree_tremulants);
+	m_organTreeCtrl->DeleteChildren(tree_ranks);
+	m_organTreeCtrl->DeleteChildren(tree_switches);
+	m_organTreeCtrl->DeleteChildren(tree_reversiblePistons);
+	m_organTreeCtrl->DeleteChildren(tree_divisionalCouplers);
+	m_organTreeCtrl->DeleteChildren(tree_generals);
+	m_organTreeCtrl->DeleteChildren(tree_panels);
+
+	for (unsigned i = 0; i < m_organ->getNumberOfManuals(); i++) {
+		Manual *manual = m_organ->getOrganManualAt(i);
+		wxTreeItemId thisManual = m_organTreeCtrl->AppendItem(tree_manuals, manual->getName());
+		wxTreeItemId stops = m_organTreeCtrl->AppendItem(thisManual, wxT("Stops"));
+		wxTreeItemId couplers = m_organTreeCtrl->AppendItem(thisManual, wxT("Couplers"));
+		wxTreeItemId divisionals = m_organTreeCtrl->AppendItem(thisManual, wxT("Divisionals"));
+		for (unsigned j = 0; j < manual->getNumberOfStops(); j++)
+			m_organTreeCtrl->AppendItem(stops, manual->getStopAt(j)->getName());
+		for (unsigned j = 0; j < manual->getNumberOfCouplers(); j++)
+			m_organTreeCtrl->AppendItem(couplers, manual->getCouplerAt(j)->getName());
+		for (unsigned j = 0; j < manual->getNumberOfDivisionals(); j++)
+			m_organTreeCtrl->AppendItem(divisionals, manual->getDivisionalAt(j)->getName());
+	}
+	for (unsigned i = 0; i < m_organ->getNumberOfWindchestgroups(); i++)
+		m_organTreeCtrl->AppendItem(tree_windchestgrps, m_organ->getOrganWindchestgroupAt(i)->getName());
+	for (unsigned i = 0; i < m_organ->getNumberOfEnclosures(); i++)
+		m_organTreeCtrl->AppendItem(tree_enclosures, m_organ->getOrganEnclosureAt(i)->getName());
+	for (unsigned i = 0; i < m_organ->getNumberOfTremulants(); i++)
+		m_organTreeCtrl->AppendItem(tree_tremulants, m_organ->getOrganTremulantAt(i)->getName());
+	for (unsigned i = 0; i < m_organ->getNumberOfRanks(); i++)
+		m_organTreeCtrl->AppendItem(tree_ranks, m_organ->getOrganRankAt(i)->getName());
+	for (unsigned i = 0; i < m_organ->getNumberOfSwitches(); i++)
+		m_organTreeCtrl->AppendItem(tree_switches, m_organ->getOrganSwitchAt(i)->getName());
+	for (unsigned i = 0; i < m_organ->getNumberOfReversiblePistons(); i++)
+		m_organTreeCtrl->AppendItem(tree_reversiblePistons, m_organ->getReversiblePistonAt(i)->getName());
+	for (unsigned i = 0; i < m_organ->getNumberOfOrganDivisionalCouplers(); i++)
+		m_organTreeCtrl->AppendItem(tree_divisionalCouplers, m_organ->getOrganDivisionalCouplerAt(i)->getName());
+	for (unsigned i = 0; i < m_organ->getNumberOfGenerals(); i++)
+		m_organTreeCtrl->AppendItem(tree_generals, m_organ->getOrganGeneralAt(i)->getName());
+
+	for (unsigned i = 0; i < m_organ->getNumberOfPanels(); i++) {
+		GoPanel *panel = m_organ->getOrganPanelAt(i);
+		wxTreeItemId thisPanel = m_organTreeCtrl->AppendItem(tree_panels, panel->getName());
+		m_organTreeCtrl->AppendItem(thisPanel, wxT("Displaymetrics"));
+		wxTreeItemId images = m_organTreeCtrl->AppendItem(thisPanel, wxT("Images"));
+		wxTreeItemId guiElements = m_organTreeCtrl->AppendItem(thisPanel, wxT("GUI Elements"));
+		for (unsigned j = 0; j < panel->getNumberOfImages(); j++)
+			m_organTreeCtrl->AppendItem(images, panel->getImageAt(j)->getImageNameOnly());
+		for (int j = 0; j < panel->getNumberOfGuiElements(); j++)
+			m_organTreeCtrl->AppendItem(guiElements, panel->getGuiElementAt(j)->getDisplayName());
+	}
+	m_organTreeCtrl->Thaw();
+	m_organTreeCtrl->SelectItem(tree_organ);
+}
+
 void GOODFFrame::OnAddNewManual(wxCommandEvent& WXUNUSED(event)) {
 	if (m_organ->getNumberOfManuals() < 16) {
 		Manual m;
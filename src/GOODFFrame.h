@@ -46,6 +46,8 @@
 #include "GUILabelPanel.h"
 #include "GUIManualPanel.h"
 
+class RankBatchImporter;
+
 class GOODFFrame : public wxFrame {
 public:
 	GOODFFrame(const wxString& title);
@@ -55,11 +57,19 @@ public:
 	void OnAbout(wxCommandEvent& event);
 	void OnHelp(wxCommandEvent& event);
 	void OnWriteODF(wxCommandEvent& event);
+	void OnAuditSamples(wxCommandEvent& event);
+	void OnFindAttackStarts(wxCommandEvent& event);
+	void OnFindReleaseMarkers(wxCommandEvent& event);
 
 	void OrganTreeChildItemLabelChanged(wxString label);
 	void RemoveCurrentItemFromOrgan();
+	// reads what pipes were left unread when the organ was opened, false if cancelled
+	bool ReadUnreadPipes();
+	// tells about ODF paths found only by ignoring case since this was last called
+	void ReportCaseFoldedPaths();
 
 	void AddStopItemToTree();
+	void AppendStopItemToManual(unsigned manualIndex, wxString stopName);
 	void AddCouplerItemToTree();
 	void AddDivisionalItemToTree();
 	void AddImageItemToTree();
@@ -118,6 +128,10 @@ private:
 	GUIEnclosurePanel *m_guiEnclosurePanel;
 	GUILabelPanel *m_guiLabelPanel;
 	GUIManualPanel *m_guiManualPanel;
+	// the choices made when an organ was last opened
+	bool m_ignoreOdfPathCase;
+	bool m_readPipesOnDemand;
+	unsigned m_pipesOnDemandLines;
 
 	void OnOrganTreeSelectionChanged(wxTreeEvent& event);
 	void OnAddNewEnclosure(wxCommandEvent& event);
@@ -125,7 +139,9 @@ private:
 	void OnAddNewWindchestgroup(wxCommandEvent& event);
 	void OnAddNewSwitch(wxCommandEvent& event);
 	void OnAddNewRank(wxCommandEvent& event);
+	void OnBatchImportRanks(wxCommandEvent& event);
 	void OnNewOrgan(wxCommandEvent& event);
+	void OnOpenOrgan(wxCommandEvent& event);
 	void OnAddNewManual(wxCommandEvent& event);
 	void OnAddNewDivisionalCoupler(wxCommandEvent& event);
 	void OnAddNewGeneral(wxCommandEvent& event);
@@ -133,6 +149,8 @@ private:
 	void OnAddNewPanel(wxCommandEvent& event);
 
 	void SetupOrganMainPanel();
+	void BuildOrganFromImportedRanks(RankBatchImporter &importer);
+	void RebuildOrganTree();
 
 };
 
@@ -26,6 +26,8 @@
 #include <wx/filename.h>
 #include <vector>
 #include "GOODF.h"
+#include "OdfPathResolver.h"
+#include "SamplePath.h"
 
 namespace GOODF_functions {
 
@@ -58,17 +60,16 @@ namespace GOODF_functions {
 	}
 
 	inline wxString removeBaseOdfPath(wxString path) {
-		wxString stringToReturn = path;
-		if (stringToReturn != wxEmptyString) {
-			stringToReturn.Replace(::wxGetApp().m_frame->m_organ->getOdfRoot(), wxT(""));
-			if (stringToReturn.StartsWith(wxFILE_SEP_PATH))
-				stringToReturn.erase(0, 1);
-		}
-		return stringToReturn;
+		if (path == wxEmptyString)
+			return path;
+		return SamplePath::makeRelative(path, ::wxGetApp().m_frame->m_organ->getOdfRoot());
 	}
 
 	inline wxString checkIfFileExist(wxString relativePath) {
 		if (relativePath != wxEmptyString) {
+			OdfPathResolver *resolver = ::wxGetApp().m_frame->m_organ->getPathResolver();
+			if (resolver)
+				return resolver->resolve(relativePath);
 			wxString fullFilePath = ::wxGetApp().m_frame->m_organ->getOdfRoot() + wxFILE_SEP_PATH + relativePath;
 			wxFileName theFile = wxFileName(fullFilePath);
 			if (theFile.FileExists()) {
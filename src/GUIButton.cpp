@@ -146,7 +146,7 @@ void GUIButton::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("TextBreakWidth=") + wxString::Format(wxT("%i"), m_textBreakWidth));
 }
 
-void GUIButton::read(wxFileConfig *cfg, bool isPiston) {
+void GUIButton::read(OdfReader *cfg, bool isPiston) {
 	wxString cfgBoolValue = cfg->Read("DisplayAsPiston", wxEmptyString);
 	m_displayAsPiston = GOODF_functions::parseBoolean(cfgBoolValue, isPiston);
 	wxString colorStr = cfg->Read("DispLabelColour", wxT("DARK RED"));
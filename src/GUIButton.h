@@ -33,7 +33,7 @@ public:
 	virtual ~GUIButton();
 
 	virtual void write(wxTextFile *outFile);
-	virtual void read(wxFileConfig *cfg, bool isPiston);
+	virtual void read(OdfReader *cfg, bool isPiston);
 
 	virtual void updateDisplayName();
 	int getDispButtonCol() const;
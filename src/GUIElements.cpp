@@ -36,7 +36,7 @@ void GUIElement::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("Type=") + m_type);
 }
 
-void GUIElement::read(wxFileConfig *cfg) {
+void GUIElement::read(OdfReader *cfg) {
 	m_type = cfg->Read("Type", wxEmptyString);
 }
 
@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include "GoColor.h"
 #include "GoFontSize.h"
 #include "GoImage.h"
@@ -37,7 +37,7 @@ public:
 	virtual ~GUIElement();
 
 	virtual void write(wxTextFile *outFile);
-	virtual void read(wxFileConfig *cfg);
+	virtual void read(OdfReader *cfg);
 
 	virtual void updateDisplayName();
 	wxString getType();
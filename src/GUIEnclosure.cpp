@@ -132,7 +132,7 @@ void GUIEnclosure::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("TextBreakWidth=") + wxString::Format(wxT("%i"), m_textBreakWidth));
 }
 
-void GUIEnclosure::read(wxFileConfig *cfg) {
+void GUIEnclosure::read(OdfReader *cfg) {
 	wxString colorStr = cfg->Read("DispLabelColour", wxT("WHITE"));
 	int colorIdx = getDispLabelColour()->getColorNames().Index(colorStr, false);
 	if (colorIdx != wxNOT_FOUND) {
@@ -36,7 +36,7 @@ public:
 	~GUIEnclosure();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg);
+	void read(OdfReader *cfg);
 
 	bool isReferencing(Enclosure *enclosure);
 	void updateDisplayName();
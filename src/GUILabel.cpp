@@ -123,7 +123,7 @@ void GUILabel::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("TextBreakWidth=") + wxString::Format(wxT("%i"), m_textBreakWidth));
 }
 
-void GUILabel::read(wxFileConfig *cfg) {
+void GUILabel::read(OdfReader *cfg) {
 	wxString cfgBoolValue = cfg->Read("FreeXPlacement", wxEmptyString);
 	m_freeXPlacement = GOODF_functions::parseBoolean(cfgBoolValue, true);
 	cfgBoolValue = cfg->Read("FreeYPlacement", wxEmptyString);
@@ -27,7 +27,7 @@
 #include "GoColor.h"
 #include "GoFontSize.h"
 #include "GoImage.h"
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 
 class GUILabel : public GUIElement {
 public:
@@ -35,7 +35,7 @@ public:
 	~GUILabel();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg);
+	void read(OdfReader *cfg);
 
 	bool isDispAtTopOfDrawstopCol() const;
 	void setDispAtTopOfDrawstopCol(bool dispAtTopOfDrawstopCol);
@@ -109,7 +109,7 @@ void GUIManual::write(wxTextFile *outFile) {
 	}
 }
 
-void GUIManual::read(wxFileConfig *cfg) {
+void GUIManual::read(OdfReader *cfg) {
 	int thePanelWidth = getOwningPanel()->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue();
 	int thePanelHeight = getOwningPanel()->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue();
 	int posX = static_cast<int>(cfg->ReadLong("PositionX", 0));
@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include "GUIElements.h"
 #include "Manual.h"
 #include <list>
@@ -50,7 +50,7 @@ public:
 	~GUIManual();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg);
+	void read(OdfReader *cfg);
 
 	bool isReferencing(Manual *man);
 	void updateDisplayName();
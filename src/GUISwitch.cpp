@@ -44,7 +44,7 @@ void GUISwitch::write(wxTextFile *outFile) {
 	GUIButton::write(outFile);
 }
 
-void GUISwitch::read(wxFileConfig *cfg) {
+void GUISwitch::read(OdfReader *cfg) {
 	GUIButton::read(cfg, false);
 }
 
@@ -32,7 +32,7 @@ public:
 	virtual ~GUISwitch();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg);
+	void read(OdfReader *cfg);
 
 	bool isReferencing(GoSwitch *sw);
 	void updateDisplayName();
@@ -42,7 +42,7 @@ void GUITremulant::write(wxTextFile *outFile) {
 	GUIButton::write(outFile);
 }
 
-void GUITremulant::read(wxFileConfig *cfg) {
+void GUITremulant::read(OdfReader *cfg) {
 	GUIButton::read(cfg, false);
 }
 
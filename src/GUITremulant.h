@@ -32,7 +32,7 @@ public:
 	~GUITremulant();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg);
+	void read(OdfReader *cfg);
 
 	bool isReferencing(Tremulant *tremulant);
 	void updateDisplayName();
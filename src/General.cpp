@@ -117,7 +117,7 @@ void General::write(wxTextFile *outFile) {
 	}
 }
 
-void General::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void General::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	Button::read(cfg, usingOldPanelFormat);
 	wxString cfgBoolValue = cfg->Read("Protected", wxEmptyString);
 	m_protected = GOODF_functions::parseBoolean(cfgBoolValue, false);
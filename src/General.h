@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include "Button.h"
 #include <list>
 #include <utility>
@@ -39,7 +39,7 @@ public:
 	~General();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat);
+	void read(OdfReader *cfg, bool usingOldPanelFormat);
 
 	bool isProtected();
 	void setProtected(bool option);
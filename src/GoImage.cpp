@@ -65,7 +65,7 @@ void GoImage::write(wxTextFile *outFile) {
 		outFile->AddLine(wxT("TileOffsetY=") + wxString::Format(wxT("%i"), m_tileOffsetY));
 }
 
-bool GoImage::read(wxFileConfig *cfg) {
+bool GoImage::read(OdfReader *cfg) {
 	bool imageIsValid = false;
 
 	wxString relImgPath = cfg->Read("Image", wxEmptyString);
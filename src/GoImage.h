@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 
 class GoImage {
 public:
@@ -31,7 +31,7 @@ public:
 	~GoImage();
 
 	void write(wxTextFile *outFile);
-	bool read(wxFileConfig *cfg);
+	bool read(OdfReader *cfg);
 
 	int getHeight() const;
 	void setHeight(int height);
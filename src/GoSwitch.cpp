@@ -32,6 +32,6 @@ void GoSwitch::write(wxTextFile *outFile) {
 	Drawstop::write(outFile);
 }
 
-void GoSwitch::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void GoSwitch::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	Drawstop::read(cfg, usingOldPanelFormat);
 }
@@ -24,12 +24,3 @@ Loop::Loop() {
 	start = 0;
 	end = 1; // always at least = start + 1
 }
-
-Loop::Loop(const Loop& l) {
-	start = l.start;
-	end = l.end;
-}
-
-Loop::~Loop() {
-
-}
@@ -24,8 +24,6 @@
 class Loop {
 public:
 	Loop();
-	Loop(const Loop& l);
-	~Loop();
 
 	int start;
 	int end;
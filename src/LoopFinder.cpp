@@ -0,0 +1,173 @@
+/*
+ * LoopFinder.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "LoopFinder.h"
+#include "SampleAudioReader.h"
+#include "AudioKernels.h"
+#include <algorithm>
+#include <cmath>
+
+LoopCandidate::LoopCandidate() {
+	loop.start = 0;
+	loop.end = 0;
+	seamError = 0;
+	correlation = 0;
+}
+
+LoopFinder::LoopFinder(unsigned maxCandidates) {
+	m_maxCandidates = maxCandidates;
+	m_errorMessage = wxEmptyString;
+}
+
+LoopFinder::~LoopFinder() {
+
+}
+
+bool LoopFinder::findLoops(wxString fullPath, int attackStart, int cuePoint) {
+	m_candidates.clear();
+
+	SampleAudioReader reader;
+	if (!reader.open(fullPath)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned regionStart;
+	unsigned regionEnd;
+	if (!reader.getSustainRegion(attackStart, cuePoint, regionStart, regionEnd)) {
+		m_errorMessage = wxT("The sample has no sustained part to loop.");
+		return false;
+	}
+
+	std::vector<float> samples;
+	if (!reader.readFrames(regionStart, regionEnd - regionStart, samples)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+
+	// the channels are mixed so that all of them are matched at once
+	unsigned channels = reader.getNumberOfChannels();
+	unsigned numberOfFrames = samples.size() / channels;
+	std::vector<float> mono(numberOfFrames);
+	for (unsigned i = 0; i < numberOfFrames; i++) {
+		float sum = 0;
+		for (unsigned ch = 0; ch < channels; ch++)
+			sum += samples[i * channels + ch];
+		mono[i] = sum;
+	}
+
+	// a 32' C is 16.35 Hz, so each half of a 125 ms window covers one of its 61 ms periods
+	unsigned halfWindow = std::max(16u, reader.getSampleRate() / 16);
+	if (numberOfFrames < halfWindow * 6) {
+		m_errorMessage = wxT("The sustained part of the sample is too short to loop.");
+		return false;
+	}
+
+	std::vector<unsigned> starts;
+	std::vector<unsigned> ends;
+	unsigned middle = numberOfFrames / 2;
+	for (unsigned i = halfWindow; i < numberOfFrames - halfWindow; i++) {
+		if (mono[i - 1] < 0 && mono[i] >= 0) {
+			if (i < middle)
+				starts.push_back(i);
+			else
+				ends.push_back(i);
+		}
+	}
+	if (starts.empty() || ends.empty()) {
+		m_errorMessage = wxT("No zero crossings were found in the sustained part of the sample.");
+		return false;
+	}
+	pickEvenly(starts, 64);
+	pickEvenly(ends, 512);
+
+	unsigned windowLength = halfWindow * 2;
+	std::vector<double> endEnergies(ends.size());
+	for (unsigned j = 0; j < ends.size(); j++)
+		endEnergies[j] = AudioKernels::sumOfSquares(&mono[ends[j] - halfWindow], windowLength);
+
+	// the best end for each start, the playback jumps from the frame before the end crossing to the start
+	unsigned minimumLength = numberOfFrames / 3;
+	std::vector<LoopCandidate> bestForStart;
+	for (unsigned start : starts) {
+		const float *startWindow = &mono[start - halfWindow];
+		double startEnergy = AudioKernels::sumOfSquares(startWindow, windowLength);
+		LoopCandidate best;
+		best.seamError = 2;
+		for (unsigned j = 0; j < ends.size(); j++) {
+			if (ends[j] - start < minimumLength)
+				continue;
+			double energy = startEnergy + endEnergies[j];
+			if (energy <= 0)
+				continue;
+			double product = AudioKernels::dotProduct(startWindow, &mono[ends[j] - halfWindow], windowLength);
+			double seamError = std::max(0.0, 1.0 - 2.0 * product / energy);
+			if (seamError < best.seamError) {
+				best.seamError = seamError;
+				best.correlation = product / std::sqrt(startEnergy * endEnergies[j]);
+				best.loop.start = regionStart + start;
+				best.loop.end = regionStart + ends[j] - 1;
+			}
+		}
+		if (best.seamError < 2)
+			bestForStart.push_back(best);
+	}
+
+	std::sort(bestForStart.begin(), bestForStart.end(), [](const LoopCandidate &a, const LoopCandidate &b) {
+		return a.seamError < b.seamError;
+	});
+
+	// loops that are next to one already kept would sound the same
+	for (const LoopCandidate& candidate : bestForStart) {
+		if (m_candidates.size() >= m_maxCandidates)
+			break;
+		bool isDuplicate = false;
+		for (const LoopCandidate& kept : m_candidates) {
+			if (std::abs(kept.loop.start - candidate.loop.start) < (int) windowLength && std::abs(kept.loop.end - candidate.loop.end) < (int) windowLength) {
+				isDuplicate = true;
+				break;
+			}
+		}
+		if (!isDuplicate)
+			m_candidates.push_back(candidate);
+	}
+
+	if (m_candidates.empty()) {
+		m_errorMessage = wxT("No loop could be found in the sustained part of the sample.");
+		return false;
+	}
+	return true;
+}
+
+const std::vector<LoopCandidate>& LoopFinder::getCandidates() {
+	return m_candidates;
+}
+
+wxString LoopFinder::getErrorMessage() {
+	return m_errorMessage;
+}
+
+void LoopFinder::pickEvenly(std::vector<unsigned> &positions, unsigned maxCount) {
+	if (positions.size() <= maxCount)
+		return;
+	std::vector<unsigned> picked(maxCount);
+	for (unsigned i = 0; i < maxCount; i++)
+		picked[i] = positions[(size_t) i * positions.size() / maxCount];
+	positions.swap(picked);
+}
@@ -0,0 +1,65 @@
+/*
+ * LoopFinder.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef LOOPFINDER_H
+#define LOOPFINDER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "Loop.h"
+
+// A loop found by the LoopFinder. The seam error is the energy of the
+// difference between what is heard around the loop end and around the loop
+// start relative to their own energy, 0 for a perfect seam. The correlation
+// is the normalized cross-correlation of the same two windows.
+class LoopCandidate {
+public:
+	LoopCandidate();
+
+	Loop loop;
+	double seamError;
+	double correlation;
+};
+
+// Searches the sustained part of an attack for the loop that joins with the
+// smallest seam. Only rising zero crossings are tried as loop points so that
+// the phase matches at the jump. Every start is compared with every end by
+// normalized cross-correlation of a window around the two points, the windows
+// being long enough to cover two periods of a 32' C, the lowest pipes. The loops
+// are kept at least a third of the sustained part long.
+class LoopFinder {
+public:
+	LoopFinder(unsigned maxCandidates = 10);
+	~LoopFinder();
+
+	bool findLoops(wxString fullPath, int attackStart, int cuePoint);
+	// sorted with the smallest seam error first
+	const std::vector<LoopCandidate>& getCandidates();
+	wxString getErrorMessage();
+
+private:
+	unsigned m_maxCandidates;
+	std::vector<LoopCandidate> m_candidates;
+	wxString m_errorMessage;
+
+	static void pickEvenly(std::vector<unsigned> &positions, unsigned maxCount);
+};
+
+#endif
@@ -110,7 +110,7 @@ void Manual::write(wxTextFile *outFile) {
 	}
 }
 
-void Manual::read(wxFileConfig *cfg, bool useOldPanelFormat) {
+void Manual::read(OdfReader *cfg, bool useOldPanelFormat, bool readingPipes) {
 	m_name = cfg->Read("Name", wxEmptyString);
 	int logicalKeys = static_cast<int>(cfg->ReadLong("NumberOfLogicalKeys", 1));
 	if (logicalKeys > 0 && logicalKeys < 193) {
@@ -175,7 +175,7 @@ void Manual::read(wxFileConfig *cfg, bool useOldPanelFormat) {
 			if (cfg->HasGroup(stopGroup)) {
 				cfg->SetPath(wxT("/") + stopGroup);
 				Stop s;
-				s.read(cfg, useOldPanelFormat, this);
+				s.read(cfg, useOldPanelFormat, this, readingPipes);
 				::wxGetApp().m_frame->m_organ->addStop(s);
 				addStop(::wxGetApp().m_frame->m_organ->getOrganStopAt(::wxGetApp().m_frame->m_organ->getNumberOfStops() - 1));
 				if (s.isDisplayed()) {
@@ -334,6 +334,8 @@ void Manual::addStop(Stop* stop) {
 }
 
 void Manual::removeStop(Stop* stop) {
+	// the stops after it get other numbers
+	::wxGetApp().m_frame->m_organ->readPipesBeforeRenumbering();
 	// also remove stop from any divisional
 	for (auto& d : m_divisionals) {
 		if (d->hasStop(stop))
@@ -343,6 +345,7 @@ void Manual::removeStop(Stop* stop) {
 }
 
 void Manual::removeStopAt(unsigned index) {
+	::wxGetApp().m_frame->m_organ->readPipesBeforeRenumbering();
 	std::list<Stop *>::iterator it = m_stops.begin();
 	std::advance(it, index);
 	m_stops.erase(it);
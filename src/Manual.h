@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include <list>
 #include "Stop.h"
 #include "Divisional.h"
@@ -39,7 +39,8 @@ public:
 	~Manual();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool useOldPanelFormat);
+	// the pipes of the internal ranks of the stops can be left unread, see Rank::read
+	void read(OdfReader *cfg, bool useOldPanelFormat, bool readingPipes = true);
 
 	wxString getName();
 	void setName(wxString name);
@@ -432,6 +432,11 @@ void ManualPanel::OnNameChange(wxCommandEvent& WXUNUSED(event)) {
 }
 
 void ManualPanel::OnPedalCheckbox(wxCommandEvent& WXUNUSED(event)) {
+	// the manuals get other numbers with a pedal, also in pipes not read yet
+	if (!::wxGetApp().m_frame->ReadUnreadPipes()) {
+		m_thisIsThePedalCheckbox->SetValue(!m_thisIsThePedalCheckbox->GetValue());
+		return;
+	}
 	if (m_thisIsThePedalCheckbox->GetValue())
 		m_manual->setIsPedal(true);
 	else
@@ -591,6 +596,9 @@ void ManualPanel::OnMidiKeyMapValueSpin(wxSpinEvent& WXUNUSED(event)) {
 void ManualPanel::OnRemoveManualBtn(wxCommandEvent& WXUNUSED(event)) {
 	wxMessageDialog msg(this, wxT("Are you really sure you want to delete this manual?"), wxT("Are you sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 	if (msg.ShowModal() == wxID_YES) {
+		// pipes not read yet can borrow from the stops of this manual
+		if (!::wxGetApp().m_frame->ReadUnreadPipes())
+			return;
 		// remove all stops, couplers and divisionals that this manual "own" from the organ first
 		// the remove methods for stops, couplers and divisionals will also remove any existing gui representations of them
 		for (unsigned i = 0; i < m_manual->getNumberOfStops(); i++) {
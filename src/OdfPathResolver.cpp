@@ -0,0 +1,148 @@
+/*
+ * OdfPathResolver.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OdfPathResolver.h"
+#include <wx/dir.h>
+
+OdfPathResolver::OdfPathResolver(wxString odfRoot, bool ignoreCase) {
+	m_odfRoot = odfRoot;
+	m_ignoreCase = ignoreCase;
+	m_caseFoldedPaths = 0;
+}
+
+OdfPathResolver::~OdfPathResolver() {
+
+}
+
+wxString OdfPathResolver::resolve(wxString odfPath) {
+	if (odfPath == wxEmptyString)
+		return wxEmptyString;
+
+	// backslashes are separators too as ODFs are mostly written on windows
+	wxString path = odfPath;
+	path.Replace(wxT("\\"), wxT("/"));
+	wxArrayString parts = wxSplit(path, '/', '\0');
+
+	// the last part that isn't empty is the file name, the rest lead to its folder
+	int fileIdx = (int) parts.GetCount() - 1;
+	while (fileIdx >= 0 && (parts.Item(fileIdx).IsEmpty() || parts.Item(fileIdx) == wxT(".")))
+		fileIdx--;
+	if (fileIdx < 0 || parts.Item(fileIdx) == wxT(".."))
+		return wxEmptyString;
+
+	wxString folderPath = m_odfRoot;
+	bool isCaseFolded = false;
+	for (int i = 0; i < fileIdx; i++) {
+		const wxString &part = parts.Item(i);
+		if (part.IsEmpty() || part == wxT("."))
+			continue;
+		if (part == wxT("..")) {
+			folderPath = folderPath.BeforeLast(wxFILE_SEP_PATH);
+			continue;
+		}
+		ListedFolder &folder = getFolder(folderPath);
+		wxString nameOnDisk;
+		if (!findName(folder.subFolders, folder.subFoldersByLowerCase, part, nameOnDisk, isCaseFolded)) {
+			if (isCaseFolded)
+				m_caseFoldedPaths++;
+			return wxEmptyString;
+		}
+		folderPath += wxFILE_SEP_PATH + nameOnDisk;
+	}
+
+	ListedFolder &folder = getFolder(folderPath);
+	wxString fileName;
+	bool found = findName(folder.files, folder.filesByLowerCase, parts.Item(fileIdx), fileName, isCaseFolded);
+	if (isCaseFolded)
+		m_caseFoldedPaths++;
+	if (!found)
+		return wxEmptyString;
+	return folderPath + wxFILE_SEP_PATH + fileName;
+}
+
+unsigned OdfPathResolver::getNumberOfListedFolders() {
+	std::lock_guard<std::mutex> lock(m_foldersMutex);
+	return m_folders.size();
+}
+
+unsigned OdfPathResolver::getNumberOfCaseFoldedPaths() {
+	return m_caseFoldedPaths;
+}
+
+OdfPathResolver::ListedFolder& OdfPathResolver::getFolder(wxString folderPath) {
+	ListedFolder *folder;
+	{
+		std::lock_guard<std::mutex> lock(m_foldersMutex);
+		folder = &m_folders[folderPath];
+	}
+
+	// the first thread to need the folder lists it while any others wait for
+	// that, but other folders can be listed meanwhile
+	std::call_once(folder->listing, [&]() {
+		listFolder(folderPath, *folder);
+	});
+	return *folder;
+}
+
+void OdfPathResolver::listFolder(wxString folderPath, ListedFolder &folder) {
+	folder.isOpened = false;
+
+	// checking first avoids wxDir logging an error for folders that don't exist
+	if (!wxDir::Exists(folderPath))
+		return;
+
+	wxDir dir(folderPath);
+	if (!dir.IsOpened())
+		return;
+
+	folder.isOpened = true;
+
+	wxString name;
+	bool cont = dir.GetFirst(&name, wxEmptyString, wxDIR_DIRS | wxDIR_HIDDEN);
+	while (cont) {
+		folder.subFolders.insert(name);
+		folder.subFoldersByLowerCase.insert(std::make_pair(name.Lower(), name));
+		cont = dir.GetNext(&name);
+	}
+
+	cont = dir.GetFirst(&name, wxEmptyString, wxDIR_FILES | wxDIR_HIDDEN);
+	while (cont) {
+		folder.files.insert(name);
+		folder.filesByLowerCase.insert(std::make_pair(name.Lower(), name));
+		cont = dir.GetNext(&name);
+	}
+}
+
+bool OdfPathResolver::findName(const std::set<wxString> &names, const std::map<wxString, wxString> &namesByLowerCase, wxString name, wxString &nameOnDisk, bool &isCaseFolded) {
+	if (names.count(name)) {
+		nameOnDisk = name;
+		return true;
+	}
+
+	std::map<wxString, wxString>::const_iterator it = namesByLowerCase.find(name.Lower());
+	if (it == namesByLowerCase.end())
+		return false;
+
+	isCaseFolded = true;
+	if (!m_ignoreCase)
+		return false;
+	nameOnDisk = it->second;
+	return true;
+}
@@ -0,0 +1,73 @@
+/*
+ * OdfPathResolver.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ODFPATHRESOLVER_H
+#define ODFPATHRESOLVER_H
+
+#include <wx/wx.h>
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
+
+// Finds the files that the paths of an ODF point at by listing each folder
+// only once and answering from memory, instead of asking the file system
+// about every sample and image. The paths can use both / and \ as separator
+// and can optionally match the names on disk regardless of case, as for
+// ODFs made on Windows. An exact match is always preferred, and the paths
+// that only match when case is ignored are counted either way so that the
+// user can be told about them. It can be used by several threads at once and
+// every folder is still listed only once.
+class OdfPathResolver {
+public:
+	OdfPathResolver(wxString odfRoot, bool ignoreCase = false);
+	~OdfPathResolver();
+
+	// the full path of the file on disk or an empty string if there's none
+	wxString resolve(wxString odfPath);
+	unsigned getNumberOfListedFolders();
+	// the paths that only matched, or would only have matched, when ignoring case
+	unsigned getNumberOfCaseFoldedPaths();
+
+private:
+	class ListedFolder {
+	public:
+		std::once_flag listing;
+		bool isOpened;
+		std::set<wxString> files;
+		std::set<wxString> subFolders;
+		// the lower case names lead to the names on disk
+		std::map<wxString, wxString> filesByLowerCase;
+		std::map<wxString, wxString> subFoldersByLowerCase;
+	};
+
+	wxString m_odfRoot;
+	bool m_ignoreCase;
+	std::atomic<unsigned> m_caseFoldedPaths;
+	// the folders are never removed so the references handed out stay valid
+	std::map<wxString, ListedFolder> m_folders;
+	std::mutex m_foldersMutex;
+
+	ListedFolder& getFolder(wxString folderPath);
+	void listFolder(wxString folderPath, ListedFolder &folder);
+	bool findName(const std::set<wxString> &names, const std::map<wxString, wxString> &namesByLowerCase, wxString name, wxString &nameOnDisk, bool &isCaseFolded);
+};
+
+#endif
@@ -0,0 +1,409 @@
+/*
+ * OdfReader.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OdfReader.h"
+#include <wx/file.h>
+#include <charconv>
+#include <cstring>
+
+OdfReader::OdfReader() {
+	m_document = std::make_shared<Document>();
+	m_document->numberOfSections = 1;
+	m_document->numberOfLines = 0;
+	m_section = 0;
+	m_path = wxT("/");
+	m_errorMessage = wxEmptyString;
+}
+
+OdfReader::~OdfReader() {
+
+}
+
+bool OdfReader::readFile(wxString fileName) {
+	std::shared_ptr<Document> document = std::make_shared<Document>();
+	wxFile file;
+	if (!wxFile::Exists(fileName) || !file.Open(fileName)) {
+		m_errorMessage = wxT("The file ") + fileName + wxT(" couldn't be opened!");
+		return false;
+	}
+	wxFileOffset length = file.Length();
+	if (length < 0 || length >= 0xFFFFFFFF) {
+		m_errorMessage = wxT("The file ") + fileName + wxT(" is too large!");
+		return false;
+	}
+	document->text.resize(length);
+	if (length > 0 && file.Read(document->text.data(), length) != length) {
+		m_errorMessage = wxT("The file ") + fileName + wxT(" couldn't be read!");
+		return false;
+	}
+	document->index();
+
+	m_document = document;
+	m_section = 0;
+	m_path = wxT("/");
+	m_errorMessage = wxEmptyString;
+	return true;
+}
+
+wxString OdfReader::getErrorMessage() const {
+	return m_errorMessage;
+}
+
+unsigned OdfReader::getNumberOfLines() const {
+	return m_document->numberOfLines;
+}
+
+bool OdfReader::HasGroup(const wxString &group) const {
+	char name[256];
+	size_t length = composeKey(group.StartsWith(wxT("/")) ? group.Mid(1) : group, "", name, sizeof(name));
+	return length && m_document->find(SECTION_NAMES, name, length);
+}
+
+void OdfReader::SetPath(const wxString &path) {
+	m_path = path;
+	wxString group = path.StartsWith(wxT("/")) ? path.Mid(1) : path;
+	if (group.IsEmpty()) {
+		m_section = 0;
+		return;
+	}
+	char name[256];
+	size_t length = composeKey(group, "", name, sizeof(name));
+	const Entry *entry = length ? m_document->find(SECTION_NAMES, name, length) : NULL;
+	m_section = entry ? entry->valueOffset : MISSING_SECTION;
+}
+
+wxString OdfReader::GetPath() const {
+	return m_path;
+}
+
+bool OdfReader::HasEntry(const wxString &key) const {
+	return findEntry(key, "") != NULL;
+}
+
+wxString OdfReader::Read(const wxString &key, const wxString &defaultValue) const {
+	return Read(key, "", defaultValue);
+}
+
+long OdfReader::ReadLong(const wxString &key, long defaultValue) const {
+	return ReadLong(key, "", defaultValue);
+}
+
+double OdfReader::ReadDouble(const wxString &key, double defaultValue) const {
+	return ReadDouble(key, "", defaultValue);
+}
+
+bool OdfReader::HasEntry(const char *key) const {
+	return findEntry(wxEmptyString, key) != NULL;
+}
+
+wxString OdfReader::Read(const char *key, const wxString &defaultValue) const {
+	return Read(wxEmptyString, key, defaultValue);
+}
+
+long OdfReader::ReadLong(const char *key, long defaultValue) const {
+	return ReadLong(wxEmptyString, key, defaultValue);
+}
+
+double OdfReader::ReadDouble(const char *key, double defaultValue) const {
+	return ReadDouble(wxEmptyString, key, defaultValue);
+}
+
+bool OdfReader::HasEntry(const wxString &prefix, const char *suffix) const {
+	return findEntry(prefix, suffix) != NULL;
+}
+
+wxString OdfReader::Read(const wxString &prefix, const char *suffix, const wxString &defaultValue) const {
+	const Entry *entry = findEntry(prefix, suffix);
+	if (!entry)
+		return defaultValue;
+	return decodeValue(entry);
+}
+
+long OdfReader::ReadLong(const wxString &prefix, const char *suffix, long defaultValue) const {
+	long value;
+	if (!parseLong(findEntry(prefix, suffix), value))
+		return defaultValue;
+	return value;
+}
+
+double OdfReader::ReadDouble(const wxString &prefix, const char *suffix, double defaultValue) const {
+	double value;
+	if (!parseDouble(findEntry(prefix, suffix), value))
+		return defaultValue;
+	return value;
+}
+
+bool OdfReader::ReadBoolean(const wxString &prefix, const char *suffix, bool defaultValue) const {
+	const Entry *entry = findEntry(prefix, suffix);
+	if (!entry || entry->valueLength != 1)
+		return defaultValue;
+	char value = m_document->text[entry->valueOffset];
+	if (value == 'Y' || value == 'y')
+		return true;
+	if (value == 'N' || value == 'n')
+		return false;
+	return defaultValue;
+}
+
+void OdfReader::ReadLines(const char *keyPrefix, wxArrayString &lines) const {
+	if (m_section == MISSING_SECTION)
+		return;
+	size_t prefixLength = strlen(keyPrefix);
+	const char *text = m_document->text.data();
+	for (const SectionRun& run : m_document->runs) {
+		if (run.section != m_section)
+			continue;
+		for (unsigned i = run.firstEntry; i < run.endEntry; i++) {
+			const Entry &entry = m_document->entries[i];
+			if (entry.keyLength < prefixLength || !equalKeys(text + entry.keyOffset, keyPrefix, prefixLength))
+				continue;
+			// a repeated key has its value further down so the line is put together again
+			const char *lineStart = text + entry.keyOffset;
+			size_t lineLength = entry.valueOffset + entry.valueLength - entry.keyOffset;
+			if (memchr(lineStart, '\n', lineLength))
+				lines.Add(decodeText(lineStart, entry.keyLength) + wxT("=") + decodeValue(&entry));
+			else
+				lines.Add(decodeText(lineStart, lineLength));
+		}
+	}
+}
+
+void OdfReader::Document::index() {
+	numberOfSections = 1;
+	numberOfLines = 0;
+	entries.clear();
+	slots.assign(1024, 0);
+	runs.clear();
+	beginRun(0);
+
+	size_t size = text.size();
+	size_t position = 0;
+	// a byte order mark is skipped
+	if (size >= 3 && (unsigned char) text[0] == 0xEF && (unsigned char) text[1] == 0xBB && (unsigned char) text[2] == 0xBF)
+		position = 3;
+
+	unsigned section = 0;
+	while (position < size) {
+		size_t lineEnd = position;
+		while (lineEnd < size && text[lineEnd] != '\n')
+			lineEnd++;
+		size_t next = lineEnd + 1;
+		numberOfLines++;
+
+		size_t start = position;
+		size_t end = lineEnd;
+		while (start < end && (text[start] == ' ' || text[start] == '\t'))
+			start++;
+		while (end > start && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\r'))
+			end--;
+		position = next;
+		if (start == end || text[start] == ';')
+			continue;
+
+		if (text[start] == '[') {
+			if (text[end - 1] != ']')
+				continue;
+			size_t nameStart = start + 1;
+			size_t nameEnd = end - 1;
+			while (nameStart < nameEnd && (text[nameStart] == ' ' || text[nameStart] == '\t'))
+				nameStart++;
+			while (nameEnd > nameStart && (text[nameEnd - 1] == ' ' || text[nameEnd - 1] == '\t'))
+				nameEnd--;
+			if (nameStart == nameEnd)
+				continue;
+			unsigned nameEntries = entries.size();
+			unsigned index = addEntry(SECTION_NAMES, nameStart, nameEnd);
+			// a section that appears again continues where it was
+			if (index == nameEntries)
+				entries[index].valueOffset = numberOfSections++;
+			section = entries[index].valueOffset;
+			beginRun(section);
+			continue;
+		}
+
+		size_t separator = start;
+		while (separator < end && text[separator] != '=')
+			separator++;
+		if (separator == end)
+			continue;
+		size_t keyEnd = separator;
+		while (keyEnd > start && (text[keyEnd - 1] == ' ' || text[keyEnd - 1] == '\t'))
+			keyEnd--;
+		if (keyEnd == start)
+			continue;
+		size_t valueStart = separator + 1;
+		while (valueStart < end && (text[valueStart] == ' ' || text[valueStart] == '\t'))
+			valueStart++;
+
+		Entry &entry = entries[addEntry(section, start, keyEnd)];
+		entry.valueOffset = valueStart;
+		entry.valueLength = end - valueStart;
+		runs.back().endEntry = entries.size();
+	}
+}
+
+unsigned OdfReader::Document::addEntry(unsigned section, size_t keyStart, size_t keyEnd) {
+	unsigned long long hash = hashKey(section, text.data() + keyStart, keyEnd - keyStart);
+	size_t mask = slots.size() - 1;
+	for (size_t slot = hash & mask; slots[slot]; slot = (slot + 1) & mask) {
+		Entry &existing = entries[slots[slot] - 1];
+		if (existing.hash == hash && existing.section == section && existing.keyLength == keyEnd - keyStart && equalKeys(text.data() + existing.keyOffset, text.data() + keyStart, keyEnd - keyStart))
+			return slots[slot] - 1;
+	}
+
+	Entry entry;
+	entry.section = section;
+	entry.keyOffset = keyStart;
+	entry.keyLength = keyEnd - keyStart;
+	entry.valueOffset = 0;
+	entry.valueLength = 0;
+	entry.hash = hash;
+	entries.push_back(entry);
+	if (entries.size() * 2 > slots.size()) {
+		growSlots();
+	} else {
+		size_t slot = hash & mask;
+		while (slots[slot])
+			slot = (slot + 1) & mask;
+		slots[slot] = entries.size();
+	}
+	return entries.size() - 1;
+}
+
+void OdfReader::Document::beginRun(unsigned section) {
+	SectionRun run;
+	run.section = section;
+	run.firstEntry = entries.size();
+	run.endEntry = entries.size();
+	runs.push_back(run);
+}
+
+void OdfReader::Document::growSlots() {
+	slots.assign(slots.size() * 2, 0);
+	size_t mask = slots.size() - 1;
+	for (unsigned i = 0; i < entries.size(); i++) {
+		size_t slot = entries[i].hash & mask;
+		while (slots[slot])
+			slot = (slot + 1) & mask;
+		slots[slot] = i + 1;
+	}
+}
+
+const OdfReader::Entry* OdfReader::Document::find(unsigned section, const char *key, size_t length) const {
+	if (slots.empty())
+		return NULL;
+	unsigned long long hash = hashKey(section, key, length);
+	size_t mask = slots.size() - 1;
+	for (size_t slot = hash & mask; slots[slot]; slot = (slot + 1) & mask) {
+		const Entry &entry = entries[slots[slot] - 1];
+		if (entry.hash == hash && entry.section == section && entry.keyLength == length && equalKeys(text.data() + entry.keyOffset, key, length))
+			return &entry;
+	}
+	return NULL;
+}
+
+const OdfReader::Entry* OdfReader::findEntry(const wxString &prefix, const char *suffix) const {
+	if (m_section == MISSING_SECTION)
+		return NULL;
+	char key[256];
+	size_t length = composeKey(prefix, suffix, key, sizeof(key));
+	if (!length)
+		return NULL;
+	return m_document->find(m_section, key, length);
+}
+
+wxString OdfReader::decodeValue(const Entry *entry) const {
+	if (!entry->valueLength)
+		return wxEmptyString;
+	return decodeText(m_document->text.data() + entry->valueOffset, entry->valueLength);
+}
+
+wxString OdfReader::decodeText(const char *text, size_t length) const {
+	wxString decoded = wxString::FromUTF8(text, length);
+	if (decoded.IsEmpty())
+		decoded = wxString(text, wxConvISO8859_1, length);
+	return decoded;
+}
+
+bool OdfReader::parseLong(const Entry *entry, long &value) const {
+	if (!entry || !entry->valueLength)
+		return false;
+	const char *first = m_document->text.data() + entry->valueOffset;
+	const char *last = first + entry->valueLength;
+	if (*first == '+' && last - first > 1 && first[1] != '-')
+		first++;
+	std::from_chars_result result = std::from_chars(first, last, value);
+	return result.ec == std::errc() && result.ptr == last;
+}
+
+bool OdfReader::parseDouble(const Entry *entry, double &value) const {
+	if (!entry || !entry->valueLength)
+		return false;
+	const char *first = m_document->text.data() + entry->valueOffset;
+	const char *last = first + entry->valueLength;
+	if (*first == '+' && last - first > 1 && first[1] != '-')
+		first++;
+	// from_chars for doubles is missing in some toolchains (mingw), and
+	// ToCDouble always reads a '.' as the decimal point whatever the locale
+	wxString text = wxString::FromAscii(first, last - first);
+	return text.ToCDouble(&value);
+}
+
+unsigned long long OdfReader::hashKey(unsigned section, const char *key, size_t length) {
+	// FNV-1a over the section number and the key in lower case
+	unsigned long long hash = 14695981039346656037ULL;
+	for (unsigned i = 0; i < 4; i++) {
+		hash ^= (section >> (i * 8)) & 0xFF;
+		hash *= 1099511628211ULL;
+	}
+	for (size_t i = 0; i < length; i++) {
+		hash ^= lowerAscii(key[i]);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+unsigned char OdfReader::lowerAscii(char c) {
+	return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : (unsigned char) c;
+}
+
+bool OdfReader::equalKeys(const char *a, const char *b, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		if (lowerAscii(a[i]) != lowerAscii(b[i]))
+			return false;
+	}
+	return true;
+}
+
+size_t OdfReader::composeKey(const wxString &prefix, const char *suffix, char *buffer, size_t capacity) {
+	size_t length = 0;
+	for (wxString::const_iterator it = prefix.begin(); it != prefix.end(); ++it) {
+		wchar_t c = *it;
+		if (c > 127 || c < 0 || length == capacity)
+			return 0;
+		buffer[length++] = (char) c;
+	}
+	for (; *suffix; suffix++) {
+		if (length == capacity)
+			return 0;
+		buffer[length++] = *suffix;
+	}
+	return length;
+}
@@ -0,0 +1,139 @@
+/*
+ * OdfReader.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ODFREADER_H
+#define ODFREADER_H
+
+#include <wx/wx.h>
+#include <memory>
+#include <vector>
+
+// Reads an ODF in one pass instead of through wxFileConfig. The whole file is
+// kept as it is in memory and every section and key is indexed by a hash
+// table pointing into that text, so nothing is copied until a value is read
+// and looking up a key never allocates. Values are taken as GrandOrgue takes
+// them, trimmed but without any escapes, and are decoded as UTF-8 or else as
+// Latin-1. When a key is repeated in a section the last one counts. Like
+// wxFileConfig, sections and keys are matched regardless of ascii case.
+//
+// The methods used by the read methods of the organ elements have the same
+// names and meaning as in wxFileConfig. Keys can also be given as a prefix
+// and a suffix, like the pipe number and the attribute name, which are then
+// looked up without being put together into a new string. Copies of a reader
+// share the text and index but have their own path, so each thread can use
+// a copy of its own.
+class OdfReader {
+public:
+	OdfReader();
+	~OdfReader();
+
+	bool readFile(wxString fileName);
+	wxString getErrorMessage() const;
+	unsigned getNumberOfLines() const;
+
+	bool HasGroup(const wxString &group) const;
+	// only absolute paths like /Organ are understood
+	void SetPath(const wxString &path);
+	wxString GetPath() const;
+	bool HasEntry(const wxString &key) const;
+	wxString Read(const wxString &key, const wxString &defaultValue) const;
+	long ReadLong(const wxString &key, long defaultValue) const;
+	double ReadDouble(const wxString &key, double defaultValue) const;
+
+	// plain ascii keys, as most keys are given, are looked up without being converted first
+	bool HasEntry(const char *key) const;
+	wxString Read(const char *key, const wxString &defaultValue) const;
+	long ReadLong(const char *key, long defaultValue) const;
+	double ReadDouble(const char *key, double defaultValue) const;
+
+	bool HasEntry(const wxString &prefix, const char *suffix) const;
+	wxString Read(const wxString &prefix, const char *suffix, const wxString &defaultValue) const;
+	long ReadLong(const wxString &prefix, const char *suffix, long defaultValue) const;
+	double ReadDouble(const wxString &prefix, const char *suffix, double defaultValue) const;
+	// Y or N in any case as GOODF_functions::parseBoolean understands them
+	bool ReadBoolean(const wxString &prefix, const char *suffix, bool defaultValue) const;
+
+	// the lines of the current section with a key that starts with the prefix,
+	// in the order of the file and as they were written apart from surrounding
+	// white space, so that entries never read can be written back unchanged
+	void ReadLines(const char *keyPrefix, wxArrayString &lines) const;
+
+private:
+	class Entry {
+	public:
+		unsigned section;
+		unsigned keyOffset;
+		unsigned keyLength;
+		unsigned valueOffset;
+		unsigned valueLength;
+		unsigned long long hash;
+	};
+
+	// the entries that follow one section header, a section that appears
+	// again in the file gets another run
+	class SectionRun {
+	public:
+		unsigned section;
+		unsigned firstEntry;
+		unsigned endEntry;
+	};
+
+	// the names of the sections are entries of their own in this section,
+	// with the number of the section they name as the value offset
+	static const unsigned SECTION_NAMES = 0xFFFFFFFF;
+	// the path when it's set to a section that isn't in the file
+	static const unsigned MISSING_SECTION = 0xFFFFFFFE;
+
+	class Document {
+	public:
+		std::vector<char> text;
+		std::vector<Entry> entries;
+		// open addressing with the entry index plus one, 0 when free
+		std::vector<unsigned> slots;
+		std::vector<SectionRun> runs;
+		unsigned numberOfSections;
+		unsigned numberOfLines;
+
+		void index();
+		// returns the index of the entry, an existing one if the key is repeated
+		unsigned addEntry(unsigned section, size_t keyStart, size_t keyEnd);
+		void growSlots();
+		void beginRun(unsigned section);
+		const Entry* find(unsigned section, const char *key, size_t length) const;
+	};
+
+	std::shared_ptr<Document> m_document;
+	unsigned m_section;
+	wxString m_path;
+	wxString m_errorMessage;
+
+	const Entry* findEntry(const wxString &prefix, const char *suffix) const;
+	wxString decodeValue(const Entry *entry) const;
+	wxString decodeText(const char *text, size_t length) const;
+	bool parseLong(const Entry *entry, long &value) const;
+	bool parseDouble(const Entry *entry, double &value) const;
+	static unsigned long long hashKey(unsigned section, const char *key, size_t length);
+	static unsigned char lowerAscii(char c);
+	static bool equalKeys(const char *a, const char *b, size_t length);
+	// the ascii characters of the string followed by the suffix, 0 if it doesn't fit or isn't ascii
+	static size_t composeKey(const wxString &prefix, const char *suffix, char *buffer, size_t capacity);
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * OnsetDetector.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OnsetDetector.h"
+#include "SampleAudioReader.h"
+#include "AudioKernels.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+OnsetDetector::OnsetDetector(double thresholdDb, double marginMs) {
+	m_thresholdDb = thresholdDb;
+	m_marginMs = marginMs;
+	m_onset = 0;
+	m_attackStart = 0;
+	m_bytesPerFrame = 0;
+	m_errorMessage = wxEmptyString;
+}
+
+OnsetDetector::~OnsetDetector() {
+
+}
+
+bool OnsetDetector::findOnset(wxString fullPath) {
+	m_onset = 0;
+	m_attackStart = 0;
+
+	SampleAudioReader reader;
+	if (!reader.open(fullPath)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned sampleRate = reader.getSampleRate();
+	unsigned channels = reader.getNumberOfChannels();
+	m_bytesPerFrame = reader.getBytesPerFrame();
+
+	// the attack and the start of the steady tone are always within the first few seconds
+	std::vector<float> samples;
+	if (!reader.readFrames(0, sampleRate * 4, samples)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned numberOfFrames = samples.size() / channels;
+
+	float peak = AudioKernels::peakAbs(samples.data(), samples.size());
+	if (peak <= 0) {
+		m_errorMessage = wxT("The sample is silent.");
+		return false;
+	}
+	float threshold = peak * (float) std::pow(10.0, m_thresholdDb / 20.0);
+
+	// rises in a millisecond and falls in twenty, and must stay above the
+	// threshold for 50 ms so that a click falls back before it counts
+	float attackCoefficient = 1.0f - (float) std::exp(-1.0 / (0.001 * sampleRate));
+	float releaseCoefficient = 1.0f - (float) std::exp(-1.0 / (0.02 * sampleRate));
+	unsigned holdFrames = sampleRate / 20;
+	float envelope = 0;
+	bool isAbove = false;
+	bool found = false;
+	for (unsigned i = 0; i < numberOfFrames && !found; i++) {
+		float level = 0;
+		for (unsigned ch = 0; ch < channels; ch++)
+			level = std::max(level, std::fabs(samples[i * channels + ch]));
+		envelope += (level - envelope) * (level > envelope ? attackCoefficient : releaseCoefficient);
+		if (envelope < threshold) {
+			isAbove = false;
+		} else if (!isAbove) {
+			isAbove = true;
+			m_onset = i;
+		}
+		found = isAbove && (i - m_onset >= holdFrames || i == numberOfFrames - 1);
+	}
+	if (!found) {
+		m_errorMessage = wxT("The sample never rises above the threshold.");
+		return false;
+	}
+
+	unsigned margin = (unsigned) (m_marginMs * sampleRate / 1000.0);
+	m_attackStart = m_onset > margin ? m_onset - margin : 0;
+	return true;
+}
+
+unsigned OnsetDetector::getAttackStart() {
+	return m_attackStart;
+}
+
+unsigned OnsetDetector::getOnset() {
+	return m_onset;
+}
+
+unsigned OnsetDetector::getBytesPerFrame() {
+	return m_bytesPerFrame;
+}
+
+wxString OnsetDetector::getErrorMessage() {
+	return m_errorMessage;
+}
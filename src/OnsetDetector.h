@@ -0,0 +1,54 @@
+/*
+ * OnsetDetector.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ONSETDETECTOR_H
+#define ONSETDETECTOR_H
+
+#include <wx/wx.h>
+
+// Finds where the sound of a sample begins after the silence recorded before
+// it. An envelope follower with a short attack runs over the loudest of the
+// channels, and the onset is the first frame from where the envelope stays
+// at or above the threshold, given in dB below the peak of the sample, long
+// enough that single clicks don't count. A margin is then kept before it so that nothing audible of
+// the attack is cut. Only the first seconds of the sample are read.
+class OnsetDetector {
+public:
+	OnsetDetector(double thresholdDb = -50, double marginMs = 5);
+	~OnsetDetector();
+
+	bool findOnset(wxString fullPath);
+	// the onset less the margin, where the attack could start
+	unsigned getAttackStart();
+	unsigned getOnset();
+	// what each frame takes in the sample file
+	unsigned getBytesPerFrame();
+	wxString getErrorMessage();
+
+private:
+	double m_thresholdDb;
+	double m_marginMs;
+	unsigned m_onset;
+	unsigned m_attackStart;
+	unsigned m_bytesPerFrame;
+	wxString m_errorMessage;
+};
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * OpenOrganDialog.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OpenOrganDialog.h"
+#include <wx/statline.h>
+
+IMPLEMENT_CLASS(OpenOrganDialog, wxDialog)
+
+OpenOrganDialog::OpenOrganDialog(wxString odfPath, bool ignoreCase, bool readPipesOnDemand, unsigned pipesOnDemandLines) {
+	Init(odfPath, ignoreCase, readPipesOnDemand, pipesOnDemandLines);
+}
+
+OpenOrganDialog::OpenOrganDialog(
+	wxString odfPath,
+	bool ignoreCase,
+	bool readPipesOnDemand,
+	unsigned pipesOnDemandLines,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(odfPath, ignoreCase, readPipesOnDemand, pipesOnDemandLines);
+	Create(parent, id, caption, pos, size, style);
+}
+
+OpenOrganDialog::~OpenOrganDialog() {
+
+}
+
+void OpenOrganDialog::Init(wxString odfPath, bool ignoreCase, bool readPipesOnDemand, unsigned pipesOnDemandLines) {
+	m_odfPath = odfPath;
+	m_ignoreCase = ignoreCase;
+	m_readPipesOnDemand = readPipesOnDemand;
+	m_pipesOnDemandLines = pipesOnDemandLines;
+}
+
+bool OpenOrganDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void OpenOrganDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *pathText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Open ") + m_odfPath
+	);
+	firstRow->Add(pathText, 1, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxHORIZONTAL);
+	m_ignoreCaseBox = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxT("Match file paths regardless of upper/lower case (for ODFs made on Windows)")
+	);
+	m_ignoreCaseBox->SetValue(m_ignoreCase);
+	secondRow->Add(m_ignoreCaseBox, 0, wxALL, 5);
+	mainSizer->Add(secondRow, 0, wxGROW);
+
+	wxBoxSizer *thirdRow = new wxBoxSizer(wxHORIZONTAL);
+	m_readPipesOnDemandBox = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxT("Read pipes only when needed if the ODF has more lines than: ")
+	);
+	m_readPipesOnDemandBox->SetValue(m_readPipesOnDemand);
+	thirdRow->Add(m_readPipesOnDemandBox, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_pipesOnDemandLinesSpin = new wxSpinCtrl(
+		this,
+		wxID_ANY,
+		wxEmptyString,
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxSP_ARROW_KEYS,
+		0,
+		100000000,
+		m_pipesOnDemandLines
+	);
+	thirdRow->Add(m_pipesOnDemandLinesSpin, 0, wxALL, 5);
+	mainSizer->Add(thirdRow, 0, wxGROW);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Open organ")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+bool OpenOrganDialog::GetIgnoreCase() {
+	return m_ignoreCaseBox->GetValue();
+}
+
+bool OpenOrganDialog::GetReadPipesOnDemand() {
+	return m_readPipesOnDemandBox->GetValue();
+}
+
+unsigned OpenOrganDialog::GetPipesOnDemandLines() {
+	return m_pipesOnDemandLinesSpin->GetValue();
+}
@@ -0,0 +1,82 @@
+/*
+ * OpenOrganDialog.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef OPENORGANDIALOG_H
+#define OPENORGANDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/checkbox.h>
+#include <wx/spinctrl.h>
+
+// The options for how an existing .organ file is read
+class OpenOrganDialog : public wxDialog {
+	DECLARE_CLASS(OpenOrganDialog)
+
+public:
+	// Constructors
+	OpenOrganDialog(wxString odfPath, bool ignoreCase, bool readPipesOnDemand, unsigned pipesOnDemandLines);
+	OpenOrganDialog(
+		wxString odfPath,
+		bool ignoreCase,
+		bool readPipesOnDemand,
+		unsigned pipesOnDemandLines,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Open Organ"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~OpenOrganDialog();
+
+	// Initialize our variables
+	void Init(wxString odfPath, bool ignoreCase, bool readPipesOnDemand, unsigned pipesOnDemandLines);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Open Organ"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	bool GetIgnoreCase();
+	bool GetReadPipesOnDemand();
+	unsigned GetPipesOnDemandLines();
+
+private:
+	wxString m_odfPath;
+	bool m_ignoreCase;
+	bool m_readPipesOnDemand;
+	unsigned m_pipesOnDemandLines;
+
+	wxCheckBox *m_ignoreCaseBox;
+	wxCheckBox *m_readPipesOnDemandBox;
+	wxSpinCtrl *m_pipesOnDemandLinesSpin;
+};
+
+#endif
@@ -20,10 +20,19 @@
 
 #include "Organ.h"
 #include "GOODFFunctions.h"
+#include "OdfPathResolver.h"
+#include "WorkerPool.h"
+#include <algorithm>
 
 Organ::Organ() {
 	// Initialize a new blank organ
 	m_odfRoot = wxEmptyString;
+	m_pathResolver = NULL;
+	m_unreadPipesReader = NULL;
+	m_unreadPipesResolver = NULL;
+	m_unreadPipesRoot = wxEmptyString;
+	m_caseFoldedPaths = 0;
+	m_reportedCaseFoldedPaths = 0;
 	m_churchName = wxEmptyString;
 	m_churchAddress = wxEmptyString;
 	m_organBuilder = wxEmptyString;
@@ -42,6 +51,8 @@ Organ::Organ() {
 	m_pitchTuning = 0.0f;
 	m_pitchCorrection = 0.0f;
 	m_trackerDelay = 0;
+	m_batchUpdateDepth = 0;
+	m_organElementsOutdated = false;
 	populateSetterElements();
 	updateOrganElements();
 
@@ -52,7 +63,7 @@ Organ::Organ() {
 }
 
 Organ::~Organ() {
-
+	releaseUnreadPipesSource();
 }
 
 void Organ::writeOrgan(wxTextFile *outFile) {
@@ -346,6 +357,9 @@ bool Organ::doesHavePedals() {
 }
 
 void Organ::setHasPedals(bool hasPedals) {
+	// the manuals are numbered from the pedal when there is one
+	if (hasPedals != m_hasPedals)
+		readPipesBeforeRenumbering();
 	m_hasPedals = hasPedals;
 }
 
@@ -527,6 +541,7 @@ void Organ::removeWindchestgroupAt(unsigned index) {
 	std::list<Windchestgroup>::iterator it = m_Windchestgroups.begin();
 	std::advance(it, index);
 	// now we're at the windchest to remove but first we should remove it from any stop/rank/pipe that have it set
+	readPipesBeforeRenumbering();
 	for (Stop& s : m_Stops) {
 		if (s.isUsingInternalRank()) {
 			if (s.getInternalRank()->getWindchest() == &(*it)) {
@@ -648,7 +663,7 @@ unsigned Organ::getIndexOfOrganRank(Rank *rank) {
 }
 
 void Organ::addRank(Rank rank) {
-	m_Ranks.push_back(rank);
+	m_Ranks.push_back(std::move(rank));
 }
 
 void Organ::removeRankAt(unsigned index) {
@@ -683,7 +698,7 @@ unsigned Organ::getIndexOfOrganStop(Stop *stop) {
 }
 
 void Organ::addStop(Stop stop) {
-	m_Stops.push_back(stop);
+	m_Stops.push_back(std::move(stop));
 	updateOrganElements();
 }
 
@@ -691,6 +706,7 @@ void Organ::removeStopAt(unsigned index) {
 	std::list<Stop>::iterator it = m_Stops.begin();
 	std::advance(it, index);
 	// any other stop or rank can reference this stops' internal rank pipes, and if they do we should reset them to DUMMIES
+	readPipesBeforeRenumbering();
 	int manualRef = getIndexOfOrganManual((*it).getOwningManual());
 	int stopRef = (*it).getOwningManual()->getIndexOfStop(&(*it)) + 1;
 	wxString refStr = wxT("REF:") + GOODF_functions::number_format(manualRef) + wxT(":") + GOODF_functions::number_format(stopRef);
@@ -698,18 +714,16 @@ void Organ::removeStopAt(unsigned index) {
 	for (Stop& s : m_Stops) {
 		if (s.isUsingInternalRank()) {
 			for (Pipe& p : s.getInternalRank()->m_pipes) {
-				if (p.m_attacks.front().fileName.StartsWith(refStr, &rest)) {
-					p.m_attacks.front().fileName = wxT("DUMMY");
-					p.m_attacks.front().fullPath = wxT("DUMMY");
+				if (p.m_attacks.front().getFileName().StartsWith(refStr, &rest)) {
+					p.m_attacks.front().setFullPath(wxT("DUMMY"));
 				}
 			}
 		}
 	}
 	for (Rank& r : m_Ranks) {
 		for (Pipe& p : r.m_pipes) {
-			if (p.m_attacks.front().fileName.StartsWith(refStr, &rest)) {
-				p.m_attacks.front().fileName = wxT("DUMMY");
-				p.m_attacks.front().fullPath = wxT("DUMMY");
+			if (p.m_attacks.front().getFileName().StartsWith(refStr, &rest)) {
+				p.m_attacks.front().setFullPath(wxT("DUMMY"));
 			}
 		}
 	}
@@ -755,6 +769,114 @@ wxString Organ::getOdfRoot() {
 
 void Organ::setOdfRoot(wxString root) {
 	m_odfRoot = root;
+	SamplePath::setBasePath(m_odfRoot);
+}
+
+OdfPathResolver* Organ::getPathResolver() {
+	return m_pathResolver;
+}
+
+void Organ::setPathResolver(OdfPathResolver *resolver) {
+	m_pathResolver = resolver;
+}
+
+void Organ::setUnreadPipesSource(const OdfReader &reader, OdfPathResolver *resolver) {
+	releaseUnreadPipesSource();
+	m_unreadPipesReader = new OdfReader(reader);
+	m_unreadPipesResolver = resolver;
+	m_unreadPipesRoot = m_odfRoot;
+}
+
+bool Organ::hasUnreadPipes() {
+	return m_unreadPipesReader != NULL;
+}
+
+void Organ::readUnreadPipes(Rank *rank) {
+	if (!m_unreadPipesReader || !rank->hasUnreadPipes())
+		return;
+
+	OdfPathResolver *previousResolver = m_pathResolver;
+	m_pathResolver = m_unreadPipesResolver;
+	OdfReader reader(*m_unreadPipesReader);
+	rank->readUnreadPipes(&reader);
+	m_pathResolver = previousResolver;
+}
+
+bool Organ::readAllUnreadPipes(BackgroundTask *task) {
+	if (!m_unreadPipesReader)
+		return true;
+
+	// the pipes only read from the organ, so the pipes of every rank can be
+	// read by a thread of its own and the biggest ranks are started first so
+	// no thread is left with one at the end
+	std::vector<Rank*> ranks = getRanksWithUnreadPipes();
+	std::stable_sort(ranks.begin(), ranks.end(), [](Rank *a, Rank *b) {
+		return a->getNumberOfLogicalPipes() > b->getNumberOfLogicalPipes();
+	});
+
+	if (task)
+		task->beginStage(wxT("Ranks and stops with pipes parsed"), ranks.size());
+	OdfPathResolver *previousResolver = m_pathResolver;
+	m_pathResolver = m_unreadPipesResolver;
+	::wxGetApp().m_workerPool->parallelFor(ranks.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+		OdfReader reader(*m_unreadPipesReader);
+		ranks[i]->readUnreadPipes(&reader);
+		if (task) {
+			unsigned nbrFiles = 0;
+			for (const Pipe& pipe : ranks[i]->m_pipes) {
+				for (const Attack& atk : pipe.m_attacks) {
+					if (!atk.isDummy() && !atk.isReference())
+						nbrFiles++;
+				}
+				nbrFiles += pipe.m_releases.size();
+			}
+			task->addItemsFound(nbrFiles);
+			task->stepDone();
+		}
+	});
+	m_pathResolver = previousResolver;
+
+	if (task && task->isCancelled())
+		return false;
+	releaseUnreadPipesSource();
+	return true;
+}
+
+void Organ::readPipesBeforeRenumbering() {
+	// unread pipes are written just as they were read, and they refer to the
+	// windchests and to the stops of the manuals by their numbers then
+	if (!getRanksWithUnreadPipes().empty())
+		readAllUnreadPipes();
+}
+
+void Organ::addCaseFoldedPaths(unsigned nbrPaths) {
+	m_caseFoldedPaths += nbrPaths;
+}
+
+unsigned Organ::takeNewCaseFoldedPaths() {
+	unsigned total = m_caseFoldedPaths;
+	if (m_unreadPipesResolver)
+		total += m_unreadPipesResolver->getNumberOfCaseFoldedPaths();
+	unsigned newPaths = total - m_reportedCaseFoldedPaths;
+	m_reportedCaseFoldedPaths = total;
+	return newPaths;
+}
+
+bool Organ::canCopyUnreadPipes() {
+	// the sample paths of the pipes are relative to where the ODF was read from
+	return m_unreadPipesReader && m_odfRoot == m_unreadPipesRoot;
+}
+
+bool Organ::getUnreadPipeLines(const wxString &section, wxArrayString &lines) {
+	if (!canCopyUnreadPipes())
+		return false;
+
+	OdfReader reader(*m_unreadPipesReader);
+	reader.SetPath(section);
+	reader.ReadLines("Pipe", lines);
+	return true;
 }
 
 void Organ::removeReferenceToRankInStops(Rank *rank) {
@@ -793,11 +915,12 @@ unsigned Organ::getIndexOfOrganManual(Manual *manual) {
 }
 
 void Organ::addManual(Manual manual) {
-	m_Manuals.push_back(manual);
+	m_Manuals.push_back(std::move(manual));
 	updateOrganElements();
 }
 
 void Organ::removeManualAt(unsigned index) {
+	readPipesBeforeRenumbering();
 	std::list<Manual>::iterator it = m_Manuals.begin();
 	std::advance(it, index);
 	// remove the manual from any divisional coupler too
@@ -1177,6 +1300,30 @@ void Organ::removePanel(GoPanel *panel) {
 	}
 }
 
+std::vector<Rank*> Organ::getRanksWithUnreadPipes() {
+	std::vector<Rank*> ranks;
+	for (Rank& r : m_Ranks) {
+		if (r.hasUnreadPipes())
+			ranks.push_back(&r);
+	}
+	for (Stop& s : m_Stops) {
+		if (s.isUsingInternalRank() && s.getInternalRank()->hasUnreadPipes())
+			ranks.push_back(s.getInternalRank());
+	}
+	return ranks;
+}
+
+void Organ::releaseUnreadPipesSource() {
+	delete m_unreadPipesReader;
+	m_unreadPipesReader = NULL;
+	// what the resolver found is still to be reported
+	if (m_unreadPipesResolver)
+		m_caseFoldedPaths += m_unreadPipesResolver->getNumberOfCaseFoldedPaths();
+	delete m_unreadPipesResolver;
+	m_unreadPipesResolver = NULL;
+	m_unreadPipesRoot = wxEmptyString;
+}
+
 void Organ::populateSetterElements() {
 	if (m_setterElements.IsEmpty()) {
 		m_setterElements.Add(wxT("CrescendoA"));
@@ -1243,7 +1390,27 @@ void Organ::populateSetterElements() {
 	}
 }
 
+void Organ::beginBatchUpdate() {
+	m_batchUpdateDepth++;
+}
+
+void Organ::endBatchUpdate() {
+	if (m_batchUpdateDepth == 0)
+		return;
+
+	m_batchUpdateDepth--;
+	if (m_batchUpdateDepth == 0 && m_organElementsOutdated)
+		updateOrganElements();
+}
+
 void Organ::updateOrganElements() {
+	// during a batch update the elements are only updated once when it ends
+	if (m_batchUpdateDepth > 0) {
+		m_organElementsOutdated = true;
+		return;
+	}
+	m_organElementsOutdated = false;
+
 	if (!m_organElements.IsEmpty())
 		m_organElements.Empty();
 
@@ -1252,52 +1419,52 @@ void Organ::updateOrganElements() {
 	// just using the index
 
 	// Manuals first
-	for (Manual m : m_Manuals) {
+	for (Manual& m : m_Manuals) {
 		m_organElements.Add(m.getName() + wxT(" (Manual)"));
 	}
 
 	// Stops
-	for (Stop s : m_Stops) {
+	for (Stop& s : m_Stops) {
 		m_organElements.Add(s.getName() + wxT(" (Stop in ") + s.getOwningManual()->getName() + wxT(")"));
 	}
 
 	// Couplers
-	for (Coupler c : m_Couplers) {
+	for (Coupler& c : m_Couplers) {
 		m_organElements.Add(c.getName() + wxT(" (Coupler for ") + c.getOwningManual()->getName() + wxT(")"));
 	}
 
 	// Divisionals
-	for (Divisional d : m_Divisionals) {
+	for (Divisional& d : m_Divisionals) {
 		m_organElements.Add(d.getName() + wxT(" (Divisional in ") + d.getOwningManual()->getName() + wxT(")"));
 	}
 
 	// Enclosures
-	for (Enclosure e : m_Enclosures) {
+	for (Enclosure& e : m_Enclosures) {
 		m_organElements.Add(e.getName() + wxT(" (Enclosure)"));
 	}
 
 	// Tremulants
-	for (Tremulant t : m_Tremulants) {
+	for (Tremulant& t : m_Tremulants) {
 		m_organElements.Add(t.getName() + wxT(" (Tremulant)"));
 	}
 
 	// Switches
-	for (GoSwitch sw : m_Switches) {
+	for (GoSwitch& sw : m_Switches) {
 		m_organElements.Add(sw.getName() + wxT(" (Switch)"));
 	}
 
 	// Reversible pistons
-	for (ReversiblePiston p : m_ReversiblePistons) {
+	for (ReversiblePiston& p : m_ReversiblePistons) {
 		m_organElements.Add(p.getName() + wxT(" (Reversible piston)"));
 	}
 
 	// Divisional couplers
-	for (DivisionalCoupler divC : m_DivisionalCouplers) {
+	for (DivisionalCoupler& divC : m_DivisionalCouplers) {
 		m_organElements.Add(divC.getName() + wxT(" (Divisional coupler)"));
 	}
 
 	// Generals
-	for (General g : m_Generals) {
+	for (General& g : m_Generals) {
 		m_organElements.Add(g.getName() + wxT(" (General)"));
 	}
 
@@ -1386,12 +1553,3 @@ const wxArrayString& Organ::getOrganElements() const {
 void Organ::organElementHasChanged() {
 	updateOrganElements();
 }
-
-void Organ::updateRelativePipePaths() {
-	for (Stop& s : m_Stops) {
-		s.getInternalRank()->updatePipeRelativePaths();
-	}
-	for (Rank& r : m_Ranks) {
-		r.updatePipeRelativePaths();
-	}
-}
@@ -24,6 +24,7 @@
 #include <wx/wx.h>
 #include <wx/textfile.h>
 #include <list>
+#include <vector>
 #include "Enclosure.h"
 #include "Tremulant.h"
 #include "Windchestgroup.h"
@@ -38,6 +39,8 @@
 #include "ReversiblePiston.h"
 #include "GoPanel.h"
 
+class OdfPathResolver;
+
 class Organ {
 public:
 	Organ();
@@ -115,6 +118,27 @@ public:
 	void removeStop(Stop *stop);
 	wxString getOdfRoot();
 	void setOdfRoot(wxString root);
+	// the paths of an ODF are looked up through the resolver while it's read, otherwise it's NULL
+	OdfPathResolver* getPathResolver();
+	void setPathResolver(OdfPathResolver *resolver);
+	// An opened ODF can leave the pipes of its ranks unread until they are
+	// needed. The organ then keeps the reader and takes over the resolver for
+	// the paths, which stay relative to where the ODF was read from.
+	void setUnreadPipesSource(const OdfReader &reader, OdfPathResolver *resolver);
+	bool hasUnreadPipes();
+	void readUnreadPipes(Rank *rank);
+	// false if cancelled, the source is released once every pipe is read
+	bool readAllUnreadPipes(BackgroundTask *task = NULL);
+	// the unread pipes can only be written as they are to the folder the ODF was read from
+	bool canCopyUnreadPipes();
+	// must be called before windchests, manuals or stops get other numbers
+	void readPipesBeforeRenumbering();
+	// paths of the ODF that only matched files on disk by ignoring case, also
+	// those of pipes read on demand, the count is taken since it was last taken
+	void addCaseFoldedPaths(unsigned nbrPaths);
+	unsigned takeNewCaseFoldedPaths();
+	// the pipe lines of the section as they were read, false if they can't be written as they are
+	bool getUnreadPipeLines(const wxString &section, wxArrayString &lines);
 	void removeReferenceToRankInStops(Rank *rank);
 	Manual* getOrganManualAt(unsigned index);
 	unsigned getNumberOfManuals();
@@ -162,10 +186,20 @@ public:
 	const wxArrayString& getOrganElements() const;
 	std::pair<wxString, int> getTypeAndIndexOfElement(int index);
 	void organElementHasChanged();
-	void updateRelativePipePaths();
+
+	// several elements can be added between these calls while the organ
+	// elements (and panel trees) are only updated once at the end
+	void beginBatchUpdate();
+	void endBatchUpdate();
 
 private:
 	wxString m_odfRoot;
+	OdfPathResolver *m_pathResolver;
+	OdfReader *m_unreadPipesReader;
+	OdfPathResolver *m_unreadPipesResolver;
+	wxString m_unreadPipesRoot;
+	unsigned m_caseFoldedPaths;
+	unsigned m_reportedCaseFoldedPaths;
 	// Organ properties
 	wxString m_churchName;
 	wxString m_churchAddress;
@@ -202,7 +236,11 @@ private:
 	std::list<ReversiblePiston> m_ReversiblePistons;
 	std::list<GoPanel> m_Panels;
 	wxArrayString m_organElements;
+	unsigned m_batchUpdateDepth;
+	bool m_organElementsOutdated;
 
+	std::vector<Rank*> getRanksWithUnreadPipes();
+	void releaseUnreadPipesSource();
 	void populateSetterElements();
 	void updateOrganElements();
 
@@ -0,0 +1,172 @@
+/*
+ * OrganBuilder.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "OrganBuilder.h"
+#include <algorithm>
+
+OrganDivision::OrganDivision() {
+	name = wxEmptyString;
+	isPedal = false;
+}
+
+OrganBuilder::OrganBuilder(RankBatchImporter &importer) {
+	m_numberOfRanks = importer.getNumberOfImportedRanks();
+
+	wxString root = importer.getSampleSetRoot();
+	wxString rootName = root.AfterLast(wxFILE_SEP_PATH);
+	for (unsigned i = 0; i < m_numberOfRanks; i++) {
+		Rank *rank = importer.getImportedRankAt(i);
+
+		// the ranks come sorted by path so the divisions get sorted by name too
+		wxString relativePath;
+		wxString divisionName = rootName;
+		if (rank->getPipesRootPath().StartsWith(root + wxFILE_SEP_PATH, &relativePath) && relativePath.Find(wxFILE_SEP_PATH) != wxNOT_FOUND)
+			divisionName = relativePath.BeforeFirst(wxFILE_SEP_PATH);
+
+		OrganDivision &division = getDivision(divisionName);
+		division.rankNames.Add(rank->getName());
+		division.ranks.push_back(rank);
+	}
+
+	// a pedal division is placed first as that's where the pedal must be
+	std::stable_sort(m_divisions.begin(), m_divisions.end(), [](const OrganDivision &a, const OrganDivision &b) {
+		return a.isPedal && !b.isPedal;
+	});
+	bool pedalFound = false;
+	for (OrganDivision& division : m_divisions) {
+		if (pedalFound)
+			division.isPedal = false;
+		else if (division.isPedal)
+			pedalFound = true;
+	}
+}
+
+OrganBuilder::~OrganBuilder() {
+
+}
+
+unsigned OrganBuilder::getNumberOfDivisions() {
+	return m_divisions.size();
+}
+
+const OrganDivision& OrganBuilder::getDivisionAt(unsigned index) {
+	return m_divisions[index];
+}
+
+bool OrganBuilder::canBeAddedTo(Organ *organ, wxString &errorMessage) {
+	// nothing is added unless everything fits
+	if (organ->getNumberOfManuals() + m_divisions.size() > 16) {
+		errorMessage = wxString::Format(wxT("The %u divisions found would give the organ more than 16 manuals!"), (unsigned) m_divisions.size());
+		return false;
+	}
+	if (organ->getNumberOfWindchestgroups() + m_divisions.size() > 50) {
+		errorMessage = wxString::Format(wxT("The %u divisions found would give the organ more than 50 windchests!"), (unsigned) m_divisions.size());
+		return false;
+	}
+	if (organ->getNumberOfRanks() + m_numberOfRanks > 999 || organ->getNumberOfStops() + m_numberOfRanks > 999) {
+		errorMessage = wxString::Format(wxT("The %u ranks found would give the organ more than 999 ranks or stops!"), m_numberOfRanks);
+		return false;
+	}
+
+	return true;
+}
+
+void OrganBuilder::addToOrgan(Organ *organ) {
+	// a pedal can only be made of the first manual
+	bool canHavePedal = organ->getNumberOfManuals() == 0;
+
+	organ->beginBatchUpdate();
+	for (OrganDivision& division : m_divisions) {
+		Windchestgroup windchest;
+		windchest.setName(division.name);
+		organ->addWindchestgroup(windchest);
+		Windchestgroup *organWindchest = organ->getOrganWindchestgroupAt(organ->getNumberOfWindchestgroups() - 1);
+
+		Manual manual;
+		manual.setName(division.name);
+		if (division.isPedal && canHavePedal) {
+			manual.setNumberOfLogicalKeys(32);
+			manual.setNumberOfAccessibleKeys(32);
+			manual.setIsPedal(true);
+			organ->setHasPedals(true);
+		}
+		organ->addManual(std::move(manual));
+		Manual *organManual = organ->getOrganManualAt(organ->getNumberOfManuals() - 1);
+
+		for (Rank *rank : division.ranks) {
+			rank->setWindchest(organWindchest);
+			organ->addRank(std::move(*rank));
+			Rank *organRank = organ->getOrganRankAt(organ->getNumberOfRanks() - 1);
+			if (addStopForRank(organ, organManual, organRank))
+				division.stopNames.Add(organRank->getName());
+			else
+				m_ranksWithoutStop.Add(organRank->getName() + wxT(" (") + division.name + wxT(")"));
+		}
+		division.ranks.clear();
+	}
+	organ->endBatchUpdate();
+}
+
+const wxArrayString& OrganBuilder::getRanksWithoutStop() {
+	return m_ranksWithoutStop;
+}
+
+OrganDivision& OrganBuilder::getDivision(wxString name) {
+	for (OrganDivision& division : m_divisions) {
+		if (division.name == name)
+			return division;
+	}
+
+	OrganDivision division;
+	division.name = name;
+	division.isPedal = name.Lower().Find(wxT("ped")) != wxNOT_FOUND;
+	m_divisions.push_back(division);
+	return m_divisions.back();
+}
+
+bool OrganBuilder::addStopForRank(Organ *organ, Manual *manual, Rank *rank) {
+	// the rank is placed on the keys that match its midi notes
+	int firstKey = 1;
+	int firstPipe = 1;
+	int firstManualNote = manual->getFirstAccessibleKeyMIDINoteNumber();
+	if (rank->getFirstMidiNoteNumber() >= firstManualNote)
+		firstKey = rank->getFirstMidiNoteNumber() - firstManualNote + 1;
+	else
+		firstPipe = firstManualNote - rank->getFirstMidiNoteNumber() + 1;
+
+	// a rank entirely above or below the keys of the manual gets no stop
+	int pipeCount = std::min(rank->getNumberOfLogicalPipes() - firstPipe + 1, manual->getNumberOfLogicalKeys() - firstKey + 1);
+	if (pipeCount < 1)
+		return false;
+
+	Stop stop;
+	stop.setName(rank->getName());
+	stop.setOwningManual(manual);
+	stop.setUsingInternalRank(false);
+	stop.setFirstPipeLogicalKeyNbr(firstKey);
+	stop.setNumberOfAccessiblePipes(pipeCount);
+	stop.addRankReference(rank);
+	stop.getRankReferenceAt(0)->m_firstPipeNumber = firstPipe;
+	stop.getRankReferenceAt(0)->m_pipeCount = pipeCount;
+
+	organ->addStop(std::move(stop));
+	manual->addStop(organ->getOrganStopAt(organ->getNumberOfStops() - 1));
+	return true;
+}
@@ -0,0 +1,69 @@
+/*
+ * OrganBuilder.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef ORGANBUILDER_H
+#define ORGANBUILDER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "RankBatchImporter.h"
+#include "Organ.h"
+
+// A division of the organ as found in the folders of a sample set
+class OrganDivision {
+public:
+	OrganDivision();
+
+	wxString name;
+	bool isPedal;
+	wxArrayString rankNames;
+	// the ranks that got a stop, those out of the range of the manual don't
+	wxArrayString stopNames;
+	std::vector<Rank*> ranks;
+};
+
+// Builds the windchests, manuals, ranks and stops of a whole organ from the
+// ranks that a RankBatchImporter found. The first folder level below the
+// sample set root is taken as the divisions, each getting a manual and a
+// windchest of its own, and every rank gets a stop in the manual of its
+// division. Ranks directly in the root end up in a division named after it.
+class OrganBuilder {
+public:
+	OrganBuilder(RankBatchImporter &importer);
+	~OrganBuilder();
+
+	unsigned getNumberOfDivisions();
+	const OrganDivision& getDivisionAt(unsigned index);
+	bool canBeAddedTo(Organ *organ, wxString &errorMessage);
+	// adds everything at once, the ranks are moved out of the importer
+	void addToOrgan(Organ *organ);
+	// the ranks that no key of their manual could play, after addToOrgan
+	const wxArrayString& getRanksWithoutStop();
+
+private:
+	std::vector<OrganDivision> m_divisions;
+	unsigned m_numberOfRanks;
+	wxArrayString m_ranksWithoutStop;
+
+	OrganDivision& getDivision(wxString name);
+	bool addStopForRank(Organ *organ, Manual *manual, Rank *rank);
+};
+
+#endif
@@ -22,12 +22,15 @@
 #include <wx/filename.h>
 #include <wx/image.h>
 #include "GOODFFunctions.h"
+#include "OdfPathResolver.h"
 #include "GUITremulant.h"
 #include "GUISwitch.h"
 #include "GUIReversiblePiston.h"
 #include "GUIDivisionalCoupler.h"
 #include "GUIGeneral.h"
 #include "GUIDivisional.h"
+#include "GUIStop.h"
+#include "GUICoupler.h"
 
 OrganFileParser::OrganFileParser(wxString filePath, Organ *organ) {
 	m_filePath = filePath;
@@ -36,28 +39,71 @@ OrganFileParser::OrganFileParser(wxString filePath, Organ *organ) {
 	m_organIsReady = false;
 	m_isUsingOldPanelFormat = false;
 	m_errorMessage = wxEmptyString;
+	m_task = NULL;
+	m_ignoreCase = false;
+	m_readPipesOnDemand = true;
+	m_pipesOnDemandLines = DEFAULT_PIPES_READ_ON_DEMAND_LINES;
+}
+
+OrganFileParser::~OrganFileParser() {
+
+}
+
+bool OrganFileParser::parse(BackgroundTask *task) {
+	m_task = task;
+	m_organIsReady = false;
 
 	readIniFile();
 	if (m_fileIsOk)
 		parseOrgan();
-}
-
-OrganFileParser::~OrganFileParser() {
 
+	m_task = NULL;
+	return m_organIsReady;
 }
 
 void OrganFileParser::parseOrgan() {
 	wxFileName odf = wxFileName(m_filePath);
 	m_organ->setOdfRoot(odf.GetPath());
+
+	// every folder with samples or images is only listed once, also when the
+	// pipes are read later on, so the organ gets to keep the resolver
+	OdfPathResolver *pathResolver = new OdfPathResolver(odf.GetPath(), m_ignoreCase);
+	m_organ->setUnreadPipesSource(m_organFile, pathResolver);
+	m_organ->setPathResolver(pathResolver);
+	m_organ->beginBatchUpdate();
 	parseOrganSection();
+	m_organ->setPathResolver(NULL);
+	// the pipes of a huge ODF are only read when they are needed
+	if (!isCancelled() && (!m_readPipesOnDemand || m_organFile.getNumberOfLines() <= m_pipesOnDemandLines))
+		m_organ->readAllUnreadPipes(m_task);
+	m_organ->endBatchUpdate();
+	if (!isCancelled())
+		m_organIsReady = true;
 }
 
 bool OrganFileParser::isOrganReady() {
 	return m_organIsReady;
 }
 
+wxString OrganFileParser::getErrorMessage() {
+	return m_errorMessage;
+}
+
+void OrganFileParser::setIgnoreCase(bool ignoreCase) {
+	m_ignoreCase = ignoreCase;
+}
+
+void OrganFileParser::setPipesReadOnDemand(bool onDemand, unsigned minimumLines) {
+	m_readPipesOnDemand = onDemand;
+	m_pipesOnDemandLines = minimumLines;
+}
+
 void OrganFileParser::readIniFile() {
-	m_organFile = wxFileConfig(wxEmptyString, wxEmptyString, m_filePath);
+	if (!m_organFile.readFile(m_filePath)) {
+		m_fileIsOk = false;
+		m_errorMessage = m_organFile.getErrorMessage();
+		return;
+	}
 	if (m_organFile.HasGroup(wxT("Organ")))
 		m_fileIsOk = true;
 	else {
@@ -115,27 +161,6 @@ void OrganFileParser::parseOrganSection() {
 	m_organ->setHasPedals(GOODF_functions::parseBoolean(cfgBoolValue, false));
 
 	if (m_isUsingOldPanelFormat) {
-		// the display metrics must be read from the organ section into Panel000
-		m_organ->getOrganPanelAt(0)->getDisplayMetrics()->read(&m_organFile);
-
-		// images can also exist that must be transferred to the main panel
-		int nbrImages = static_cast<int>(m_organFile.ReadLong("NumberOfImages", 0));
-		if (nbrImages > 0 && nbrImages < 1000) {
-			for (int i = 0; i < nbrImages; i++) {
-				wxString imgGroupName = wxT("Image") + GOODF_functions::number_format(i + 1);
-				if (m_organFile.HasGroup(imgGroupName)) {
-					m_organFile.SetPath(wxT("/") + imgGroupName);
-					GoImage img;
-					img.setOwningPanelWidth(m_organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue());
-					img.setOwningPanelHeight(m_organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
-					bool imgIsOk = img.read(&m_organFile);
-					if (imgIsOk)
-						m_organ->getOrganPanelAt(0)->addImage(img);
-				}
-			}
-			m_organFile.SetPath("/Organ");
-		}
-
 		// labels can exist that also should be re created as GUI elements
 		int nbrLabels = static_cast<int>(m_organFile.ReadLong("NumberOfLabels", 0));
 		if (nbrLabels > 0 && nbrLabels < 1000) {
@@ -143,7 +168,9 @@ void OrganFileParser::parseOrganSection() {
 				wxString labelGroupName = wxT("Label") + GOODF_functions::number_format(i + 1);
 				if (m_organFile.HasGroup(labelGroupName)) {
 					m_organFile.SetPath(wxT("/") + labelGroupName);
-					createGUILabel(m_organ->getOrganPanelAt(0));
+					createGuiElementLater([this]() {
+						createGUILabel(m_organ->getOrganPanelAt(0));
+					});
 				}
 			}
 			m_organFile.SetPath("/Organ");
@@ -153,7 +180,10 @@ void OrganFileParser::parseOrganSection() {
 	// parse enclosures
 	int nbrEnclosures = static_cast<int>(m_organFile.ReadLong("NumberOfEnclosures", 0));
 	if (nbrEnclosures > 0 && nbrEnclosures < 51) {
+		beginStage(wxT("Enclosures parsed"), nbrEnclosures);
 		for (int i = 0; i < nbrEnclosures; i++) {
+			if (isCancelled())
+				return;
 			wxString enclosureGroupName = wxT("Enclosure") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(enclosureGroupName)) {
 				m_organFile.SetPath(wxT("/") + enclosureGroupName);
@@ -161,11 +191,14 @@ void OrganFileParser::parseOrganSection() {
 				enc.read(&m_organFile, m_isUsingOldPanelFormat);
 				m_organ->addEnclosure(enc);
 				if (enc.isDisplayed()) {
-					int lastEnclosureIdx = m_organ->getNumberOfEnclosures() - 1;
-					createGUIEnclosure(m_organ->getOrganPanelAt(0), m_organ->getOrganEnclosureAt(lastEnclosureIdx));
+					Enclosure *enclosure = m_organ->getOrganEnclosureAt(m_organ->getNumberOfEnclosures() - 1);
+					createGuiElementLater([this, enclosure]() {
+						createGUIEnclosure(m_organ->getOrganPanelAt(0), enclosure);
+					});
 				}
 
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -173,7 +206,10 @@ void OrganFileParser::parseOrganSection() {
 	// parse switches
 	int nbrSwitches = static_cast<int>(m_organFile.ReadLong("NumberOfSwitches", 0));
 	if (nbrSwitches > 0 && nbrSwitches < 1000) {
+		beginStage(wxT("Switches parsed"), nbrSwitches);
 		for (int i = 0; i < nbrSwitches; i++) {
+			if (isCancelled())
+				return;
 			wxString switchGroupName = wxT("Switch") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(switchGroupName)) {
 				m_organFile.SetPath(wxT("/") + switchGroupName);
@@ -181,10 +217,13 @@ void OrganFileParser::parseOrganSection() {
 				sw.read(&m_organFile, m_isUsingOldPanelFormat);
 				m_organ->addSwitch(sw);
 				if (sw.isDisplayed()) {
-					int lastSwitchIdx = m_organ->getNumberOfSwitches() - 1;
-					createGUISwitch(m_organ->getOrganPanelAt(0), m_organ->getOrganSwitchAt(lastSwitchIdx));
+					GoSwitch *theSwitch = m_organ->getOrganSwitchAt(m_organ->getNumberOfSwitches() - 1);
+					createGuiElementLater([this, theSwitch]() {
+						createGUISwitch(m_organ->getOrganPanelAt(0), theSwitch);
+					});
 				}
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -192,7 +231,10 @@ void OrganFileParser::parseOrganSection() {
 	// parse tremulants
 	int nbrTrems = static_cast<int>(m_organFile.ReadLong("NumberOfTremulants", 0));
 	if (nbrTrems > 0 && nbrTrems < 11) {
+		beginStage(wxT("Tremulants parsed"), nbrTrems);
 		for (int i = 0; i < nbrTrems; i++) {
+			if (isCancelled())
+				return;
 			wxString tremGroupName = wxT("Tremulant") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(tremGroupName)) {
 				m_organFile.SetPath(wxT("/") + tremGroupName);
@@ -200,10 +242,13 @@ void OrganFileParser::parseOrganSection() {
 				trem.read(&m_organFile, m_isUsingOldPanelFormat);
 				m_organ->addTremulant(trem);
 				if (trem.isDisplayed()) {
-					int lastTremIdx = m_organ->getNumberOfTremulants() - 1;
-					createGUITremulant(m_organ->getOrganPanelAt(0), m_organ->getOrganTremulantAt(lastTremIdx));
+					Tremulant *tremulant = m_organ->getOrganTremulantAt(m_organ->getNumberOfTremulants() - 1);
+					createGuiElementLater([this, tremulant]() {
+						createGUITremulant(m_organ->getOrganPanelAt(0), tremulant);
+					});
 				}
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -211,7 +256,10 @@ void OrganFileParser::parseOrganSection() {
 	// parse windchests
 	int nbrWindchests = static_cast<int>(m_organFile.ReadLong("NumberOfWindchestGroups", 0));
 	if (nbrWindchests > 0 && nbrWindchests < 51) {
+		beginStage(wxT("Windchests parsed"), nbrWindchests);
 		for (int i = 0; i < nbrWindchests; i++) {
+			if (isCancelled())
+				return;
 			wxString windchestGroupName = wxT("WindchestGroup") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(windchestGroupName)) {
 				m_organFile.SetPath(wxT("/") + windchestGroupName);
@@ -219,6 +267,7 @@ void OrganFileParser::parseOrganSection() {
 				windchest.read(&m_organFile);
 				m_organ->addWindchestgroup(windchest);
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -226,14 +275,19 @@ void OrganFileParser::parseOrganSection() {
 	// parse ranks
 	int nbrRanks = static_cast<int>(m_organFile.ReadLong("NumberOfRanks", 0));
 	if (nbrRanks > 0 && nbrRanks < 1000) {
+		beginStage(wxT("Ranks parsed"), nbrRanks);
 		for (int i = 0; i < nbrRanks; i++) {
+			if (isCancelled())
+				return;
 			wxString rankGroupName = wxT("Rank") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(rankGroupName)) {
 				m_organFile.SetPath(wxT("/") + rankGroupName);
+				// the pipes are read later by the organ
 				Rank r;
-				r.read(&m_organFile);
-				m_organ->addRank(r);
+				r.read(&m_organFile, false);
+				m_organ->addRank(std::move(r));
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -244,7 +298,10 @@ void OrganFileParser::parseOrganSection() {
 	if (nbrManuals > 0 && nbrManuals < 17) {
 		if (m_organ->doesHavePedals())
 			nbrManuals += 1;
+		beginStage(wxT("Manuals and stops parsed"), nbrManuals);
 		for (int i = 0; i < nbrManuals; i++) {
+			if (isCancelled())
+				return;
 			int manIdxNbr = i;
 			if (!m_organ->doesHavePedals())
 				manIdxNbr += 1;
@@ -254,13 +311,29 @@ void OrganFileParser::parseOrganSection() {
 				Manual m;
 				if (manIdxNbr == 0)
 					m.setIsPedal(true);
-				m.read(&m_organFile, m_isUsingOldPanelFormat);
+				// the stops are added to the organ as the manual is read while
+				// the pipes of their internal ranks are read later by the organ
+				m.read(&m_organFile, m_isUsingOldPanelFormat, false);
 				m_organ->addManual(m);
-				if (m.isDisplayed()) {
-					int lastManIdx = m_organ->getNumberOfManuals() - 1;
-					createGUIManual(m_organ->getOrganPanelAt(0), m_organ->getOrganManualAt(lastManIdx));
+				Manual *organManual = m_organ->getOrganManualAt(m_organ->getNumberOfManuals() - 1);
+
+				// what was read now belongs to the copy of the manual in the organ
+				for (unsigned j = 0; j < organManual->getNumberOfStops(); j++)
+					organManual->getStopAt(j)->setOwningManual(organManual);
+				for (unsigned j = 0; j < organManual->getNumberOfCouplers(); j++)
+					organManual->getCouplerAt(j)->setOwningManual(organManual);
+				for (unsigned j = 0; j < organManual->getNumberOfDivisionals(); j++)
+					organManual->getDivisionalAt(j)->setOwningManual(organManual);
+
+				if (organManual->isDisplayed()) {
+					// reading the stops and couplers moved the path away from the manual
+					m_organFile.SetPath(wxT("/") + manGroupName);
+					createGuiElementLater([this, organManual]() {
+						createGUIManual(m_organ->getOrganPanelAt(0), organManual);
+					});
 				}
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -268,7 +341,10 @@ void OrganFileParser::parseOrganSection() {
 	// parse reversible pistons
 	int nbrPistons = static_cast<int>(m_organFile.ReadLong("NumberOfReversiblePistons", 0));
 	if (nbrPistons > 0 && nbrPistons < 33) {
+		beginStage(wxT("Reversible pistons parsed"), nbrPistons);
 		for (int i = 0; i < nbrPistons; i++) {
+			if (isCancelled())
+				return;
 			wxString pistonGroupName = wxT("ReversiblePiston") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(pistonGroupName)) {
 				m_organFile.SetPath(wxT("/") + pistonGroupName);
@@ -276,10 +352,13 @@ void OrganFileParser::parseOrganSection() {
 				p.read(&m_organFile, m_isUsingOldPanelFormat);
 				m_organ->addReversiblePiston(p);
 				if (p.isDisplayed()) {
-					unsigned lastPistonIdx = m_organ->getNumberOfReversiblePistons() - 1;
-					createGUIPiston(m_organ->getOrganPanelAt(0), m_organ->getReversiblePistonAt(lastPistonIdx));
+					ReversiblePiston *piston = m_organ->getReversiblePistonAt(m_organ->getNumberOfReversiblePistons() - 1);
+					createGuiElementLater([this, piston]() {
+						createGUIPiston(m_organ->getOrganPanelAt(0), piston);
+					});
 				}
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -287,7 +366,10 @@ void OrganFileParser::parseOrganSection() {
 	// parse divisional couplers
 	int nbrDivCplrs = static_cast<int>(m_organFile.ReadLong("NumberOfDivisionalCouplers", 0));
 	if (nbrDivCplrs > 0 && nbrDivCplrs < 9) {
+		beginStage(wxT("Divisional couplers parsed"), nbrDivCplrs);
 		for (int i = 0; i < nbrDivCplrs; i++) {
+			if (isCancelled())
+				return;
 			wxString divCplrGroupName = wxT("DivisionalCoupler") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(divCplrGroupName)) {
 				m_organFile.SetPath(wxT("/") + divCplrGroupName);
@@ -295,10 +377,13 @@ void OrganFileParser::parseOrganSection() {
 				divCplr.read(&m_organFile, m_isUsingOldPanelFormat);
 				m_organ->addDivisionalCoupler(divCplr);
 				if (divCplr.isDisplayed()) {
-					unsigned lastIdx = m_organ->getNumberOfOrganDivisionalCouplers() - 1;
-					createGUIDivCplr(m_organ->getOrganPanelAt(0), m_organ->getOrganDivisionalCouplerAt(lastIdx));
+					DivisionalCoupler *divisionalCoupler = m_organ->getOrganDivisionalCouplerAt(m_organ->getNumberOfOrganDivisionalCouplers() - 1);
+					createGuiElementLater([this, divisionalCoupler]() {
+						createGUIDivCplr(m_organ->getOrganPanelAt(0), divisionalCoupler);
+					});
 				}
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -306,7 +391,10 @@ void OrganFileParser::parseOrganSection() {
 	// parse generals
 	int nbrGenerals = static_cast<int>(m_organFile.ReadLong("NumberOfGenerals", 0));
 	if (nbrGenerals > 0 && nbrGenerals < 100) {
+		beginStage(wxT("Generals parsed"), nbrGenerals);
 		for (int i = 0; i < nbrGenerals; i++) {
+			if (isCancelled())
+				return;
 			wxString generalGroupName = wxT("General") + GOODF_functions::number_format(i + 1);
 			if (m_organFile.HasGroup(generalGroupName)) {
 				m_organFile.SetPath(wxT("/") + generalGroupName);
@@ -314,10 +402,13 @@ void OrganFileParser::parseOrganSection() {
 				g.read(&m_organFile, m_isUsingOldPanelFormat);
 				m_organ->addGeneral(g);
 				if (g.isDisplayed()) {
-					unsigned lastIdx = m_organ->getNumberOfGenerals() - 1;
-					createGUIGeneral(m_organ->getOrganPanelAt(0), m_organ->getOrganGeneralAt(lastIdx));
+					General *general = m_organ->getOrganGeneralAt(m_organ->getNumberOfGenerals() - 1);
+					createGuiElementLater([this, general]() {
+						createGUIGeneral(m_organ->getOrganPanelAt(0), general);
+					});
 				}
 			}
+			stepDone();
 		}
 		m_organFile.SetPath("/Organ");
 	}
@@ -327,27 +418,218 @@ void OrganFileParser::parseOrganSection() {
 	if (m_isUsingOldPanelFormat) {
 		int nbrSetters = static_cast<int>(m_organFile.ReadLong("NumberOfSetterElements", 0));
 		if (nbrSetters > 0 && nbrSetters < 1000) {
+			beginStage(wxT("Setter elements parsed"), nbrSetters);
 			for (int i = 0; i < nbrSetters; i++) {
+				if (isCancelled())
+					return;
 				wxString setterGroupName = wxT("SetterElement") + GOODF_functions::number_format(i + 1);
 				if (m_organFile.HasGroup(setterGroupName)) {
 					m_organFile.SetPath(wxT("/") + setterGroupName);
 					wxString elementType = m_organFile.Read("Type", wxEmptyString);
 					if (elementType != wxEmptyString) {
-						createFromSetterElement(m_organ->getOrganPanelAt(0), elementType);
+						createGuiElementLater([this, elementType]() {
+							createFromSetterElement(m_organ->getOrganPanelAt(0), elementType);
+						});
 					}
 				}
+				stepDone();
 			}
 		}
 		m_organFile.SetPath("/Organ");
 	}
+}
+
+void OrganFileParser::createPanels() {
+	OdfPathResolver pathResolver(m_organ->getOdfRoot(), m_ignoreCase);
+	m_organ->setPathResolver(&pathResolver);
+	if (m_isUsingOldPanelFormat) {
+		m_organFile.SetPath("/Organ");
+		// the display metrics must be read from the organ section into Panel000
+		m_organ->getOrganPanelAt(0)->getDisplayMetrics()->read(&m_organFile);
+
+		// images can also exist that must be transferred to the main panel
+		int nbrImages = static_cast<int>(m_organFile.ReadLong("NumberOfImages", 0));
+		if (nbrImages > 0 && nbrImages < 1000) {
+			for (int i = 0; i < nbrImages; i++) {
+				wxString imgGroupName = wxT("Image") + GOODF_functions::number_format(i + 1);
+				if (m_organFile.HasGroup(imgGroupName)) {
+					m_organFile.SetPath(wxT("/") + imgGroupName);
+					GoImage img;
+					img.setOwningPanelWidth(m_organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue());
+					img.setOwningPanelHeight(m_organ->getOrganPanelAt(0)->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
+					bool imgIsOk = img.read(&m_organFile);
+					if (imgIsOk)
+						m_organ->getOrganPanelAt(0)->addImage(img);
+				}
+			}
+		}
+	}
+
+	// the elements are created in the order they were found in
+	for (std::function<void()> &create : m_guiElementsToCreate)
+		create();
+	m_guiElementsToCreate.clear();
 
 	// parse panels that has images and gui elements but can also exist in old style version
+	m_organFile.SetPath("/Organ");
+	if (!m_isUsingOldPanelFormat)
+		parsePanels();
+	m_organFile.SetPath("/Organ");
+	m_organ->setPathResolver(NULL);
+	m_organ->addCaseFoldedPaths(pathResolver.getNumberOfCaseFoldedPaths());
+}
+
+void OrganFileParser::createGuiElementLater(std::function<void()> create) {
+	wxString section = m_organFile.GetPath();
+	m_guiElementsToCreate.push_back([this, section, create]() {
+		m_organFile.SetPath(section);
+		create();
+	});
+}
+
+void OrganFileParser::parsePanels() {
+	int nbrPanels = static_cast<int>(m_organFile.ReadLong("NumberOfPanels", 0));
+	if (nbrPanels < 0 || nbrPanels > 999)
+		nbrPanels = 0;
+
+	// Panel000 is the main panel that the organ already has
+	beginStage(wxT("Panels parsed"), nbrPanels + 1);
+	for (int i = 0; i <= nbrPanels; i++) {
+		if (isCancelled())
+			return;
+		wxString panelGroupName = wxT("Panel") + GOODF_functions::number_format(i);
+		if (m_organFile.HasGroup(panelGroupName)) {
+			m_organFile.SetPath(wxT("/") + panelGroupName);
+			GoPanel *panel = m_organ->getOrganPanelAt(0);
+			if (i > 0) {
+				GoPanel p;
+				p.setName(m_organFile.Read("Name", wxT("New Panel")));
+				p.setGroup(m_organFile.Read("Group", wxEmptyString));
+				m_organ->addPanel(p);
+				panel = m_organ->getOrganPanelAt(m_organ->getNumberOfPanels() - 1);
+			}
+			wxString cfgBoolValue = m_organFile.Read("HasPedals", wxEmptyString);
+			panel->setHasPedals(GOODF_functions::parseBoolean(cfgBoolValue, false));
+			panel->getDisplayMetrics()->read(&m_organFile);
+
+			int nbrGuiElements = static_cast<int>(m_organFile.ReadLong("NumberOfGUIElements", 0));
+			int nbrImages = static_cast<int>(m_organFile.ReadLong("NumberOfImages", 0));
+			if (nbrImages > 0 && nbrImages < 1000) {
+				for (int j = 0; j < nbrImages; j++) {
+					wxString imgGroupName = panelGroupName + wxT("Image") + GOODF_functions::number_format(j + 1);
+					if (m_organFile.HasGroup(imgGroupName)) {
+						m_organFile.SetPath(wxT("/") + imgGroupName);
+						GoImage img;
+						img.setOwningPanelWidth(panel->getDisplayMetrics()->m_dispScreenSizeHoriz.getNumericalValue());
+						img.setOwningPanelHeight(panel->getDisplayMetrics()->m_dispScreenSizeVert.getNumericalValue());
+						if (img.read(&m_organFile))
+							panel->addImage(img);
+					}
+				}
+			}
+			if (nbrGuiElements > 0 && nbrGuiElements < 1000) {
+				for (int j = 0; j < nbrGuiElements; j++) {
+					wxString elementGroupName = panelGroupName + wxT("Element") + GOODF_functions::number_format(j + 1);
+					if (m_organFile.HasGroup(elementGroupName)) {
+						m_organFile.SetPath(wxT("/") + elementGroupName);
+						parsePanelElement(panel);
+					}
+				}
+			}
+		}
+		stepDone();
+	}
+	m_organFile.SetPath("/Organ");
+}
+
+void OrganFileParser::parsePanelElement(GoPanel *panel) {
+	// the element refers to what it shows by the numbers the ODF has for them
+	wxString type = m_organFile.Read("Type", wxEmptyString);
+	if (type == wxT("Enclosure")) {
+		int index = readReference("Enclosure", m_organ->getNumberOfEnclosures());
+		if (index > -1)
+			createGUIEnclosure(panel, m_organ->getOrganEnclosureAt(index));
+	} else if (type == wxT("Tremulant")) {
+		int index = readReference("Tremulant", m_organ->getNumberOfTremulants());
+		if (index > -1)
+			createGUITremulant(panel, m_organ->getOrganTremulantAt(index));
+	} else if (type == wxT("Switch")) {
+		int index = readReference("Switch", m_organ->getNumberOfSwitches());
+		if (index > -1)
+			createGUISwitch(panel, m_organ->getOrganSwitchAt(index));
+	} else if (type == wxT("ReversiblePiston")) {
+		int index = readReference("ReversiblePiston", m_organ->getNumberOfReversiblePistons());
+		if (index > -1)
+			createGUIPiston(panel, m_organ->getReversiblePistonAt(index));
+	} else if (type == wxT("DivisionalCoupler")) {
+		int index = readReference("DivisionalCoupler", m_organ->getNumberOfOrganDivisionalCouplers());
+		if (index > -1)
+			createGUIDivCplr(panel, m_organ->getOrganDivisionalCouplerAt(index));
+	} else if (type == wxT("General")) {
+		int index = readReference("General", m_organ->getNumberOfGenerals());
+		if (index > -1)
+			createGUIGeneral(panel, m_organ->getOrganGeneralAt(index));
+	} else if (type == wxT("Label")) {
+		createGUILabel(panel);
+	} else if (type == wxT("Manual") || type == wxT("Stop") || type == wxT("Coupler") || type == wxT("Divisional")) {
+		Manual *manual = readManualReference();
+		if (!manual)
+			return;
+		if (type == wxT("Manual")) {
+			createGUIManual(panel, manual);
+		} else if (type == wxT("Stop")) {
+			int index = readReference("Stop", manual->getNumberOfStops());
+			if (index > -1)
+				createGUIStop(panel, manual->getStopAt(index));
+		} else if (type == wxT("Coupler")) {
+			int index = readReference("Coupler", manual->getNumberOfCouplers());
+			if (index > -1)
+				createGUICoupler(panel, manual->getCouplerAt(index));
+		} else {
+			int index = readReference("Divisional", manual->getNumberOfDivisionals());
+			if (index > -1)
+				createGUIDivisional(panel, manual->getDivisionalAt(index));
+		}
+	} else if (type != wxEmptyString) {
+		createFromSetterElement(panel, type);
+	}
+}
+
+int OrganFileParser::readReference(const char *key, unsigned numberOfElements) {
+	long value = m_organFile.ReadLong(key, 0);
+	if (value < 1 || value > (long) numberOfElements)
+		return -1;
+	return (int) value - 1;
+}
+
+Manual* OrganFileParser::readManualReference() {
+	// the pedal is Manual000 when the organ has one
+	long value = m_organFile.ReadLong("Manual", -1);
+	long index = m_organ->doesHavePedals() ? value : value - 1;
+	if (value < 0 || index < 0 || index >= (long) m_organ->getNumberOfManuals())
+		return NULL;
+	return m_organ->getOrganManualAt(index);
+}
+
+void OrganFileParser::beginStage(wxString stepsLabel, int totalSteps) {
+	if (m_task)
+		m_task->beginStage(stepsLabel, totalSteps);
+}
+
+void OrganFileParser::stepDone() {
+	if (m_task)
+		m_task->stepDone();
+}
+
+bool OrganFileParser::isCancelled() {
+	return m_task && m_task->isCancelled();
 }
 
 void OrganFileParser::createGUIEnclosure(GoPanel *targetPanel, Enclosure *enclosure) {
 	GUIElement *guiEnc = new GUIEnclosure(enclosure);
 	guiEnc->setOwningPanel(targetPanel);
-	guiEnc->setDisplayName(enclosure->getName());
+	if (enclosure)
+		guiEnc->setDisplayName(enclosure->getName());
 	targetPanel->addGuiElement(guiEnc);
 
 	// convert gui element back to enclosure type for parsing
@@ -372,7 +654,8 @@ void OrganFileParser::createGUITremulant(GoPanel *targetPanel, Tremulant *tremul
 void OrganFileParser::createGUISwitch(GoPanel *targetPanel, GoSwitch *theSwitch) {
 	GUIElement *guiSwitch = new GUISwitch(theSwitch);
 	guiSwitch->setOwningPanel(targetPanel);
-	guiSwitch->setDisplayName(theSwitch->getName());
+	if (theSwitch)
+		guiSwitch->setDisplayName(theSwitch->getName());
 	targetPanel->addGuiElement(guiSwitch);
 
 	GUISwitch *switchElement = dynamic_cast<GUISwitch*>(guiSwitch);
@@ -393,6 +676,22 @@ void OrganFileParser::createGUILabel(GoPanel *targetPanel) {
 	}
 }
 
+void OrganFileParser::createGUIStop(GoPanel *targetPanel, Stop *stop) {
+	GUIStop *guiStop = new GUIStop(stop);
+	guiStop->setOwningPanel(targetPanel);
+	guiStop->setDisplayName(stop->getName());
+	targetPanel->addGuiElement(guiStop);
+	guiStop->read(&m_organFile, false);
+}
+
+void OrganFileParser::createGUICoupler(GoPanel *targetPanel, Coupler *coupler) {
+	GUICoupler *guiCoupler = new GUICoupler(coupler);
+	guiCoupler->setOwningPanel(targetPanel);
+	guiCoupler->setDisplayName(coupler->getName());
+	targetPanel->addGuiElement(guiCoupler);
+	guiCoupler->read(&m_organFile, false);
+}
+
 void OrganFileParser::createGUIManual(GoPanel *targetPanel, Manual *manual) {
 	GUIElement *man = new GUIManual(manual);
 	man->setOwningPanel(targetPanel);
@@ -432,7 +731,8 @@ void OrganFileParser::createGUIDivCplr(GoPanel *targetPanel, DivisionalCoupler *
 void OrganFileParser::createGUIGeneral(GoPanel *targetPanel, General *general) {
 	GUIElement *gen = new GUIGeneral(general);
 	gen->setOwningPanel(targetPanel);
-	gen->setDisplayName(general->getName());
+	if (general)
+		gen->setDisplayName(general->getName());
 	targetPanel->addGuiElement(gen);
 
 	GUIGeneral *theGeneral = dynamic_cast<GUIGeneral*>(gen);
@@ -444,6 +744,8 @@ void OrganFileParser::createGUIGeneral(GoPanel *targetPanel, General *general) {
 void OrganFileParser::createGUIDivisional(GoPanel *targetPanel, Divisional *divisional) {
 	GUIElement *guiDiv = new GUIDivisional(divisional);
 	guiDiv->setOwningPanel(targetPanel);
+	if (divisional)
+		guiDiv->setDisplayName(divisional->getName());
 	targetPanel->addGuiElement(guiDiv);
 
 	GUIDivisional *divElement = dynamic_cast<GUIDivisional*>(guiDiv);
@@ -481,11 +783,14 @@ void OrganFileParser::createFromSetterElement(GoPanel *targetPanel, wxString ele
 		e->setType(elementType);
 	} else if (elementType == wxT("Swell")) {
 		createGUIEnclosure(targetPanel, NULL);
+		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
+		e->setDisplayName(elementType);
 	} else if (elementType.StartsWith("General") && elementType.Len() == 9) {
 		createGUIGeneral(targetPanel, NULL);
 		// the element type must be overridden
 		GUIElement *e = targetPanel->getGuiElementAt(targetPanel->getNumberOfGuiElements() - 1);
 		e->setType(elementType);
+		e->setDisplayName(elementType);
 	} else if (elementType.Find("Setter") && elementType.Find("Divisional") && elementType.Len() == 22) {
 		// we need to get both manual (three X) and the divisional number YYY
 		wxString manNbrStr = elementType.Mid(6 , 3);
@@ -22,25 +22,50 @@
 #define ORGANFILEPARSER_H
 
 #include <wx/wx.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include "Organ.h"
+#include "BackgroundTask.h"
+#include <functional>
+#include <vector>
 
+// Reads an .organ file into an organ. The elements find the organ they
+// belong to through the frame while they are read, so the organ being parsed
+// must be the one of the frame for as long as parse() and createPanels() run.
 class OrganFileParser {
 public:
+	// larger ODFs leave the pipes unread until they are needed unless told otherwise
+	static const unsigned DEFAULT_PIPES_READ_ON_DEMAND_LINES = 200000;
+
 	OrganFileParser(wxString filePath, Organ *organ);
 	~OrganFileParser();
 
+	// false if the file couldn't be read or the task was cancelled
+	bool parse(BackgroundTask *task = NULL);
+	// Reads the panels and creates the GUI elements of the parsed organ. They
+	// make fonts and bitmaps, which only can be done on the GUI thread, so
+	// this must be called there once parse() has succeeded.
+	void createPanels();
 	bool isOrganReady();
+	wxString getErrorMessage();
+	// the paths of the ODF are matched exactly unless case is to be ignored
+	void setIgnoreCase(bool ignoreCase);
+	// the pipes are read when needed if on demand and the ODF has more lines than given
+	void setPipesReadOnDemand(bool onDemand, unsigned minimumLines);
 
 private:
-
 	Organ *m_organ;
+	BackgroundTask *m_task;
 	wxString m_filePath;
-	wxFileConfig m_organFile;
+	OdfReader m_organFile;
 	bool m_fileIsOk;
 	bool m_organIsReady;
 	bool m_isUsingOldPanelFormat;
 	wxString m_errorMessage;
+	bool m_ignoreCase;
+	bool m_readPipesOnDemand;
+	unsigned m_pipesOnDemandLines;
+	// the GUI elements found by parse() that createPanels() creates
+	std::vector<std::function<void()>> m_guiElementsToCreate;
 
 	int m_enclosuresToParse;
 	int m_tremulantsToParse;
@@ -62,12 +87,24 @@ private:
 	void parseOrgan();
 
 	void parseOrganSection();
+	void parsePanels();
+	void createGuiElementLater(std::function<void()> create);
+	void parsePanelElement(GoPanel *panel);
+	// the index of the element the key refers to by its number, or -1
+	int readReference(const char *key, unsigned numberOfElements);
+	Manual* readManualReference();
+
+	void beginStage(wxString stepsLabel, int totalSteps);
+	void stepDone();
+	bool isCancelled();
 
 	void createGUIEnclosure(GoPanel *targetPanel, Enclosure *enclosure);
 	void createGUITremulant(GoPanel *targetPanel, Tremulant *tremulant);
 	void createGUISwitch(GoPanel *targetPanel, GoSwitch *theSwitch);
 	void createGUILabel(GoPanel *targetPanel);
 	void createGUIManual(GoPanel *targetPanel, Manual *manual);
+	void createGUIStop(GoPanel *targetPanel, Stop *stop);
+	void createGUICoupler(GoPanel *targetPanel, Coupler *coupler);
 	void createGUIPiston(GoPanel *targetPanel, ReversiblePiston *piston);
 	void createGUIDivCplr(GoPanel *targetPanel, DivisionalCoupler *div_cplr);
 	void createGUIGeneral(GoPanel *targetPanel, General *general);
@@ -572,7 +572,6 @@ void OrganPanel::OnBrowseForOrganPath(wxCommandEvent& WXUNUSED(event)) {
 	m_odfPath = GetDirectoryPath();
 	m_odfPathField->SetValue(m_odfPath);
 	m_currentOrgan->setOdfRoot(m_odfPath);
-	m_currentOrgan->updateRelativePipePaths();
 	if (!m_infoPathField->IsEmpty()) {
 		m_infoPathField->SetValue(GOODF_functions::removeBaseOdfPath(m_currentOrgan->getInfoFilename()));
 	}
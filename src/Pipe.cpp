@@ -39,40 +39,10 @@ Pipe::Pipe() {
 	releaseCrossfadeLength = 0;
 }
 
-Pipe::Pipe(const Pipe& p) {
-	isPercussive = p.isPercussive;
-	amplitudeLevel = p.amplitudeLevel;
-	gain = p.gain;
-	pitchTuning = p.pitchTuning;
-	trackerDelay = p.trackerDelay;
-	harmonicNumber = p.harmonicNumber;
-	midiKeyNumber = p.midiKeyNumber;
-	midiPitchFraction = p.midiPitchFraction;
-	pitchCorrection = p.pitchCorrection;
-	acceptsRetuning = p.acceptsRetuning;
-	windchest = p.windchest;
-	minVelocityVolume = p.minVelocityVolume;
-	maxVelocityVolume = p.maxVelocityVolume;
-	loopCrossfadeLength = p.loopCrossfadeLength;
-	releaseCrossfadeLength = p.releaseCrossfadeLength;
-
-	for (Attack atk : p.m_attacks) {
-		m_attacks.push_back(atk);
-	}
-
-	for (Release rel : p.m_releases) {
-		m_releases.push_back(rel);
-	}
-}
-
-Pipe::~Pipe() {
-
-}
-
 void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
 	if (!isFirstAttackRefPath()) {
 		// remove organ base path from output line path
-		wxString relativeFileName = GOODF_functions::removeBaseOdfPath(m_attacks.front().fullPath);
+		wxString relativeFileName = m_attacks.front().getFileName();
 		wxString fullLine = GOODF_functions::fixSeparator(pipeNr + wxT("=") + relativeFileName);
 		outFile->AddLine(fullLine);
 
@@ -135,62 +105,60 @@ void Pipe::write(wxTextFile *outFile, wxString pipeNr, Rank *parent) {
 	}
 }
 
-void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent) {
-	wxString cfgBoolValue = cfg->Read(pipeNr + wxT("Percussive"), wxEmptyString);
-	isPercussive = GOODF_functions::parseBoolean(cfgBoolValue, parent->isPercussive());
-	float ampLvl = static_cast<float>(cfg->ReadDouble(pipeNr + wxT("AmplitudeLevel"), 100.0f));
+void Pipe::read(OdfReader *cfg, wxString pipeNr, Rank *parent) {
+	isPercussive = cfg->ReadBoolean(pipeNr, "Percussive", parent->isPercussive());
+	float ampLvl = static_cast<float>(cfg->ReadDouble(pipeNr, "AmplitudeLevel", 100.0f));
 	if (ampLvl >= 0 && ampLvl <= 1000) {
 		amplitudeLevel = ampLvl;
 	}
-	float gainValue = static_cast<float>(cfg->ReadDouble(pipeNr + wxT("Gain"), 0.0f));
+	float gainValue = static_cast<float>(cfg->ReadDouble(pipeNr, "Gain", 0.0f));
 	if (gainValue >= -120 && gainValue <= 40) {
 		gain = gainValue;
 	}
-	float pitchT = static_cast<float>(cfg->ReadDouble(pipeNr + wxT("PitchTuning"), 0.0f));
+	float pitchT = static_cast<float>(cfg->ReadDouble(pipeNr, "PitchTuning", 0.0f));
 	if (pitchT >= -1800 && pitchT <= 1800) {
 		pitchTuning = pitchT;
 	}
-	int trackerDly = static_cast<int>(cfg->ReadLong(pipeNr + wxT("TrackerDelay"), 0));
+	int trackerDly = static_cast<int>(cfg->ReadLong(pipeNr, "TrackerDelay", 0));
 	if (trackerDly > -1 && trackerDly < 10001) {
 		trackerDelay = trackerDly;
 	}
-	int harmNbr = static_cast<int>(cfg->ReadLong(pipeNr + wxT("HarmonicNumber"), parent->getHarmonicNumber()));
+	int harmNbr = static_cast<int>(cfg->ReadLong(pipeNr, "HarmonicNumber", parent->getHarmonicNumber()));
 	if (harmNbr > 0 && harmNbr < 1025) {
 		harmonicNumber = harmNbr;
 	}
-	int keyNbr = static_cast<int>(cfg->ReadLong(pipeNr + wxT("MIDIKeyNumber"), -1));
+	int keyNbr = static_cast<int>(cfg->ReadLong(pipeNr, "MIDIKeyNumber", -1));
 	if (keyNbr > -1 && keyNbr < 128) {
 		midiKeyNumber = keyNbr;
 	}
-	float pitchFrac = static_cast<float>(cfg->ReadDouble(pipeNr + wxT("MIDIPitchFraction"), -1.0f));
+	float pitchFrac = static_cast<float>(cfg->ReadDouble(pipeNr, "MIDIPitchFraction", -1.0f));
 	if (pitchFrac >= 0 && pitchFrac <= 100) {
 		midiPitchFraction = pitchFrac;
 	}
-	float pitchCorr = static_cast<float>(cfg->ReadDouble(pipeNr + wxT("PitchCorrection"), 0.0f));
+	float pitchCorr = static_cast<float>(cfg->ReadDouble(pipeNr, "PitchCorrection", 0.0f));
 	if (pitchCorr >= -1800 && pitchCorr <= 1800) {
 		pitchCorrection = pitchCorr;
 	}
-	int windchestRef = static_cast<int>(cfg->ReadLong(pipeNr + wxT("WindchestGroup"), 0));
+	int windchestRef = static_cast<int>(cfg->ReadLong(pipeNr, "WindchestGroup", 0));
 	if (windchestRef > 0 && windchestRef <= (int) ::wxGetApp().m_frame->m_organ->getNumberOfWindchestgroups()) {
 		windchest = ::wxGetApp().m_frame->m_organ->getOrganWindchestgroupAt(windchestRef - 1);
 	} else {
 		windchest = parent->getWindchest();
 	}
-	float minVelocity = static_cast<float>(cfg->ReadDouble(pipeNr + wxT("MinVelocityVolume"), parent->getMinVelocityVolume()));
+	float minVelocity = static_cast<float>(cfg->ReadDouble(pipeNr, "MinVelocityVolume", parent->getMinVelocityVolume()));
 	if (minVelocity >= 0 && minVelocity <= 1000) {
 		minVelocityVolume = minVelocity;
 	}
-	float maxVelocity = static_cast<float>(cfg->ReadDouble(pipeNr + wxT("MaxVelocityVolume"), parent->getMaxVelocityVolume()));
+	float maxVelocity = static_cast<float>(cfg->ReadDouble(pipeNr, "MaxVelocityVolume", parent->getMaxVelocityVolume()));
 	if (maxVelocity >= 0 && maxVelocity <= 1000) {
 		maxVelocityVolume = maxVelocity;
 	}
-	wxString retuningStr = cfg->Read(pipeNr + wxT("AcceptsRetuning"), wxEmptyString);
-	acceptsRetuning = GOODF_functions::parseBoolean(retuningStr, parent->doesAcceptsRetuning());
-	int loopXfade = static_cast<int>(cfg->ReadLong(pipeNr + wxT("LoopCrossfadeLength"), 0));
+	acceptsRetuning = cfg->ReadBoolean(pipeNr, "AcceptsRetuning", parent->doesAcceptsRetuning());
+	int loopXfade = static_cast<int>(cfg->ReadLong(pipeNr, "LoopCrossfadeLength", 0));
 	if (loopXfade > 0 && loopXfade < 121) {
 		loopCrossfadeLength = loopXfade;
 	}
-	int relXfade = static_cast<int>(cfg->ReadLong(pipeNr + wxT("ReleaseCrossfadeLength"), 0));
+	int relXfade = static_cast<int>(cfg->ReadLong(pipeNr, "ReleaseCrossfadeLength", 0));
 	if (relXfade > 0 && relXfade < 201) {
 		releaseCrossfadeLength = relXfade;
 	}
@@ -198,7 +166,7 @@ void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent) {
 	// the main attack is added first
 	readAttack(cfg, pipeNr);
 	// next any additional attacks
-	int nbrExtraAtks = static_cast<int>(cfg->ReadLong(pipeNr + wxT("AttackCount"), 0));
+	int nbrExtraAtks = static_cast<int>(cfg->ReadLong(pipeNr, "AttackCount", 0));
 	if (nbrExtraAtks > 0 && nbrExtraAtks < 101) {
 		for (int atk = 0; atk < nbrExtraAtks; atk++) {
 			wxString atkStr = pipeNr + wxT("Attack") + GOODF_functions::number_format(atk + 1);
@@ -206,20 +174,19 @@ void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent) {
 		}
 	}
 
-	int nbrExtraRel = static_cast<int>(cfg->ReadLong(pipeNr + wxT("ReleaseCount"), 0));
+	int nbrExtraRel = static_cast<int>(cfg->ReadLong(pipeNr, "ReleaseCount", 0));
 	if (nbrExtraRel > 0 && nbrExtraRel < 101) {
 		for (int rel = 0; rel < nbrExtraRel; rel++) {
 			wxString relStr = pipeNr + wxT("Release") + GOODF_functions::number_format(rel + 1);
 			wxString relPath = cfg->Read(relStr, wxEmptyString);
 			wxString fullRelPath = GOODF_functions::checkIfFileExist(relPath);
 			if (fullRelPath != wxEmptyString) {
-				int isTrem = static_cast<int>(cfg->ReadLong(relStr + wxT("IsTremulant"), -1));
-				int maxKeyPress = static_cast<int>(cfg->ReadLong(relStr + wxT("MaxKeyPressTime"), -1));
-				int cuePoint = static_cast<int>(cfg->ReadLong(relStr + wxT("CuePoint"), -1));
-				int relEnd = static_cast<int>(cfg->ReadLong(relStr + wxT("ReleaseEnd"), -1));
+				int isTrem = static_cast<int>(cfg->ReadLong(relStr, "IsTremulant", -1));
+				int maxKeyPress = static_cast<int>(cfg->ReadLong(relStr, "MaxKeyPressTime", -1));
+				int cuePoint = static_cast<int>(cfg->ReadLong(relStr, "CuePoint", -1));
+				int relEnd = static_cast<int>(cfg->ReadLong(relStr, "ReleaseEnd", -1));
 				Release r;
-				r.fileName = relPath;
-				r.fullPath = fullRelPath;
+				r.setFullPath(fullRelPath);
 				if (isTrem > -2 && isTrem < 2)
 					r.isTremulant = isTrem;
 				if (maxKeyPress > -2 && maxKeyPress < 100001)
@@ -229,43 +196,39 @@ void Pipe::read(wxFileConfig *cfg, wxString pipeNr, Rank *parent) {
 				if (relEnd > -2 && relEnd < 158760001)
 					r.releaseEnd = relEnd;
 
-				m_releases.push_back(r);
+				m_releases.push_back(std::move(r));
 			}
 		}
 	}
 
 	// finally a sanity check to see that there is at least one valid attack in the pipe
 	if (m_attacks.empty()) {
-		Attack a;
-		a.fileName = wxT("DUMMY");
-		a.fullPath = wxT("DUMMY");
-		m_attacks.push_back(a);
+		m_attacks.emplace_back();
 	}
 }
 
-void Pipe::readAttack(wxFileConfig *cfg, wxString pipeStr) {
+void Pipe::readAttack(OdfReader *cfg, wxString pipeStr) {
 	wxString mainAtkStr = cfg->Read(pipeStr, wxEmptyString);
 	if (mainAtkStr != wxEmptyString) {
 		// the pipe can have a relative path to a sample file or start with REF
 		wxString fullAtkPath = GOODF_functions::checkIfFileExist(mainAtkStr);
 		if (fullAtkPath != wxEmptyString) {
-			wxString loadReleaseStr = cfg->Read(pipeStr + wxT("LoadRelease"), wxEmptyString);
-			int atkVel = static_cast<int>(cfg->ReadLong(pipeStr + wxT("AttackVelocity"), 0));
-			int maxTime = static_cast<int>(cfg->ReadLong(pipeStr + wxT("MaxTimeSinceLastRelease"), -1));
-			int isTrem = static_cast<int>(cfg->ReadLong(pipeStr + wxT("IsTremulant"), -1));
-			int maxKeyPress = static_cast<int>(cfg->ReadLong(pipeStr + wxT("MaxKeyPressTime"), -1));
-			int atkStart = static_cast<int>(cfg->ReadLong(pipeStr + wxT("AttackStart"), 0));
-			int cuePoint = static_cast<int>(cfg->ReadLong(pipeStr + wxT("CuePoint"), -1));
-			int relEnd = static_cast<int>(cfg->ReadLong(pipeStr + wxT("ReleaseEnd"), -1));
-			int loops = static_cast<int>(cfg->ReadLong(pipeStr + wxT("LoopCount"), 0));
+			bool loadRelease = cfg->ReadBoolean(pipeStr, "LoadRelease", !isPercussive);
+			int atkVel = static_cast<int>(cfg->ReadLong(pipeStr, "AttackVelocity", 0));
+			int maxTime = static_cast<int>(cfg->ReadLong(pipeStr, "MaxTimeSinceLastRelease", -1));
+			int isTrem = static_cast<int>(cfg->ReadLong(pipeStr, "IsTremulant", -1));
+			int maxKeyPress = static_cast<int>(cfg->ReadLong(pipeStr, "MaxKeyPressTime", -1));
+			int atkStart = static_cast<int>(cfg->ReadLong(pipeStr, "AttackStart", 0));
+			int cuePoint = static_cast<int>(cfg->ReadLong(pipeStr, "CuePoint", -1));
+			int relEnd = static_cast<int>(cfg->ReadLong(pipeStr, "ReleaseEnd", -1));
+			int loops = static_cast<int>(cfg->ReadLong(pipeStr, "LoopCount", 0));
 			if (loops < 0)
 				loops = 0;
 			if (loops > 100)
 				loops = 100;
 			Attack a;
-			a.fileName = mainAtkStr;
-			a.fullPath = fullAtkPath;
-			a.loadRelease = GOODF_functions::parseBoolean(loadReleaseStr, !isPercussive);
+			a.setFullPath(fullAtkPath);
+			a.loadRelease = loadRelease;
 			if (atkVel > -1 && atkVel < 128)
 				a.attackVelocity = atkVel;
 			if (maxTime > -2 && maxTime < 100001)
@@ -280,31 +243,31 @@ void Pipe::readAttack(wxFileConfig *cfg, wxString pipeStr) {
 				a.cuePoint = cuePoint;
 			if (relEnd > -2 && relEnd < 158760001)
 				a.releaseEnd = relEnd;
-			for (int i = 0; i > loops; i++) {
+			for (int i = 0; i < loops; i++) {
 				Loop l;
 				wxString loopId = wxT("Loop") + GOODF_functions::number_format(i + 1);
-				int loopStart = static_cast<int>(cfg->ReadLong(pipeStr + loopId + wxT("Start"), 0));
+				int loopStart = static_cast<int>(cfg->ReadLong(pipeStr + loopId, "Start", 0));
 				if (loopStart > -1 && loopStart < 158760001)
 					l.start = loopStart;
 				else
 					l.start = 0;
-				int loopEnd = static_cast<int>(cfg->ReadLong(pipeStr + loopId + wxT("End"), 1));
+				int loopEnd = static_cast<int>(cfg->ReadLong(pipeStr + loopId, "End", 1));
 				if (loopEnd > l.start + 1 && loopEnd < 158760001)
 					l.end = loopEnd;
 				else
 					l.end = l.start + 1;
+				a.addNewLoop(l);
 			}
+			m_attacks.push_back(std::move(a));
 		} else if (mainAtkStr.StartsWith(wxT("REF")) || mainAtkStr.IsSameAs(wxT("DUMMY"), false)) {
-			Attack a;
-			a.fileName = mainAtkStr;
-			a.fullPath = mainAtkStr;
-			m_attacks.push_back(a);
+			m_attacks.emplace_back();
+			m_attacks.back().setFullPath(mainAtkStr);
 		}
 	}
 }
 
 bool Pipe::isFirstAttackRefPath() {
-	return m_attacks.front().fileName.StartsWith(wxT("REF"));
+	return m_attacks.front().isReference();
 }
 
 void Pipe::writeAdditionalAttacks(wxTextFile *outFile, wxString pipeNr) {
@@ -321,7 +284,7 @@ void Pipe::writeAdditionalAttacks(wxTextFile *outFile, wxString pipeNr) {
 			}
 			k++;
 			wxString attackName = pipeNr + wxT("Attack") + GOODF_functions::number_format(k);
-			wxString fullLine = GOODF_functions::fixSeparator(attackName + wxT("=") + atk.fileName);
+			wxString fullLine = GOODF_functions::fixSeparator(attackName + wxT("=") + atk.getFileName());
 			outFile->AddLine(fullLine);
 
 			writeLoadRelease(outFile, attackName, atk);
@@ -343,10 +306,10 @@ void Pipe::writeAdditionalReleases(wxTextFile *outFile, wxString pipeNr) {
 		unsigned extraReleases = m_releases.size();
 		outFile->AddLine(pipeNr + wxT("ReleaseCount=") + wxString::Format(wxT("%u"), extraReleases));
 		unsigned k = 0;
-		for (Release rel : m_releases) {
+		for (const Release& rel : m_releases) {
 			k++;
 			wxString releaseName = pipeNr + "Release" + GOODF_functions::number_format(k);
-			wxString fullLine = GOODF_functions::fixSeparator(releaseName + "=" + rel.fileName);
+			wxString fullLine = GOODF_functions::fixSeparator(releaseName + "=" + rel.getFileName());
 			outFile->AddLine(fullLine);
 
 			if (rel.isTremulant != -1)
@@ -365,7 +328,7 @@ void Pipe::writeAdditionalReleases(wxTextFile *outFile, wxString pipeNr) {
 }
 
 void Pipe::writeRef(wxTextFile *outFile, wxString pipeNr) {
-	outFile->AddLine(pipeNr + wxT("=") + m_attacks.front().fileName);
+	outFile->AddLine(pipeNr + wxT("=") + m_attacks.front().getFileName());
 }
 
 /*
@@ -378,9 +341,9 @@ wxString Pipe::fixSeparator(wxString pathToCheck) {
 }
 */
 
-void Pipe::writeLoadRelease(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeLoadRelease(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (!isPercussive) {
-		if (atk.fullPath != wxT("DUMMY")) {
+		if (!atk.isDummy()) {
 			// Load release is default Y for non percussive so we only need to care if it's false
 			if (!atk.loadRelease)
 				outFile->AddLine(pipeNr + wxT("LoadRelease=N"));
@@ -388,47 +351,47 @@ void Pipe::writeLoadRelease(wxTextFile *outFile, wxString pipeNr, Attack atk) {
 	}
 }
 
-void Pipe::writeAttackVelocity(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeAttackVelocity(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (atk.attackVelocity != 0)
 		outFile->AddLine(pipeNr + wxT("AttackVelocity=") + wxString::Format(wxT("%i"), atk.attackVelocity));
 }
 
-void Pipe::writeMaxTimeSinceLastRelease(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeMaxTimeSinceLastRelease(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (atk.maxTimeSinceLastRelease != -1)
 		outFile->AddLine(pipeNr + wxT("MaxTimeSinceLastRelease=") + wxString::Format(wxT("%i"), atk.maxTimeSinceLastRelease));
 }
 
-void Pipe::writeIsTremulant(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeIsTremulant(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (atk.isTremulant != -1)
 		outFile->AddLine(pipeNr + wxT("IsTremulant=") + wxString::Format(wxT("%i"), atk.isTremulant));
 }
 
-void Pipe::writeMaxKeyPressTime(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeMaxKeyPressTime(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (atk.maxKeyPressTime != -1)
 		outFile->AddLine(pipeNr + wxT("MaxKeyPressTime=") + wxString::Format(wxT("%i"), atk.maxKeyPressTime));
 }
 
-void Pipe::writeAttackStart(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeAttackStart(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (atk.attackStart != 0)
 		outFile->AddLine(pipeNr + wxT("AttackStart=") + wxString::Format(wxT("%i"), atk.attackStart));
 }
 
-void Pipe::writeCuePoint(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeCuePoint(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (atk.cuePoint != -1)
 		outFile->AddLine(pipeNr + wxT("CuePoint=") + wxString::Format(wxT("%i"), atk.cuePoint));
 }
 
-void Pipe::writeReleaseEnd(wxTextFile *outFile, wxString pipeNr, Attack atk) {
+void Pipe::writeReleaseEnd(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (atk.releaseEnd != -1)
 		outFile->AddLine(pipeNr + wxT("ReleaseEnd=") + wxString::Format(wxT("%i"), atk.releaseEnd));
 }
 
-void Pipe::writeLoops(wxTextFile *outFile, wxString pipeNr, Attack &atk) {
+void Pipe::writeLoops(wxTextFile *outFile, wxString pipeNr, const Attack &atk) {
 	if (!atk.m_loops.empty()) {
 		unsigned nbLoops = atk.m_loops.size();
 		outFile->AddLine(pipeNr + wxT("LoopCount=") + wxString::Format(wxT("%u"), nbLoops));
 		unsigned counter = 0;
-		for (Loop l : atk.m_loops) {
+		for (const Loop& l : atk.m_loops) {
 			counter++;
 			wxString formattedLoopNr = GOODF_functions::number_format(counter);
 			outFile->AddLine(pipeNr + wxT("Loop") + formattedLoopNr + wxT("Start=") + wxString::Format(wxT("%i"), l.start));
@@ -436,12 +399,3 @@ void Pipe::writeLoops(wxTextFile *outFile, wxString pipeNr, Attack &atk) {
 		}
 	}
 }
-
-void Pipe::updateRelativePaths() {
-	for (Attack& a : m_attacks) {
-		a.fileName = GOODF_functions::removeBaseOdfPath(a.fullPath);
-	}
-	for (Release& r : m_releases) {
-		r.fileName = GOODF_functions::removeBaseOdfPath(r.fullPath);
-	}
-}
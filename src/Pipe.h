@@ -26,34 +26,31 @@
 #include "Attack.h"
 #include "Release.h"
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 
 class Rank;
 
 class Pipe {
 public:
 	Pipe();
-	Pipe(const Pipe& p);
-	~Pipe();
 
 	void write(wxTextFile *outFile, wxString pipeNr, Rank *parent);
-	void read(wxFileConfig *cfg, wxString pipeNr, Rank *parent);
-	void readAttack(wxFileConfig *cfg, wxString pipeStr);
+	void read(OdfReader *cfg, wxString pipeNr, Rank *parent);
+	void readAttack(OdfReader *cfg, wxString pipeStr);
 
 	bool isFirstAttackRefPath();
 	void writeAdditionalAttacks(wxTextFile *outFile, wxString pipeNr);
 	void writeAdditionalReleases(wxTextFile *outFile, wxString pipeNr);
 	void writeRef(wxTextFile *outFile, wxString pipeNr);
-	void writeLoadRelease(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeAttackVelocity(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeMaxTimeSinceLastRelease(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeIsTremulant(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeMaxKeyPressTime(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeAttackStart(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeCuePoint(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeReleaseEnd(wxTextFile *outFile, wxString pipeNr, Attack atk);
-	void writeLoops(wxTextFile *outFile, wxString pipeNr, Attack &atk);
-	void updateRelativePaths();
+	void writeLoadRelease(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeAttackVelocity(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeMaxTimeSinceLastRelease(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeIsTremulant(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeMaxKeyPressTime(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeAttackStart(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeCuePoint(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeReleaseEnd(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
+	void writeLoops(wxTextFile *outFile, wxString pipeNr, const Attack &atk);
 
 	bool isPercussive;
 	float amplitudeLevel;
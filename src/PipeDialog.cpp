@@ -707,7 +707,7 @@ void PipeDialog::OnCopyAtkRelBtn(wxCommandEvent& WXUNUSED(event)) {
 		std::list<Pipe>::iterator pipe = m_rank_pipelist.begin();
 		std::advance(pipe, (m_selectedPipeIndex + 1 + i));
 		// first remove any DUMMY already present in target, then copy attacks and releases from current pipe
-		if (pipe->m_attacks.front().fullPath == wxT("DUMMY"))
+		if (pipe->m_attacks.front().isDummy())
 			pipe->m_attacks.pop_front();
 		std::copy(m_currentPipe->m_attacks.begin(), m_currentPipe->m_attacks.end(), std::back_inserter(pipe->m_attacks));
 		std::copy(m_currentPipe->m_releases.begin(), m_currentPipe->m_releases.end(), std::back_inserter(pipe->m_releases));
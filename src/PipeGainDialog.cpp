@@ -0,0 +1,146 @@
+/*
+ * PipeGainDialog.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PipeGainDialog.h"
+#include <wx/statline.h>
+
+IMPLEMENT_CLASS(PipeGainDialog, wxDialog)
+
+PipeGainDialog::PipeGainDialog(RankGainAnalyser &analyser) {
+	Init(analyser);
+}
+
+PipeGainDialog::PipeGainDialog(
+	RankGainAnalyser &analyser,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(analyser);
+	Create(parent, id, caption, pos, size, style);
+}
+
+PipeGainDialog::~PipeGainDialog() {
+
+}
+
+void PipeGainDialog::Init(RankGainAnalyser &analyser) {
+	m_analyser = &analyser;
+	m_pipeList = NULL;
+}
+
+bool PipeGainDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void PipeGainDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxString::Format(
+			wxT("%u of %u pipes analysed. The suggested gains even out the loudness of each pipe against its neighbours."),
+			m_analyser->getNumberOfAnalysedPipes(),
+			m_analyser->getNumberOfPipes()
+		)
+	);
+	firstRow->Add(summaryText, 1, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW);
+
+	m_pipeList = new wxListCtrl(
+		this,
+		wxID_ANY,
+		wxDefaultPosition,
+		wxSize(900, 400),
+		wxLC_REPORT|wxLC_SINGLE_SEL
+	);
+	m_pipeList->InsertColumn(0, wxT("Pipe"));
+	m_pipeList->InsertColumn(1, wxT("Peak (dBFS)"));
+	m_pipeList->InsertColumn(2, wxT("RMS (dBFS)"));
+	m_pipeList->InsertColumn(3, wxT("Loudness (LUFS)"));
+	m_pipeList->InsertColumn(4, wxT("Gain"));
+	m_pipeList->InsertColumn(5, wxT("Suggested gain"));
+	m_pipeList->InsertColumn(6, wxT("Sample"));
+	m_pipeList->SetColumnWidth(0, 50);
+	m_pipeList->SetColumnWidth(1, 90);
+	m_pipeList->SetColumnWidth(2, 90);
+	m_pipeList->SetColumnWidth(3, 110);
+	m_pipeList->SetColumnWidth(4, 70);
+	m_pipeList->SetColumnWidth(5, 110);
+	m_pipeList->SetColumnWidth(6, 370);
+	for (unsigned i = 0; i < m_analyser->getNumberOfPipes(); i++) {
+		const PipeGainAnalysis &pipe = m_analyser->getPipeAnalysisAt(i);
+		long item = m_pipeList->InsertItem(i, wxString::Format(wxT("%u"), pipe.pipeNumber));
+		m_pipeList->SetItem(item, 4, wxString::Format(wxT("%.1f"), pipe.currentGain));
+		if (pipe.isAnalysed) {
+			m_pipeList->SetItem(item, 1, wxString::Format(wxT("%.1f"), pipe.peak));
+			m_pipeList->SetItem(item, 2, wxString::Format(wxT("%.1f"), pipe.rms));
+			m_pipeList->SetItem(item, 3, wxString::Format(wxT("%.1f"), pipe.loudness));
+			m_pipeList->SetItem(item, 5, wxString::Format(wxT("%.1f"), pipe.suggestedGain));
+			m_pipeList->SetItem(item, 6, pipe.samplePath);
+		} else {
+			// the reason is shown where the sample would be
+			m_pipeList->SetItem(item, 5, wxT("-"));
+			m_pipeList->SetItem(item, 6, pipe.errorMessage);
+		}
+	}
+	mainSizer->Add(m_pipeList, 1, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Apply suggested gains")
+	);
+	theOkButton->Enable(m_analyser->getNumberOfAnalysedPipes() > 0);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
@@ -0,0 +1,70 @@
+/*
+ * PipeGainDialog.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PIPEGAINDIALOG_H
+#define PIPEGAINDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "RankGainAnalyser.h"
+
+// Previews the levels measured and the gains suggested by a RankGainAnalyser.
+// Nothing is changed here, the caller applies the gains if the dialog returns wxID_OK.
+class PipeGainDialog : public wxDialog {
+	DECLARE_CLASS(PipeGainDialog)
+
+public:
+	// Constructors
+	PipeGainDialog(RankGainAnalyser &analyser);
+	PipeGainDialog(
+		RankGainAnalyser &analyser,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Suggested Pipe Gains"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~PipeGainDialog();
+
+	// Initialize our variables
+	void Init(RankGainAnalyser &analyser);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Suggested Pipe Gains"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+private:
+	RankGainAnalyser *m_analyser;
+
+	wxListCtrl *m_pipeList;
+};
+
+#endif
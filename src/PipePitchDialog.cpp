@@ -0,0 +1,183 @@
+/*
+ * PipePitchDialog.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PipePitchDialog.h"
+#include <wx/statline.h>
+
+IMPLEMENT_CLASS(PipePitchDialog, wxDialog)
+
+PipePitchDialog::PipePitchDialog(RankPitchAnalyser &analyser) {
+	Init(analyser);
+}
+
+PipePitchDialog::PipePitchDialog(
+	RankPitchAnalyser &analyser,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(analyser);
+	Create(parent, id, caption, pos, size, style);
+}
+
+PipePitchDialog::~PipePitchDialog() {
+
+}
+
+void PipePitchDialog::Init(RankPitchAnalyser &analyser) {
+	m_analyser = &analyser;
+	m_pipeList = NULL;
+	m_writePitchTuning = NULL;
+	m_writeMidiPitchFraction = NULL;
+	m_keepRankPitch = NULL;
+}
+
+bool PipePitchDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void PipePitchDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxString::Format(
+			wxT("%u of %u pipes measured. The rank is %.1f cents from equal temperament at 440 Hz (median)."),
+			m_analyser->getNumberOfAnalysedPipes(),
+			m_analyser->getNumberOfPipes(),
+			m_analyser->getMedianDeviation()
+		)
+	);
+	firstRow->Add(summaryText, 1, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW);
+
+	m_pipeList = new wxListCtrl(
+		this,
+		wxID_ANY,
+		wxDefaultPosition,
+		wxSize(900, 400),
+		wxLC_REPORT|wxLC_SINGLE_SEL
+	);
+	m_pipeList->InsertColumn(0, wxT("Pipe"));
+	m_pipeList->InsertColumn(1, wxT("Nominal (Hz)"));
+	m_pipeList->InsertColumn(2, wxT("Measured (Hz)"));
+	m_pipeList->InsertColumn(3, wxT("Deviation (cents)"));
+	m_pipeList->InsertColumn(4, wxT("Clarity"));
+	m_pipeList->InsertColumn(5, wxT("Sample"));
+	m_pipeList->SetColumnWidth(0, 50);
+	m_pipeList->SetColumnWidth(1, 100);
+	m_pipeList->SetColumnWidth(2, 110);
+	m_pipeList->SetColumnWidth(3, 120);
+	m_pipeList->SetColumnWidth(4, 70);
+	m_pipeList->SetColumnWidth(5, 440);
+	for (unsigned i = 0; i < m_analyser->getNumberOfPipes(); i++) {
+		const PipePitchAnalysis &pipe = m_analyser->getPipeAnalysisAt(i);
+		long item = m_pipeList->InsertItem(i, wxString::Format(wxT("%u"), pipe.pipeNumber));
+		m_pipeList->SetItem(item, 1, wxString::Format(wxT("%.3f"), pipe.nominalFrequency));
+		if (pipe.isAnalysed) {
+			m_pipeList->SetItem(item, 2, wxString::Format(wxT("%.3f"), pipe.frequency));
+			m_pipeList->SetItem(item, 3, wxString::Format(wxT("%.1f"), pipe.deviation));
+			m_pipeList->SetItem(item, 4, wxString::Format(wxT("%.2f"), pipe.clarity));
+			m_pipeList->SetItem(item, 5, pipe.samplePath);
+		} else {
+			// the reason is shown where the sample would be
+			m_pipeList->SetItem(item, 2, wxT("-"));
+			m_pipeList->SetItem(item, 5, pipe.errorMessage);
+		}
+	}
+	mainSizer->Add(m_pipeList, 1, wxGROW|wxALL, 5);
+
+	wxStaticBoxSizer *writeOptions = new wxStaticBoxSizer(wxVERTICAL, this, wxT("Write the measured pitch as"));
+	m_writePitchTuning = new wxRadioButton(
+		writeOptions->GetStaticBox(),
+		wxID_ANY,
+		wxT("PitchTuning that moves every pipe to its nominal pitch"),
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxRB_GROUP
+	);
+	writeOptions->Add(m_writePitchTuning, 0, wxALL, 5);
+	m_keepRankPitch = new wxCheckBox(
+		writeOptions->GetStaticBox(),
+		wxID_ANY,
+		wxT("Keep the overall pitch of the rank and only even out the pipes"),
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_keepRankPitch->SetValue(true);
+	writeOptions->Add(m_keepRankPitch, 0, wxLEFT|wxRIGHT|wxBOTTOM, 25);
+	m_writeMidiPitchFraction = new wxRadioButton(
+		writeOptions->GetStaticBox(),
+		wxID_ANY,
+		wxT("MIDIKeyNumber and MIDIPitchFraction that tell GrandOrgue the pitch of every sample")
+	);
+	writeOptions->Add(m_writeMidiPitchFraction, 0, wxALL, 5);
+	m_writePitchTuning->SetValue(true);
+	mainSizer->Add(writeOptions, 0, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Write to pipes")
+	);
+	theOkButton->Enable(m_analyser->getNumberOfAnalysedPipes() > 0);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+bool PipePitchDialog::IsWritingPitchTuning() {
+	return m_writePitchTuning->GetValue();
+}
+
+bool PipePitchDialog::IsKeepingRankPitch() {
+	return m_keepRankPitch->GetValue();
+}
@@ -0,0 +1,78 @@
+/*
+ * PipePitchDialog.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PIPEPITCHDIALOG_H
+#define PIPEPITCHDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "RankPitchAnalyser.h"
+
+// Previews the pitches measured by a RankPitchAnalyser and lets the user
+// choose how they should be written. Nothing is changed here, the caller
+// applies the choice if the dialog returns wxID_OK.
+class PipePitchDialog : public wxDialog {
+	DECLARE_CLASS(PipePitchDialog)
+
+public:
+	// Constructors
+	PipePitchDialog(RankPitchAnalyser &analyser);
+	PipePitchDialog(
+		RankPitchAnalyser &analyser,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Measured Pipe Pitches"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~PipePitchDialog();
+
+	// Initialize our variables
+	void Init(RankPitchAnalyser &analyser);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Measured Pipe Pitches"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	bool IsWritingPitchTuning();
+	bool IsKeepingRankPitch();
+
+private:
+	RankPitchAnalyser *m_analyser;
+
+	wxListCtrl *m_pipeList;
+	wxRadioButton *m_writePitchTuning;
+	wxRadioButton *m_writeMidiPitchFraction;
+	wxCheckBox *m_keepRankPitch;
+};
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * PitchDetector.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "PitchDetector.h"
+#include "SampleAudioReader.h"
+#include "AudioKernels.h"
+#include <algorithm>
+#include <cmath>
+
+PitchDetector::PitchDetector() {
+	m_frequency = 0;
+	m_clarity = 0;
+	m_errorMessage = wxEmptyString;
+}
+
+PitchDetector::~PitchDetector() {
+
+}
+
+bool PitchDetector::findPitch(wxString fullPath, int attackStart, int cuePoint, double expectedFrequency) {
+	m_frequency = 0;
+	m_clarity = 0;
+
+	SampleAudioReader reader;
+	if (!reader.open(fullPath)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned regionStart;
+	unsigned regionEnd;
+	if (!reader.getSustainRegion(attackStart, cuePoint, regionStart, regionEnd)) {
+		m_errorMessage = wxT("The sample has no sustained part to measure.");
+		return false;
+	}
+
+	const double halfOctave = 1.4142135623730951;
+	unsigned sampleRate = reader.getSampleRate();
+	unsigned minPeriod = std::max(2u, (unsigned) (sampleRate / (expectedFrequency * halfOctave)));
+	unsigned maxPeriod = (unsigned) std::ceil(sampleRate * halfOctave / expectedFrequency);
+	unsigned windowLength = std::max(maxPeriod * 2, sampleRate / 50);
+	unsigned refinedLag = std::max(maxPeriod, sampleRate / 25);
+	unsigned frameLength = windowLength + refinedLag + maxPeriod + 4;
+	if (regionEnd - regionStart < frameLength) {
+		m_errorMessage = wxT("The sustained part of the sample is too short for its pitch.");
+		return false;
+	}
+
+	std::vector<float> samples;
+	if (!reader.readFrames(regionStart, regionEnd - regionStart, samples)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned channels = reader.getNumberOfChannels();
+	unsigned numberOfFrames = samples.size() / channels;
+	std::vector<float> mono(numberOfFrames);
+	for (unsigned i = 0; i < numberOfFrames; i++) {
+		float sum = 0;
+		for (unsigned ch = 0; ch < channels; ch++)
+			sum += samples[i * channels + ch];
+		mono[i] = sum;
+	}
+
+	std::vector<double> frequencies;
+	std::vector<double> clarities;
+	const unsigned numberOfMeasurements = 8;
+	unsigned spacing = (numberOfFrames - frameLength) / numberOfMeasurements;
+	for (unsigned m = 0; m < numberOfMeasurements; m++) {
+		const float *frame = mono.data() + (size_t) m * spacing;
+		double clarity;
+		double period = findPeriod(frame, windowLength, minPeriod, maxPeriod, clarity);
+		if (period <= 0)
+			continue;
+
+		// the lag of several whole periods is found to a fraction of a frame just as well as a single one
+		unsigned periods = std::max(1u, (unsigned) (refinedLag / period));
+		unsigned lag = (unsigned) std::lround(period * periods);
+		double before = difference(frame, windowLength, lag - 1);
+		double at = difference(frame, windowLength, lag);
+		double after = difference(frame, windowLength, lag + 1);
+		for (int step = 0; step < 3 && (before < at || after < at); step++) {
+			if (before < at) {
+				lag--;
+				after = at;
+				at = before;
+				before = difference(frame, windowLength, lag - 1);
+			} else {
+				lag++;
+				before = at;
+				at = after;
+				after = difference(frame, windowLength, lag + 1);
+			}
+		}
+		double refinedPeriod = lag;
+		double curvature = before + after - 2 * at;
+		if (curvature > 0)
+			refinedPeriod += 0.5 * (before - after) / curvature;
+		frequencies.push_back(sampleRate * periods / refinedPeriod);
+		clarities.push_back(clarity);
+	}
+
+	if (frequencies.empty()) {
+		m_errorMessage = wxT("No pitch was found near the expected one.");
+		return false;
+	}
+	std::sort(frequencies.begin(), frequencies.end());
+	std::sort(clarities.begin(), clarities.end());
+	m_frequency = frequencies[frequencies.size() / 2];
+	m_clarity = clarities[clarities.size() / 2];
+	return true;
+}
+
+double PitchDetector::getFrequency() {
+	return m_frequency;
+}
+
+double PitchDetector::getClarity() {
+	return m_clarity;
+}
+
+wxString PitchDetector::getErrorMessage() {
+	return m_errorMessage;
+}
+
+double PitchDetector::findPeriod(const float *samples, unsigned windowLength, unsigned minPeriod, unsigned maxPeriod, double &clarity) {
+	// the cumulative mean normalized difference of YIN, which needs all the lags from 1
+	m_differences.assign(maxPeriod + 2, 1.0);
+	double energy = AudioKernels::sumOfSquares(samples, windowLength);
+	double lagEnergy = energy;
+	double runningSum = 0;
+	for (unsigned lag = 1; lag <= maxPeriod + 1; lag++) {
+		// the energy of the lagged window slides along one frame at a time
+		lagEnergy += (double) samples[lag + windowLength - 1] * samples[lag + windowLength - 1] - (double) samples[lag - 1] * samples[lag - 1];
+		double value = energy + lagEnergy - 2.0 * AudioKernels::dotProduct(samples, samples + lag, windowLength);
+		runningSum += value;
+		m_differences[lag] = runningSum > 0 ? value * lag / runningSum : 1.0;
+	}
+
+	// the first dip below the threshold is the fundamental, otherwise the deepest one in the range
+	const double threshold = 0.15;
+	unsigned best = 0;
+	for (unsigned lag = minPeriod; lag <= maxPeriod; lag++) {
+		if (m_differences[lag] < threshold) {
+			while (lag + 1 <= maxPeriod && m_differences[lag + 1] < m_differences[lag])
+				lag++;
+			best = lag;
+			break;
+		}
+	}
+	if (!best) {
+		best = minPeriod;
+		for (unsigned lag = minPeriod + 1; lag <= maxPeriod; lag++) {
+			if (m_differences[lag] < m_differences[best])
+				best = lag;
+		}
+		if (best == minPeriod || best == maxPeriod)
+			return 0;
+	}
+
+	clarity = std::max(0.0, 1.0 - m_differences[best]);
+	double period = best;
+	double curvature = m_differences[best - 1] + m_differences[best + 1] - 2 * m_differences[best];
+	if (curvature > 0)
+		period += 0.5 * (m_differences[best - 1] - m_differences[best + 1]) / curvature;
+	return period;
+}
+
+double PitchDetector::difference(const float *samples, unsigned windowLength, unsigned lag) {
+	// the squared difference written out as energies and a correlation so that all three are dot products
+	double energy = AudioKernels::sumOfSquares(samples, windowLength);
+	double lagEnergy = AudioKernels::sumOfSquares(samples + lag, windowLength);
+	return energy + lagEnergy - 2.0 * AudioKernels::dotProduct(samples, samples + lag, windowLength);
+}
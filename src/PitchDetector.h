@@ -0,0 +1,55 @@
+/*
+ * PitchDetector.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef PITCHDETECTOR_H
+#define PITCHDETECTOR_H
+
+#include <wx/wx.h>
+#include <vector>
+
+// Measures the pitch of the sustained part of a sample with the YIN method.
+// The search is limited to half an octave around the expected frequency so
+// that the octave errors that pipes rich in harmonics invite are avoided.
+// Every estimate is then refined over as many whole periods as fit in a 40 ms
+// lag, which gives a precision of well under a cent. Several places of the
+// sustained part are measured and the median of them is kept.
+class PitchDetector {
+public:
+	PitchDetector();
+	~PitchDetector();
+
+	bool findPitch(wxString fullPath, int attackStart, int cuePoint, double expectedFrequency);
+	double getFrequency();
+	// between 0 and 1, how periodic the sample is at the frequency found
+	double getClarity();
+	wxString getErrorMessage();
+
+private:
+	double m_frequency;
+	double m_clarity;
+	wxString m_errorMessage;
+	std::vector<double> m_differences;
+
+	// the period in frames at the start of the samples, 0 if none was found
+	double findPeriod(const float *samples, unsigned windowLength, unsigned minPeriod, unsigned maxPeriod, double &clarity);
+	double difference(const float *samples, unsigned windowLength, unsigned lag);
+};
+
+#endif
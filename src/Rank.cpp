@@ -21,6 +21,8 @@
 #include "Rank.h"
 #include "GOODF.h"
 #include "GOODFFunctions.h"
+#include "LoopFinder.h"
+#include "WorkerPool.h"
 
 Rank::Rank() {
 	name = wxT("New Rank");
@@ -39,13 +41,11 @@ Rank::Rank() {
 	acceptsRetuning = true;
 
 	m_latestPipesRootPath = wxEmptyString;
+	m_sampleFilePattern = DEFAULT_SAMPLE_PATTERN;
+	m_unreadPipesSection = wxEmptyString;
 	createDummyPipes();
 }
 
-Rank::~Rank() {
-
-}
-
 void Rank::write(wxTextFile *outFile) {
 	outFile->AddLine(wxT("Name=") + name);
 	if (firstMidiNoteNumber > -1)
@@ -76,14 +76,7 @@ void Rank::write(wxTextFile *outFile) {
 	if (!acceptsRetuning)
 		outFile->AddLine(wxT("AcceptsRetuning=N"));
 
-	// pipes of the rank
-	unsigned pipeCounter = 0;
-	for (Pipe &p : m_pipes) {
-		pipeCounter++;
-		wxString formattedPipe = wxT("Pipe") + GOODF_functions::number_format(pipeCounter);
-
-		p.write(outFile, formattedPipe, this);
-	}
+	writePipes(outFile);
 }
 
 void Rank::writeFromStop(wxTextFile *outFile) {
@@ -113,17 +106,10 @@ void Rank::writeFromStop(wxTextFile *outFile) {
 	if (!acceptsRetuning)
 		outFile->AddLine(wxT("AcceptsRetuning=N"));
 
-	// pipes of the rank
-	unsigned pipeCounter = 0;
-	for (Pipe &p : m_pipes) {
-		pipeCounter++;
-		wxString formattedPipe = wxT("Pipe") + GOODF_functions::number_format(pipeCounter);
-
-		p.write(outFile, formattedPipe, this);
-	}
+	writePipes(outFile);
 }
 
-void Rank::read(wxFileConfig *cfg) {
+void Rank::read(OdfReader *cfg, bool readingPipes) {
 	name = cfg->Read("Name", wxEmptyString);
 	int firstMIDInote = static_cast<int>(cfg->ReadLong("FirstMidiNoteNumber", 36));
 	if (firstMIDInote > -1 && firstMIDInote < 257) {
@@ -173,12 +159,57 @@ void Rank::read(wxFileConfig *cfg) {
 	}
 	wxString retuningStr = cfg->Read("AcceptsRetuning", wxEmptyString);
 	setAcceptsRetuning(GOODF_functions::parseBoolean(retuningStr, true));
+	if (readingPipes)
+		readPipesOfSection(cfg);
+	else
+		m_unreadPipesSection = cfg->GetPath();
+}
+
+void Rank::writePipes(wxTextFile *outFile) {
+	// pipes that never were read are written back just as they were in the opened ODF
+	if (hasUnreadPipes()) {
+		wxArrayString pipeLines;
+		if (::wxGetApp().m_frame->m_organ->getUnreadPipeLines(m_unreadPipesSection, pipeLines)) {
+			for (unsigned i = 0; i < pipeLines.GetCount(); i++)
+				outFile->AddLine(pipeLines[i]);
+			return;
+		}
+		::wxGetApp().m_frame->m_organ->readUnreadPipes(this);
+	}
+
+	// pipes of the rank
+	unsigned pipeCounter = 0;
+	for (Pipe &p : m_pipes) {
+		pipeCounter++;
+		wxString formattedPipe = wxT("Pipe") + GOODF_functions::number_format(pipeCounter);
+
+		p.write(outFile, formattedPipe, this);
+	}
+}
+
+bool Rank::hasUnreadPipes() const {
+	return !m_unreadPipesSection.IsEmpty();
+}
+
+void Rank::readUnreadPipes(OdfReader *cfg) {
+	if (m_unreadPipesSection.IsEmpty())
+		return;
+
+	cfg->SetPath(m_unreadPipesSection);
+	readPipesOfSection(cfg);
+	m_unreadPipesSection = wxEmptyString;
+}
+
+void Rank::readPipesOfSection(OdfReader *cfg) {
+	// the read pipes replace the dummy pipes a new rank starts with
+	std::list<Pipe> pipes;
 	for (int i = 0; i < numberOfLogicalPipes; i++) {
 		Pipe p;
 		wxString pipeNbr = wxT("Pipe") + GOODF_functions::number_format(i + 1);
 		p.read(cfg, pipeNbr, this);
-		m_pipes.push_back(p);
+		pipes.push_back(std::move(p));
 	}
+	m_pipes.swap(pipes);
 }
 
 bool Rank::doesAcceptsRetuning() const {
@@ -328,375 +359,246 @@ void Rank::setPipesRootPath(wxString path) {
 	m_latestPipesRootPath = path;
 }
 
-void Rank::readPipes(
+wxString Rank::getSampleFilePattern() {
+	return m_sampleFilePattern;
+}
+
+void Rank::setSampleFilePattern(wxString pattern) {
+	m_sampleFilePattern = pattern;
+}
+
+bool Rank::readPipes(
+	PipeChanges &changes,
 	wxString extraAttackFolder,
 	bool loadOnlyOneAttack,
 	bool loadRelease,
 	wxString releaseFolderPrefix,
 	bool extractKeyPressTime,
-	wxString tremulantFolderPrefix
+	wxString tremulantFolderPrefix,
+	BackgroundTask *task,
+	SampleDirectoryIndex *sampleIndex
 ) {
-	bool organRootPathIsSet = false;
-
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
-		organRootPathIsSet = true;
-
-	wxDir pipeRoot(m_latestPipesRootPath);
+	std::list<Pipe> pipes;
+	if (sampleIndex) {
+		if (!scanPipes(*sampleIndex, pipes, extraAttackFolder, loadOnlyOneAttack, loadRelease, releaseFolderPrefix, extractKeyPressTime, tremulantFolderPrefix, task))
+			return false;
+	} else {
+		SampleDirectoryIndex ownIndex(firstMidiNoteNumber, numberOfLogicalPipes, m_sampleFilePattern);
+		if (!scanPipes(ownIndex, pipes, extraAttackFolder, loadOnlyOneAttack, loadRelease, releaseFolderPrefix, extractKeyPressTime, tremulantFolderPrefix, task))
+			return false;
+	}
 
-	if (!pipeRoot.IsOpened())
-		return;
+	unsigned index = 0;
+	for (Pipe& p : pipes) {
+		PipeChange &change = changes[index++];
+		change.replacesPipe = true;
+		change.pipe = std::move(p);
+	}
+	return true;
+}
 
-	clearAllPipes();
+bool Rank::rescanPipes(
+	PipeChanges &changes,
+	wxString extraAttackFolder,
+	bool loadOnlyOneAttack,
+	bool loadRelease,
+	wxString releaseFolderPrefix,
+	bool extractKeyPressTime,
+	wxString tremulantFolderPrefix,
+	SampleMetadataCache *cache,
+	BackgroundTask *task
+) {
+	std::list<Pipe> scannedPipes;
+	SampleDirectoryIndex sampleIndex(firstMidiNoteNumber, numberOfLogicalPipes, m_sampleFilePattern);
+	if (!scanPipes(sampleIndex, scannedPipes, extraAttackFolder, loadOnlyOneAttack, loadRelease, releaseFolderPrefix, extractKeyPressTime, tremulantFolderPrefix, task))
+		return false;
 
-	for (int i = 0; i < numberOfLogicalPipes; i++) {
-		Pipe p;
-		setupPipeProperties(p);
+	// only the pipes where sample files were added, removed or changed are
+	// copied and merged, all other pipes are left exactly as they are
+	wxString scannedRoot = m_latestPipesRootPath + wxFILE_SEP_PATH;
+	std::list<Pipe>::iterator pipeIt = m_pipes.begin();
+	unsigned index = 0;
 
-		wxArrayString pipeAttacks;
-		wxArrayString pipeAttacksToAdd;
-		wxArrayString pipeReleases;
-		wxArrayString pipeReleasesToAdd;
-		wxArrayString releaseFolders;
-		wxArrayString tremulantFolders;
-		wxArrayString allFolders;
-
-		bool hasTremulantFolders = false;
-
-		// first store all folders existing in root
-		wxString folder;
-		bool cont = pipeRoot.GetFirst(&folder, wxT("*"), wxDIR_DIRS);
-		while (cont) {
-			allFolders.Add(folder);
-			cont = pipeRoot.GetNext(&folder);
+	for (Pipe& scanned : scannedPipes) {
+		if (pipeIt == m_pipes.end()) {
+			changes[index++].pipe = std::move(scanned);
+			continue;
 		}
 
-		if (!allFolders.IsEmpty()) {
-			// separate release and tremulant folders
-			for (unsigned j = 0; j < allFolders.GetCount(); j++) {
+		Pipe &existing = *pipeIt;
+		++pipeIt;
+		unsigned pipeIndex = index++;
 
-				if (allFolders.Item(j).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString) {
-					releaseFolders.Add(allFolders.Item(j));
-				} else if (allFolders.Item(j).Lower().Find(tremulantFolderPrefix.Lower()) != wxNOT_FOUND && tremulantFolderPrefix != wxEmptyString) {
-					tremulantFolders.Add(allFolders.Item(j));
-					hasTremulantFolders = true;
-				}
-			}
-		}
-
-		// get attacks from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-			wxDIR_FILES
-		);
+		// a borrowed pipe has no samples of its own to rescan
+		if (existing.isFirstAttackRefPath())
+			continue;
 
-		// then from possible extra attack folder
-		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
-				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-				wxDIR_FILES
-			);
+		Pipe merged;
+		if (rescanPipe(existing, scanned, scannedRoot, cache, merged)) {
+			PipeChange &change = changes[pipeIndex];
+			change.replacesPipe = true;
+			change.pipe = std::move(merged);
 		}
+	}
 
-		pipeAttacks.Sort();
-
-		// remove any file that's not ending with .wav or .wv
-		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-		// if there are any matching attacks we add them
-		if (!pipeAttacksToAdd.IsEmpty()) {
-			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
-				else
-					relativeFileName = pipeAttacksToAdd.Item(j);
+	return !changes.empty();
+}
 
-				// create and add the attack to the pipe
-				Attack a;
-				a.fileName = relativeFileName;
-				a.fullPath = pipeAttacksToAdd.Item(j);
-				a.loadRelease = loadRelease;
-				if (hasTremulantFolders)
-					a.isTremulant = 0;
+bool Rank::rescanPipe(const Pipe &existing, Pipe &scanned, wxString scannedRoot, SampleMetadataCache *cache, Pipe &merged) {
+	std::set<wxString> scannedAttacks;
+	for (const Attack& atk : scanned.m_attacks) {
+		if (!atk.isDummy())
+			scannedAttacks.insert(atk.getFullPath());
+	}
+	std::set<wxString> scannedReleases;
+	for (const Release& rel : scanned.m_releases) {
+		scannedReleases.insert(rel.getFullPath());
+	}
 
-				p.m_attacks.push_back(a);
+	// first find out without copying anything if the pipe changes at all
+	bool isChanged = false;
+	std::set<wxString> existingAttacks;
+	std::set<wxString> existingReleases;
+	std::set<wxString> changedFiles;
+	for (const Attack& atk : existing.m_attacks) {
+		if (atk.isDummy())
+			continue;
+		existingAttacks.insert(atk.getFullPath());
+		if (!isSampleStillPresent(atk.getFullPath(), scannedRoot, scannedAttacks))
+			isChanged = true;
+		else if (cache && cache->hasChanged(atk.getFullPath()))
+			changedFiles.insert(atk.getFullPath());
+	}
+	for (const Release& rel : existing.m_releases) {
+		existingReleases.insert(rel.getFullPath());
+		if (!isSampleStillPresent(rel.getFullPath(), scannedRoot, scannedReleases))
+			isChanged = true;
+		else if (cache && cache->hasChanged(rel.getFullPath()))
+			changedFiles.insert(rel.getFullPath());
+	}
+	for (const wxString& path : scannedAttacks) {
+		if (existingAttacks.find(path) == existingAttacks.end())
+			isChanged = true;
+	}
+	for (const wxString& path : scannedReleases) {
+		if (existingReleases.find(path) == existingReleases.end())
+			isChanged = true;
+	}
+	if (!isChanged && changedFiles.empty())
+		return false;
 
-				if (loadOnlyOneAttack)
-					break;
-			}
+	// existing samples keep all their settings, only what was read from a
+	// sample file that has changed since is read again
+	merged = existing;
+	for (std::list<Attack>::iterator atkIt = merged.m_attacks.begin(); atkIt != merged.m_attacks.end();) {
+		if (atkIt->isDummy() || !isSampleStillPresent(atkIt->getFullPath(), scannedRoot, scannedAttacks)) {
+			atkIt = merged.m_attacks.erase(atkIt);
+			continue;
 		}
-
-		pipeAttacks.Empty();
-		pipeAttacksToAdd.Empty();
-
-		// add extra releases if they can be found
-		if (!releaseFolders.IsEmpty()) {
-
-			releaseFolders.Sort();
-
-			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
-					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-					wxDIR_FILES
-				);
-
-				pipeReleases.Sort();
-
-				// remove any file that's not ending with .wav or .wv
-				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-				// if there are any matching releases we add them
-				if (!pipeReleasesToAdd.IsEmpty()) {
-
-					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-						else
-							relativeFileName = pipeReleasesToAdd.Item(k);
-
-						// create and add the release to the pipe
-						Release rel;
-						rel.fileName = relativeFileName;
-						rel.fullPath = pipeReleasesToAdd.Item(k);
-						if (hasTremulantFolders)
-							rel.isTremulant = 0;
-
-						if (extractKeyPressTime) {
-							// we try to get a number that have at least 2 digits from the folder name
-							wxString relFolderName = releaseFolders.Item(j).AfterLast(wxFILE_SEP_PATH);
-							int firstNumberIndex = -1;
-							long keyPressTime = -1;
-
-							for (unsigned l = 0; l < relFolderName.Length(); l++) {
-								if (wxIsdigit(relFolderName.GetChar(l))) {
-									firstNumberIndex = l;
-									break;
-								}
-							}
-								
-							if (firstNumberIndex > -1) {
-								wxString numberPart = relFolderName.Mid(firstNumberIndex);
-
-								if (!numberPart.ToLong(&keyPressTime)) {
-									// the number part didn't contain only numbers!
-								}
-
-								if (keyPressTime > 9 && keyPressTime < 99999)
-									rel.maxKeyPressTime = keyPressTime;
-							}
-						}
-
-						p.m_releases.push_back(rel);
-
-					}
-				}
-
-				pipeReleases.Empty();
-				pipeReleasesToAdd.Empty();
+		if (changedFiles.find(atkIt->getFullPath()) != changedFiles.end()) {
+			SampleMetadata sample;
+			if (cache->getMetadata(atkIt->getFullPath(), sample) && sample.isOk) {
+				atkIt->m_loops = sample.loops;
+				atkIt->cuePoint = sample.cuePoint;
+			} else {
+				atkIt->m_loops.clear();
+				atkIt->cuePoint = -1;
 			}
 		}
+		++atkIt;
+	}
+	for (Attack& atk : scanned.m_attacks) {
+		if (!atk.isDummy() && existingAttacks.find(atk.getFullPath()) == existingAttacks.end())
+			merged.m_attacks.push_back(std::move(atk));
+	}
+	if (merged.m_attacks.empty())
+		merged.m_attacks.emplace_back();
 
-		// also scan possible tremulant folders
-		if (!tremulantFolders.IsEmpty() && !loadOnlyOneAttack) {
-			for (unsigned j = 0; j < tremulantFolders.GetCount(); j++) {
-				fillArrayStringWithFiles(
-					pipeRoot,
-					m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j),
-					pipeAttacks,
-					i
-				);
-
-				onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
-
-				// if there are any matching attacks we add them
-				if (!pipeAttacksToAdd.IsEmpty()) {
-					for (unsigned k = 0; k < pipeAttacksToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k));
-						else
-							relativeFileName = pipeAttacksToAdd.Item(k);
-
-						// create and add the attack to the pipe
-						Attack a;
-						a.fileName = relativeFileName;
-						a.fullPath = pipeAttacksToAdd.Item(k);
-						a.loadRelease = loadRelease;
-						a.isTremulant = 1;
-
-						p.m_attacks.push_back(a);
-
-					}
-				}
-
-				// also take care of possible tremulant releases
-				wxArrayString foldersInTremulantFolder;
-				wxArrayString tremReleaseFolders;
-				wxString currentTremRootPath = m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j);
-				wxDir tremRoot(currentTremRootPath);
-
-				if (tremRoot.IsOpened()) {
-					// first store all folders existing in root
-					wxString folderName;
-					bool keepLooking = tremRoot.GetFirst(&folderName, wxT("*"), wxDIR_DIRS);
-					do {
-						foldersInTremulantFolder.Add(folderName);
-						keepLooking = tremRoot.GetNext(&folderName);
-					} while (keepLooking);
-
-					// then get only those with release prefix in them
-					if (!foldersInTremulantFolder.IsEmpty()) {
-						for (unsigned k = 0; k < foldersInTremulantFolder.GetCount(); k++) {
-							if (foldersInTremulantFolder.Item(k).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString)
-								tremReleaseFolders.Add(foldersInTremulantFolder.Item(k));
-						}
-					}
-
-					if (!tremReleaseFolders.IsEmpty()) {
-						for (unsigned k = 0; k < tremReleaseFolders.GetCount(); k++) {
-							fillArrayStringWithFiles(
-								tremRoot,
-								currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders.Item(k),
-								pipeReleases,
-								i
-							);
-						}
-					}
-
-					pipeReleases.Sort();
-					onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
-
-					// if there are any matching releases we add them
-					if (!pipeReleasesToAdd.IsEmpty()) {
-						for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-							wxString relativeFileName;
-							if (organRootPathIsSet)
-								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-							else
-								relativeFileName = pipeReleasesToAdd.Item(k);
-
-							// create and add the release to the pipe
-							Release rel;
-							rel.fileName = relativeFileName;
-							rel.fullPath = pipeReleasesToAdd.Item(k);
-							rel.isTremulant = 1;
-
-							if (extractKeyPressTime) {
-								// we try to get a number that have at least 2 digits from the folder name
-								wxString relFolderName = (pipeReleasesToAdd.Item(k).BeforeLast(wxFILE_SEP_PATH)).AfterLast(wxFILE_SEP_PATH);
-								int firstNumberIndex = -1;
-								long keyPressTime = -1;
-								for (unsigned l = 0; l < relFolderName.Length(); l++) {
-									if (wxIsdigit(relFolderName.GetChar(l))) {
-										firstNumberIndex = l;
-										break;
-									}
-								}
-
-								if (firstNumberIndex > -1) {
-									wxString numberPart = relFolderName.Mid(firstNumberIndex);
-									if (!numberPart.ToLong(&keyPressTime)) {
-										// the number part didn't contain only numbers!
-									}
-
-									if (keyPressTime > 9 && keyPressTime < 99999)
-										rel.maxKeyPressTime = keyPressTime;
-								}
-							}
-
-							p.m_releases.push_back(rel);
-						}
-					}
-
-				}
-			}
+	for (std::list<Release>::iterator relIt = merged.m_releases.begin(); relIt != merged.m_releases.end();) {
+		if (!isSampleStillPresent(relIt->getFullPath(), scannedRoot, scannedReleases)) {
+			relIt = merged.m_releases.erase(relIt);
+			continue;
 		}
+		if (changedFiles.find(relIt->getFullPath()) != changedFiles.end()) {
+			SampleMetadata sample;
+			if (cache->getMetadata(relIt->getFullPath(), sample) && sample.isOk)
+				relIt->cuePoint = sample.cuePoint;
+			else
+				relIt->cuePoint = -1;
+		}
+		++relIt;
+	}
+	for (Release& rel : scanned.m_releases) {
+		if (existingReleases.find(rel.getFullPath()) == existingReleases.end())
+			merged.m_releases.push_back(std::move(rel));
+	}
 
-		if (p.m_attacks.empty()) {
-			// if we don't have any other attacks for this pipe, just add a single dummy attack
-			Attack a;
-			p.m_attacks.push_back(a);
+	return true;
+}
+
+void Rank::applyPipeChanges(PipeChanges &changes) {
+	PipeChanges::iterator change = changes.begin();
+	unsigned index = 0;
+	for (std::list<Pipe>::iterator pipe = m_pipes.begin(); pipe != m_pipes.end() && change != changes.end(); ++pipe, index++) {
+		if (change->first != index)
+			continue;
+
+		if (change->second.replacesPipe) {
+			std::swap(*pipe, change->second.pipe);
+		} else {
+			pipe->m_attacks.splice(pipe->m_attacks.end(), change->second.pipe.m_attacks);
+			pipe->m_releases.splice(pipe->m_releases.end(), change->second.pipe.m_releases);
 		}
+		++change;
+	}
 
-		m_pipes.push_back(p);
+	// pipes beyond the current ones are added last
+	for (; change != changes.end(); ++change) {
+		m_pipes.push_back(std::move(change->second.pipe));
 	}
+	changes.clear();
 }
 
-void Rank::addToPipes(
+bool Rank::addToPipes(
+	PipeChanges &changes,
 	wxString extraAttackFolder,
 	bool loadOnlyOneAttack,
 	bool loadRelease,
 	wxString releaseFolderPrefix,
 	bool extractKeyPressTime,
-	wxString tremulantFolderPrefix
+	wxString tremulantFolderPrefix,
+	BackgroundTask *task
 ) {
-	bool organRootPathIsSet = false;
+	SampleDirectoryIndex sampleIndex(firstMidiNoteNumber, numberOfLogicalPipes, m_sampleFilePattern);
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
-		organRootPathIsSet = true;
+	if (!sampleIndex.isPatternValid() || !sampleIndex.isFolderReadable(m_latestPipesRootPath))
+		return false;
 
-	wxDir pipeRoot(m_latestPipesRootPath);
+	// found samples are only kept in the changes so that the rank stays untouched
+	// the folders existing in root are classified only once for all pipes
+	SampleFolderClassifier folderClassifier(releaseFolderPrefix, tremulantFolderPrefix, extractKeyPressTime);
+	folderClassifier.classifyFolders(sampleIndex, m_latestPipesRootPath);
+	const std::vector<SampleFolderInfo> &releaseFolders = folderClassifier.getReleaseFolders();
+	const std::vector<SampleFolderInfo> &tremulantFolders = folderClassifier.getTremulantFolders();
+	bool hasTremulantFolders = folderClassifier.hasTremulantFolders();
 
-	if (!pipeRoot.IsOpened())
-		return;
+	for (int i = 0; i < numberOfLogicalPipes && i < (int) m_pipes.size(); i++) {
+		if (task && task->isCancelled())
+			return false;
 
-	for (int i = 0; i < numberOfLogicalPipes; i++) {
-		Pipe *p = getPipeAt(i);
+		Pipe added;
 
 		wxArrayString pipeAttacks;
 		wxArrayString pipeAttacksToAdd;
 		wxArrayString pipeReleases;
 		wxArrayString pipeReleasesToAdd;
-		wxArrayString releaseFolders;
-		wxArrayString tremulantFolders;
-		wxArrayString allFolders;
-
-		bool hasTremulantFolders = false;
-
-		// first store all folders existing in root
-		wxString folder;
-		bool cont = pipeRoot.GetFirst(&folder, wxT("*"), wxDIR_DIRS);
-		while (cont) {
-			allFolders.Add(folder);
-		    cont = pipeRoot.GetNext(&folder);
-		}
-
-		if (!allFolders.IsEmpty()) {
-			// separate release and tremulant folders
-			for (unsigned j = 0; j < allFolders.GetCount(); j++) {
-
-				if (allFolders.Item(j).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString) {
-					releaseFolders.Add(allFolders.Item(j));
-				} else if (allFolders.Item(j).Lower().Find(tremulantFolderPrefix.Lower()) != wxNOT_FOUND && tremulantFolderPrefix != wxEmptyString) {
-					tremulantFolders.Add(allFolders.Item(j));
-					hasTremulantFolders = true;
-				}
-			}
-		}
 
 		// get attacks from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-			wxDIR_FILES
-		);
+		fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath, pipeAttacks, i);
 
 		// then from possible extra attack folder
 		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
-				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-				wxDIR_FILES
-			);
+			fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder, pipeAttacks, i);
 		}
 
 		pipeAttacks.Sort();
@@ -707,21 +609,15 @@ void Rank::addToPipes(
 		// if there are any matching attacks we add them
 		if (!pipeAttacksToAdd.IsEmpty()) {
 			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
-				else
-					relativeFileName = pipeAttacksToAdd.Item(j);
-
 				// create and add the attack to the pipe
 				Attack a;
-				a.fileName = relativeFileName;
-				a.fullPath = pipeAttacksToAdd.Item(j);
+				a.setFullPath(pipeAttacksToAdd.Item(j));
 				a.loadRelease = loadRelease;
 				if (hasTremulantFolders)
 					a.isTremulant = 0;
 
-				p->m_attacks.push_back(a);
+				applySampleNameInfo(sampleIndex, a);
+				added.m_attacks.push_back(std::move(a));
 
 				if (loadOnlyOneAttack)
 					break;
@@ -732,17 +628,10 @@ void Rank::addToPipes(
 		pipeAttacksToAdd.Empty();
 
 		// add extra releases if they can be found
-		if (!releaseFolders.IsEmpty()) {
+		if (!releaseFolders.empty()) {
 
-			releaseFolders.Sort();
-
-			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
-					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-					wxDIR_FILES
-				);
+			for (unsigned j = 0; j < releaseFolders.size(); j++) {
+				fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders[j].name, pipeReleases, i);
 
 				pipeReleases.Sort();
 
@@ -753,45 +642,17 @@ void Rank::addToPipes(
 				if (!pipeReleasesToAdd.IsEmpty()) {
 
 					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-						else
-							relativeFileName = pipeReleasesToAdd.Item(k);
-
 						// create and add the release to the pipe
 						Release rel;
-						rel.fileName = relativeFileName;
-						rel.fullPath = pipeReleasesToAdd.Item(k);
+						rel.setFullPath(pipeReleasesToAdd.Item(k));
 						if (hasTremulantFolders)
 							rel.isTremulant = 0;
 
-						if (extractKeyPressTime) {
-							// we try to get a number that have at least 2 digits from the folder name
-							wxString relFolderName = releaseFolders.Item(j).AfterLast(wxFILE_SEP_PATH);
-							int firstNumberIndex = -1;
-							long keyPressTime = -1;
-
-							for (unsigned l = 0; l < relFolderName.Length(); l++) {
-								if (wxIsdigit(relFolderName.GetChar(l))) {
-									firstNumberIndex = l;
-									break;
-								}
-							}
+						if (releaseFolders[j].maxKeyPressTime > -1)
+							rel.maxKeyPressTime = releaseFolders[j].maxKeyPressTime;
 
-							if (firstNumberIndex > -1) {
-								wxString numberPart = relFolderName.Mid(firstNumberIndex);
-
-								if (!numberPart.ToLong(&keyPressTime)) {
-									// the number part didn't contain only numbers!
-								}
-
-								if (keyPressTime > 9 && keyPressTime < 99999)
-									rel.maxKeyPressTime = keyPressTime;
-							}
-						}
-
-						p->m_releases.push_back(rel);
+						applySampleNameInfo(sampleIndex, rel);
+						added.m_releases.push_back(std::move(rel));
 
 					}
 				}
@@ -802,185 +663,110 @@ void Rank::addToPipes(
 		}
 
 		// also scan possible tremulant folders
-		if (!tremulantFolders.IsEmpty() && !loadOnlyOneAttack) {
-			for (unsigned j = 0; j < tremulantFolders.GetCount(); j++) {
-				fillArrayStringWithFiles(
-					pipeRoot,
-					m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j),
-					pipeAttacks,
-					i
-				);
+		if (!tremulantFolders.empty() && !loadOnlyOneAttack) {
+			for (unsigned j = 0; j < tremulantFolders.size(); j++) {
+				fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders[j].name, pipeAttacks, i);
 
 				onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
 
 				// if there are any matching attacks we add them
 				if (!pipeAttacksToAdd.IsEmpty()) {
 					for (unsigned k = 0; k < pipeAttacksToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(k));
-						else
-							relativeFileName = pipeAttacksToAdd.Item(k);
-
 						// create and add the attack to the pipe
 						Attack a;
-						a.fileName = relativeFileName;
-						a.fullPath = pipeAttacksToAdd.Item(k);
+						a.setFullPath(pipeAttacksToAdd.Item(k));
 						a.loadRelease = loadRelease;
 						a.isTremulant = 1;
 
-						p->m_attacks.push_back(a);
+						applySampleNameInfo(sampleIndex, a);
+						added.m_attacks.push_back(std::move(a));
 
 					}
 				}
 
-				// also take care of possible tremulant releases
-				wxArrayString foldersInTremulantFolder;
-				wxArrayString tremReleaseFolders;
-				wxString currentTremRootPath = m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders.Item(j);
-				wxDir tremRoot(currentTremRootPath);
-
-				if (tremRoot.IsOpened()) {
-					// first store all folders existing in root
-					wxString folderName;
-					bool keepLooking = tremRoot.GetFirst(&folderName, wxT("*"), wxDIR_DIRS);
-					while (keepLooking) {
-						foldersInTremulantFolder.Add(folderName);
-					    keepLooking = tremRoot.GetNext(&folderName);
-					}
+				pipeAttacks.Empty();
+				pipeAttacksToAdd.Empty();
 
-					// then get only those with release prefix in them
-					if (!foldersInTremulantFolder.IsEmpty()) {
-						for (unsigned k = 0; k < foldersInTremulantFolder.GetCount(); k++) {
-							if (foldersInTremulantFolder.Item(k).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString)
-								tremReleaseFolders.Add(foldersInTremulantFolder.Item(k));
-						}
-					}
+				// also take care of possible tremulant releases
+				wxString currentTremRootPath = m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders[j].name;
+				const std::vector<SampleFolderInfo> &tremReleaseFolders = tremulantFolders[j].releaseFolders;
 
-					if (!tremReleaseFolders.IsEmpty()) {
-						for (unsigned k = 0; k < tremReleaseFolders.GetCount(); k++) {
-							fillArrayStringWithFiles(
-								tremRoot,
-								currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders.Item(k),
-								pipeReleases,
-								i
-							);
-						}
-					}
+				for (unsigned k = 0; k < tremReleaseFolders.size(); k++) {
+					fillArrayStringWithFiles(sampleIndex, currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders[k].name, pipeReleases, i);
 
 					pipeReleases.Sort();
 					onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
 
 					// if there are any matching releases we add them
-					if (!pipeReleasesToAdd.IsEmpty()) {
-						for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-							wxString relativeFileName;
-							if (organRootPathIsSet)
-								relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-							else
-								relativeFileName = pipeReleasesToAdd.Item(k);
-
-							// create and add the release to the pipe
-							Release rel;
-							rel.fileName = relativeFileName;
-							rel.fullPath = pipeReleasesToAdd.Item(k);
-							rel.isTremulant = 1;
-
-							if (extractKeyPressTime) {
-								// we try to get a number that have at least 2 digits from the folder name
-								wxString relFolderName = (pipeReleasesToAdd.Item(k).BeforeLast(wxFILE_SEP_PATH)).AfterFirst(wxFILE_SEP_PATH);
-								int firstNumberIndex = -1;
-								long keyPressTime = -1;
-								for (unsigned l = 0; l < relFolderName.Length(); l++) {
-									if (wxIsdigit(relFolderName.GetChar(l))) {
-										firstNumberIndex = l;
-										break;
-									}
-								}
-
-								if (firstNumberIndex > -1) {
-									wxString numberPart = relFolderName.Mid(firstNumberIndex);
-									if (!numberPart.ToLong(&keyPressTime)) {
-										// the number part didn't contain only numbers!
-									}
-
-									if (keyPressTime > 9 && keyPressTime < 99999)
-										rel.maxKeyPressTime = keyPressTime;
-								}
-							}
-
-							p->m_releases.push_back(rel);
-						}
+					for (unsigned l = 0; l < pipeReleasesToAdd.GetCount(); l++) {
+						// create and add the release to the pipe
+						Release rel;
+						rel.setFullPath(pipeReleasesToAdd.Item(l));
+						rel.isTremulant = 1;
+						if (tremReleaseFolders[k].maxKeyPressTime > -1)
+							rel.maxKeyPressTime = tremReleaseFolders[k].maxKeyPressTime;
+
+						applySampleNameInfo(sampleIndex, rel);
+						added.m_releases.push_back(std::move(rel));
 					}
 
+					pipeReleases.Empty();
+					pipeReleasesToAdd.Empty();
 				}
 			}
 		}
+
+		unsigned samplesFound = added.m_attacks.size() + added.m_releases.size();
+		if (samplesFound > 0)
+			changes[i].pipe = std::move(added);
+
+		if (task) {
+			task->addItemsFound(samplesFound);
+			task->stepDone();
+		}
 	}
+
+	return !(task && task->isCancelled());
 }
 
-void Rank::addTremulantToPipes(
+bool Rank::addTremulantToPipes(
+	PipeChanges &changes,
 	wxString extraAttackFolder,
 	bool loadOnlyOneAttack,
 	bool loadRelease,
 	wxString releaseFolderPrefix,
-	bool extractKeyPressTime
+	bool extractKeyPressTime,
+	BackgroundTask *task
 ) {
 	// This method is for adding additional attacks/releases as (wave) tremulants only
-	bool organRootPathIsSet = false;
+	SampleDirectoryIndex sampleIndex(firstMidiNoteNumber, numberOfLogicalPipes, m_sampleFilePattern);
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
-		organRootPathIsSet = true;
+	if (!sampleIndex.isPatternValid() || !sampleIndex.isFolderReadable(m_latestPipesRootPath))
+		return false;
 
-	wxDir pipeRoot(m_latestPipesRootPath);
+	// found samples are only kept in the changes so that the rank stays untouched
+	// the folders existing in root are classified only once for all pipes
+	SampleFolderClassifier folderClassifier(releaseFolderPrefix, wxEmptyString, extractKeyPressTime);
+	folderClassifier.classifyFolders(sampleIndex, m_latestPipesRootPath);
+	const std::vector<SampleFolderInfo> &releaseFolders = folderClassifier.getReleaseFolders();
 
-	if (!pipeRoot.IsOpened())
-		return;
+	for (int i = 0; i < numberOfLogicalPipes && i < (int) m_pipes.size(); i++) {
+		if (task && task->isCancelled())
+			return false;
 
-	for (int i = 0; i < numberOfLogicalPipes; i++) {
-		Pipe *p = getPipeAt(i);
+		Pipe added;
 
 		wxArrayString pipeAttacks;
 		wxArrayString pipeAttacksToAdd;
 		wxArrayString pipeReleases;
 		wxArrayString pipeReleasesToAdd;
-		wxArrayString releaseFolders;
-		wxArrayString allFolders;
-
-		// first store all folders existing in root
-		wxString folder;
-		bool cont = pipeRoot.GetFirst(&folder, wxT("*"), wxDIR_DIRS);
-		while (cont) {
-			allFolders.Add(folder);
-		    cont = pipeRoot.GetNext(&folder);
-		}
-
-		if (!allFolders.IsEmpty()) {
-			// separate release and tremulant folders
-			for (unsigned j = 0; j < allFolders.GetCount(); j++) {
-
-				if (allFolders.Item(j).Lower().Find(releaseFolderPrefix.Lower()) != wxNOT_FOUND && releaseFolderPrefix != wxEmptyString) {
-					releaseFolders.Add(allFolders.Item(j));
-				}
-			}
-		}
 
 		// get attacks from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeAttacks,
-			wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-			wxDIR_FILES
-		);
+		fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath, pipeAttacks, i);
 
 		// then from possible extra attack folder
 		if (extraAttackFolder != wxEmptyString) {
-			pipeRoot.GetAllFiles(
-				m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder,
-				&pipeAttacks,
-				wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-				wxDIR_FILES
-			);
+			fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder, pipeAttacks, i);
 		}
 
 		pipeAttacks.Sort();
@@ -991,20 +777,14 @@ void Rank::addTremulantToPipes(
 		// if there are any matching attacks we add them
 		if (!pipeAttacksToAdd.IsEmpty()) {
 			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeAttacksToAdd.Item(j));
-				else
-					relativeFileName = pipeAttacksToAdd.Item(j);
-
 				// create and add the attack to the pipe
 				Attack a;
-				a.fileName = relativeFileName;
-				a.fullPath = pipeAttacksToAdd.Item(j);
+				a.setFullPath(pipeAttacksToAdd.Item(j));
 				a.loadRelease = loadRelease;
 				a.isTremulant = 1;
 
-				p->m_attacks.push_back(a);
+				applySampleNameInfo(sampleIndex, a);
+				added.m_attacks.push_back(std::move(a));
 
 				if (loadOnlyOneAttack)
 					break;
@@ -1015,17 +795,10 @@ void Rank::addTremulantToPipes(
 		pipeAttacksToAdd.Empty();
 
 		// add extra releases if they can be found
-		if (!releaseFolders.IsEmpty()) {
-
-			releaseFolders.Sort();
+		if (!releaseFolders.empty()) {
 
-			for (unsigned j = 0; j < releaseFolders.GetCount(); j++) {
-				pipeRoot.GetAllFiles(
-					m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders.Item(j),
-					&pipeReleases,
-					wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-					wxDIR_FILES
-				);
+			for (unsigned j = 0; j < releaseFolders.size(); j++) {
+				fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders[j].name, pipeReleases, i);
 
 				pipeReleases.Sort();
 
@@ -1036,44 +809,16 @@ void Rank::addTremulantToPipes(
 				if (!pipeReleasesToAdd.IsEmpty()) {
 
 					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
-						wxString relativeFileName;
-						if (organRootPathIsSet)
-							relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(k));
-						else
-							relativeFileName = pipeReleasesToAdd.Item(k);
-
 						// create and add the release to the pipe
 						Release rel;
-						rel.fileName = relativeFileName;
-						rel.fullPath = pipeReleasesToAdd.Item(k);
+						rel.setFullPath(pipeReleasesToAdd.Item(k));
 						rel.isTremulant = 1;
 
-						if (extractKeyPressTime) {
-							// we try to get a number that have at least 2 digits from the folder name
-							wxString relFolderName = releaseFolders.Item(j).AfterLast(wxFILE_SEP_PATH);
-							int firstNumberIndex = -1;
-							long keyPressTime = -1;
-
-							for (unsigned l = 0; l < relFolderName.Length(); l++) {
-								if (wxIsdigit(relFolderName.GetChar(l))) {
-									firstNumberIndex = l;
-									break;
-								}
-							}
-
-							if (firstNumberIndex > -1) {
-								wxString numberPart = relFolderName.Mid(firstNumberIndex);
+						if (releaseFolders[j].maxKeyPressTime > -1)
+							rel.maxKeyPressTime = releaseFolders[j].maxKeyPressTime;
 
-								if (!numberPart.ToLong(&keyPressTime)) {
-									// the number part didn't contain only numbers!
-								}
-
-								if (keyPressTime > 9 && keyPressTime < 99999)
-									rel.maxKeyPressTime = keyPressTime;
-							}
-						}
-
-						p->m_releases.push_back(rel);
+						applySampleNameInfo(sampleIndex, rel);
+						added.m_releases.push_back(std::move(rel));
 
 					}
 				}
@@ -1082,34 +827,39 @@ void Rank::addTremulantToPipes(
 				pipeReleasesToAdd.Empty();
 			}
 		}
+
+		unsigned samplesFound = added.m_attacks.size() + added.m_releases.size();
+		if (samplesFound > 0)
+			changes[i].pipe = std::move(added);
+
+		if (task) {
+			task->addItemsFound(samplesFound);
+			task->stepDone();
+		}
 	}
+
+	return !(task && task->isCancelled());
 }
 
-void Rank::addReleasesToPipes() {
+bool Rank::addReleasesToPipes(PipeChanges &changes, BackgroundTask *task) {
 	// This method is for adding releases only from a single folder
-	bool organRootPathIsSet = false;
+	SampleDirectoryIndex sampleIndex(firstMidiNoteNumber, numberOfLogicalPipes, m_sampleFilePattern);
 
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
-		organRootPathIsSet = true;
-
-	wxDir pipeRoot(m_latestPipesRootPath);
+	if (!sampleIndex.isPatternValid() || !sampleIndex.isFolderReadable(m_latestPipesRootPath))
+		return false;
 
-	if (!pipeRoot.IsOpened())
-		return;
+	// found samples are only kept in the changes so that the rank stays untouched
+	for (int i = 0; i < numberOfLogicalPipes && i < (int) m_pipes.size(); i++) {
+		if (task && task->isCancelled())
+			return false;
 
-	for (int i = 0; i < numberOfLogicalPipes; i++) {
-		Pipe *p = getPipeAt(i);
+		Pipe added;
 
 		wxArrayString pipeReleases;
 		wxArrayString pipeReleasesToAdd;
 
 		// get files from root folder
-		pipeRoot.GetAllFiles(
-			m_latestPipesRootPath,
-			&pipeReleases,
-			wxString::Format(wxT("*%i*.*"), (i + firstMidiNoteNumber)),
-			wxDIR_FILES
-		);
+		fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath, pipeReleases, i);
 
 		pipeReleases.Sort();
 
@@ -1119,18 +869,12 @@ void Rank::addReleasesToPipes() {
 		// if there are any matching attacks we add them
 		if (!pipeReleasesToAdd.IsEmpty()) {
 			for (unsigned j = 0; j < pipeReleasesToAdd.GetCount(); j++) {
-				wxString relativeFileName;
-				if (organRootPathIsSet)
-					relativeFileName = getOnlyFileName(pipeReleasesToAdd.Item(j));
-				else
-					relativeFileName = pipeReleasesToAdd.Item(j);
-
 				// create and add the release to the pipe
 				Release r;
-				r.fileName = relativeFileName;
-				r.fullPath = pipeReleasesToAdd.Item(j);
+				r.setFullPath(pipeReleasesToAdd.Item(j));
 
-				p->m_releases.push_back(r);
+				applySampleNameInfo(sampleIndex, r);
+				added.m_releases.push_back(std::move(r));
 
 			}
 		}
@@ -1138,15 +882,132 @@ void Rank::addReleasesToPipes() {
 		pipeReleases.Empty();
 		pipeReleasesToAdd.Empty();
 
+		unsigned samplesFound = added.m_attacks.size() + added.m_releases.size();
+		if (samplesFound > 0)
+			changes[i].pipe = std::move(added);
+
+		if (task) {
+			task->addItemsFound(samplesFound);
+			task->stepDone();
+		}
 	}
+
+	return !(task && task->isCancelled());
 }
 
-void Rank::clearAllPipes() {
-	for (Pipe p : m_pipes) {
-		p.m_attacks.clear();
-		p.m_releases.clear();
+bool Rank::readLoopsAndCuesFromSamples(PipeChanges &changes, SampleMetadataCache *cache, BackgroundTask *task) {
+	// only the samples a task has found are filled, and nothing already set is changed
+	for (PipeChanges::iterator change = changes.begin(); change != changes.end(); ++change) {
+		if (task && task->isCancelled())
+			return false;
+
+		Pipe &p = change->second.pipe;
+		unsigned samplesUpdated = 0;
+		for (Attack& atk : p.m_attacks) {
+			if (atk.isDummy() || atk.isReference())
+				continue;
+			if (!atk.m_loops.empty() && atk.cuePoint != -1)
+				continue;
+
+			SampleMetadata sample;
+			if (!cache->getMetadata(atk.getFullPath(), sample) || !sample.isOk)
+				continue;
+
+			bool updated = false;
+			if (atk.m_loops.empty() && !sample.loops.empty()) {
+				atk.m_loops.swap(sample.loops);
+				updated = true;
+			}
+			if (atk.cuePoint == -1 && sample.cuePoint != -1) {
+				atk.cuePoint = sample.cuePoint;
+				updated = true;
+			}
+			if (updated)
+				samplesUpdated++;
+		}
+
+		for (Release& rel : p.m_releases) {
+			if (rel.cuePoint != -1)
+				continue;
+
+			SampleMetadata sample;
+			if (cache->getMetadata(rel.getFullPath(), sample) && sample.isOk && sample.cuePoint != -1) {
+				rel.cuePoint = sample.cuePoint;
+				samplesUpdated++;
+			}
+		}
+
+		if (task) {
+			task->addItemsFound(samplesUpdated);
+			task->stepDone();
+		}
+	}
+
+	return !(task && task->isCancelled());
+}
+
+void Rank::getSamplesWithoutLoopsOrCues(const PipeChanges &changes, std::vector<wxString> &fullPaths) const {
+	for (PipeChanges::const_iterator change = changes.begin(); change != changes.end(); ++change) {
+		const Pipe &p = change->second.pipe;
+		for (const Attack& atk : p.m_attacks) {
+			if (atk.isDummy() || atk.isReference())
+				continue;
+			if (atk.m_loops.empty() || atk.cuePoint == -1)
+				fullPaths.push_back(atk.getFullPath());
+		}
+		for (const Release& rel : p.m_releases) {
+			if (rel.cuePoint == -1)
+				fullPaths.push_back(rel.getFullPath());
+		}
+	}
+}
+
+bool Rank::findMissingLoops(WorkerPool &pool, BackgroundTask *task) {
+	std::vector<Attack*> attacks;
+	for (Pipe& p : m_pipes) {
+		for (Attack& atk : p.m_attacks) {
+			if (atk.isDummy() || atk.isReference())
+				continue;
+			if (atk.m_loops.empty())
+				attacks.push_back(&atk);
+		}
 	}
 
+	if (attacks.empty())
+		return false;
+
+	if (task)
+		task->setTotalSteps(attacks.size());
+
+	// every attack is searched on its own so they can be spread over all cores,
+	// the loops found are only added once all attacks are done
+	std::vector<Loop> foundLoops(attacks.size());
+	std::vector<char> isFound(attacks.size(), 0);
+	pool.parallelFor(attacks.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+		LoopFinder finder(1);
+		if (finder.findLoops(attacks[i]->getFullPath(), attacks[i]->attackStart, attacks[i]->cuePoint)) {
+			foundLoops[i] = finder.getCandidates().front().loop;
+			isFound[i] = 1;
+			if (task)
+				task->addItemsFound(1);
+		}
+		if (task)
+			task->stepDone();
+	});
+
+	if (task && task->isCancelled())
+		return false;
+
+	for (unsigned i = 0; i < attacks.size(); i++) {
+		if (isFound[i])
+			attacks[i]->m_loops.push_back(foundLoops[i]);
+	}
+	return true;
+}
+
+void Rank::clearAllPipes() {
 	m_pipes.clear();
 }
 
@@ -1158,10 +1019,9 @@ void Rank::createDummyPipes() {
 		Pipe p;
 		setupPipeProperties(p);
 
-		Attack a;
-		p.m_attacks.push_back(a);
+		p.m_attacks.emplace_back();
 
-		m_pipes.push_back(p);
+		m_pipes.push_back(std::move(p));
 	}
 }
 
@@ -1169,26 +1029,24 @@ void Rank::addDummyPipeFront() {
 	Pipe p;
 	setupPipeProperties(p);
 
-	Attack a;
-	p.m_attacks.push_back(a);
+	p.m_attacks.emplace_back();
 
-	m_pipes.push_front(p);
+	m_pipes.push_front(std::move(p));
 }
 
 void Rank::addDummyPipeBack() {
 	Pipe p;
 	setupPipeProperties(p);
 
-	Attack a;
-	p.m_attacks.push_back(a);
+	p.m_attacks.emplace_back();
 
-	m_pipes.push_back(p);
+	m_pipes.push_back(std::move(p));
 }
 
 bool Rank::hasOnlyDummyPipes() {
-	for (Pipe p : m_pipes) {
-		for (Attack atk : p.m_attacks) {
-			if (atk.fileName != wxT("DUMMY"))
+	for (const Pipe& p : m_pipes) {
+		for (const Attack& atk : p.m_attacks) {
+			if (!atk.isDummy())
 				return false;
 		}
 	}
@@ -1209,78 +1067,34 @@ void Rank::clearPipeAt(unsigned index) {
 	(*iterator).m_releases.clear();
 
 	setupPipeProperties(*iterator);
-	Attack a;
-	(*iterator).m_attacks.push_back(a);
+	(*iterator).m_attacks.emplace_back();
 }
 
 void Rank::createNewAttackInPipe(unsigned index, wxString filePath, bool loadRelease) {
 	auto iterator = std::next(m_pipes.begin(), index);
 
-	bool organRootPathIsSet = false;
-
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
-		organRootPathIsSet = true;
-
-	wxString relativeFileName;
-	if (organRootPathIsSet)
-		relativeFileName = getOnlyFileName(filePath);
-	else
-		relativeFileName = filePath;
-
 	// create and add the attack to the pipe
 	Attack a;
-	a.fileName = relativeFileName;
-	a.fullPath = filePath;
+	a.setFullPath(filePath);
 	a.loadRelease = loadRelease;
 
-	(*iterator).m_attacks.push_back(a);
+	(*iterator).m_attacks.push_back(std::move(a));
 }
 
 void Rank::createNewReleaseInPipe(unsigned index, wxString filePath, bool extractKeyPressTime) {
 	auto iterator = std::next(m_pipes.begin(), index);
 
-	bool organRootPathIsSet = false;
-
-	if (::wxGetApp().m_frame->m_organ->getOdfRoot() != wxEmptyString)
-		organRootPathIsSet = true;
-
-	wxString relativeFileName;
-	if (organRootPathIsSet)
-		relativeFileName = getOnlyFileName(filePath);
-	else
-		relativeFileName = filePath;
-
 	// create and add the release to the pipe
 	Release rel;
-	rel.fileName = relativeFileName;
-	rel.fullPath = filePath;
-
-	if (extractKeyPressTime) {
-		// we try to get a number that have at least 2 digits from the folder name
-		wxString folderPath = filePath.BeforeLast(wxFILE_SEP_PATH);
-		wxString relFolderName = folderPath.AfterLast(wxFILE_SEP_PATH);
-		int firstNumberIndex = -1;
-		long keyPressTime = -1;
-
-		for (unsigned l = 0; l < relFolderName.Length(); l++) {
-			if (wxIsdigit(relFolderName.GetChar(l))) {
-				firstNumberIndex = l;
-				break;
-			}
-		}
+	rel.setFullPath(filePath);
 
-		if (firstNumberIndex > -1) {
-			wxString numberPart = relFolderName.Mid(firstNumberIndex);
-			if (!numberPart.ToLong(&keyPressTime)) {
-				// the number part didn't contain only numbers!
-			}
+	// a single file gets its folder classified just like in a full scan
+	SampleFolderClassifier folderClassifier(wxEmptyString, wxEmptyString, extractKeyPressTime);
+	SampleFolderInfo folderInfo = folderClassifier.classifyFolder(filePath.BeforeLast(wxFILE_SEP_PATH).AfterLast(wxFILE_SEP_PATH));
+	if (folderInfo.maxKeyPressTime > -1)
+		rel.maxKeyPressTime = folderInfo.maxKeyPressTime;
 
-			if (keyPressTime > 9 && keyPressTime < 99999)
-				rel.maxKeyPressTime = keyPressTime;
-		}
-	}
-
-	(*iterator).m_releases.push_back(rel);
+	(*iterator).m_releases.push_back(std::move(rel));
 }
 
 bool Rank::deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex) {
@@ -1307,13 +1121,185 @@ Pipe* Rank::getPipeAt(unsigned index) {
 	return &(*iterator);
 }
 
-void Rank::fillArrayStringWithFiles(wxDir &root, wxString path, wxArrayString &list, int pipeIndex) {
-	root.GetAllFiles(
-		path,
-		&list,
-		wxString::Format(wxT("*%i*.*"), (pipeIndex + firstMidiNoteNumber)),
-		wxDIR_FILES
-	);
+bool Rank::scanPipes(
+	SampleDirectoryIndex &sampleIndex,
+	std::list<Pipe> &pipes,
+	wxString extraAttackFolder,
+	bool loadOnlyOneAttack,
+	bool loadRelease,
+	wxString releaseFolderPrefix,
+	bool extractKeyPressTime,
+	wxString tremulantFolderPrefix,
+	BackgroundTask *task
+) {
+	if (!sampleIndex.isPatternValid() || !sampleIndex.isFolderReadable(m_latestPipesRootPath))
+		return false;
+
+	// the folders existing in root are classified only once for all pipes
+	SampleFolderClassifier folderClassifier(releaseFolderPrefix, tremulantFolderPrefix, extractKeyPressTime);
+	folderClassifier.classifyFolders(sampleIndex, m_latestPipesRootPath);
+	const std::vector<SampleFolderInfo> &releaseFolders = folderClassifier.getReleaseFolders();
+	const std::vector<SampleFolderInfo> &tremulantFolders = folderClassifier.getTremulantFolders();
+	bool hasTremulantFolders = folderClassifier.hasTremulantFolders();
+
+	for (int i = 0; i < numberOfLogicalPipes; i++) {
+		if (task && task->isCancelled())
+			return false;
+
+		Pipe p;
+		setupPipeProperties(p);
+
+		wxArrayString pipeAttacks;
+		wxArrayString pipeAttacksToAdd;
+		wxArrayString pipeReleases;
+		wxArrayString pipeReleasesToAdd;
+
+		// get attacks from root folder
+		fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath, pipeAttacks, i);
+
+		// then from possible extra attack folder
+		if (extraAttackFolder != wxEmptyString) {
+			fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + extraAttackFolder, pipeAttacks, i);
+		}
+
+		pipeAttacks.Sort();
+
+		// remove any file that's not ending with .wav or .wv
+		onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
+
+		// if there are any matching attacks we add them
+		if (!pipeAttacksToAdd.IsEmpty()) {
+			for (unsigned j = 0; j < pipeAttacksToAdd.GetCount(); j++) {
+				// create and add the attack to the pipe
+				Attack a;
+				a.setFullPath(pipeAttacksToAdd.Item(j));
+				a.loadRelease = loadRelease;
+				if (hasTremulantFolders)
+					a.isTremulant = 0;
+
+				applySampleNameInfo(sampleIndex, a);
+				p.m_attacks.push_back(std::move(a));
+
+				if (loadOnlyOneAttack)
+					break;
+			}
+		}
+
+		pipeAttacks.Empty();
+		pipeAttacksToAdd.Empty();
+
+		// add extra releases if they can be found
+		if (!releaseFolders.empty()) {
+
+			for (unsigned j = 0; j < releaseFolders.size(); j++) {
+				fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + releaseFolders[j].name, pipeReleases, i);
+
+				pipeReleases.Sort();
+
+				// remove any file that's not ending with .wav or .wv
+				onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
+
+				// if there are any matching releases we add them
+				if (!pipeReleasesToAdd.IsEmpty()) {
+
+					for (unsigned k = 0; k < pipeReleasesToAdd.GetCount(); k++) {
+						// create and add the release to the pipe
+						Release rel;
+						rel.setFullPath(pipeReleasesToAdd.Item(k));
+						if (hasTremulantFolders)
+							rel.isTremulant = 0;
+
+						if (releaseFolders[j].maxKeyPressTime > -1)
+							rel.maxKeyPressTime = releaseFolders[j].maxKeyPressTime;
+
+						applySampleNameInfo(sampleIndex, rel);
+						p.m_releases.push_back(std::move(rel));
+
+					}
+				}
+
+				pipeReleases.Empty();
+				pipeReleasesToAdd.Empty();
+			}
+		}
+
+		// also scan possible tremulant folders
+		if (!tremulantFolders.empty() && !loadOnlyOneAttack) {
+			for (unsigned j = 0; j < tremulantFolders.size(); j++) {
+				fillArrayStringWithFiles(sampleIndex, m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders[j].name, pipeAttacks, i);
+
+				onlyAddWaveFiles(pipeAttacks, pipeAttacksToAdd);
+
+				// if there are any matching attacks we add them
+				if (!pipeAttacksToAdd.IsEmpty()) {
+					for (unsigned k = 0; k < pipeAttacksToAdd.GetCount(); k++) {
+						// create and add the attack to the pipe
+						Attack a;
+						a.setFullPath(pipeAttacksToAdd.Item(k));
+						a.loadRelease = loadRelease;
+						a.isTremulant = 1;
+
+						applySampleNameInfo(sampleIndex, a);
+						p.m_attacks.push_back(std::move(a));
+
+					}
+				}
+
+				pipeAttacks.Empty();
+				pipeAttacksToAdd.Empty();
+
+				// also take care of possible tremulant releases
+				wxString currentTremRootPath = m_latestPipesRootPath + wxFILE_SEP_PATH + tremulantFolders[j].name;
+				const std::vector<SampleFolderInfo> &tremReleaseFolders = tremulantFolders[j].releaseFolders;
+
+				for (unsigned k = 0; k < tremReleaseFolders.size(); k++) {
+					fillArrayStringWithFiles(sampleIndex, currentTremRootPath + wxFILE_SEP_PATH + tremReleaseFolders[k].name, pipeReleases, i);
+
+					pipeReleases.Sort();
+					onlyAddWaveFiles(pipeReleases, pipeReleasesToAdd);
+
+					// if there are any matching releases we add them
+					for (unsigned l = 0; l < pipeReleasesToAdd.GetCount(); l++) {
+						// create and add the release to the pipe
+						Release rel;
+						rel.setFullPath(pipeReleasesToAdd.Item(l));
+						rel.isTremulant = 1;
+						if (tremReleaseFolders[k].maxKeyPressTime > -1)
+							rel.maxKeyPressTime = tremReleaseFolders[k].maxKeyPressTime;
+
+						applySampleNameInfo(sampleIndex, rel);
+						p.m_releases.push_back(std::move(rel));
+					}
+
+					pipeReleases.Empty();
+					pipeReleasesToAdd.Empty();
+				}
+			}
+		}
+
+		if (task)
+			task->addItemsFound(p.m_attacks.size() + p.m_releases.size());
+
+		if (p.m_attacks.empty()) {
+			// if we don't have any other attacks for this pipe, just add a single dummy attack
+			p.m_attacks.emplace_back();
+		}
+
+		pipes.push_back(std::move(p));
+
+		if (task)
+			task->stepDone();
+	}
+
+	if (task && task->isCancelled())
+		return false;
+
+	return true;
+}
+
+
+void Rank::fillArrayStringWithFiles(SampleDirectoryIndex &index, wxString path, wxArrayString &list, int pipeIndex) {
+	index.appendFilesForMidiNote(path, pipeIndex + firstMidiNoteNumber, list);
 }
 
 void Rank::onlyAddWaveFiles(wxArrayString &source, wxArrayString &selection) {
@@ -1326,13 +1312,32 @@ void Rank::onlyAddWaveFiles(wxArrayString &source, wxArrayString &selection) {
 	}
 }
 
-wxString Rank::getOnlyFileName(wxString path) {
-	wxString name = path;
-	name.Replace(::wxGetApp().m_frame->m_organ->getOdfRoot(), wxT(""));
-	if (name.StartsWith(wxFILE_SEP_PATH))
-		name.erase(0, 1);
+bool Rank::isSampleStillPresent(wxString fullPath, wxString scannedRoot, const std::set<wxString> &scannedPaths) {
+	// samples from the scanned folder must have been found again, samples
+	// added from elsewhere are only dropped if their file is gone
+	if (fullPath.StartsWith(scannedRoot))
+		return scannedPaths.find(fullPath) != scannedPaths.end();
 
-	return name;
+	return wxFileExists(fullPath);
+}
+
+void Rank::applySampleNameInfo(SampleDirectoryIndex &index, Attack &attack) {
+	SampleNameInfo info;
+	if (!index.getSampleNameInfo(attack.getFullPath(), info))
+		return;
+
+	if (info.velocity > -1 && info.velocity < 128)
+		attack.attackVelocity = info.velocity;
+}
+
+void Rank::applySampleNameInfo(SampleDirectoryIndex &index, Release &release) {
+	SampleNameInfo info;
+	if (!index.getSampleNameInfo(release.getFullPath(), info))
+		return;
+
+	// a release time in the file name is more specific than the one of the folder
+	if (info.releaseTime > 0 && info.releaseTime < 99999)
+		release.maxKeyPressTime = info.releaseTime;
 }
 
 void Rank::setupPipeProperties(Pipe &pipe) {
@@ -1343,9 +1348,3 @@ void Rank::setupPipeProperties(Pipe &pipe) {
 	pipe.minVelocityVolume = this->minVelocityVolume;
 	pipe.maxVelocityVolume = this->maxVelocityVolume;
 }
-
-void Rank::updatePipeRelativePaths() {
-	for (Pipe& p : m_pipes) {
-		p.updateRelativePaths();
-	}
-}
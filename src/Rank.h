@@ -23,19 +23,45 @@
 
 #include "Pipe.h"
 #include "Windchestgroup.h"
+#include "SampleDirectoryIndex.h"
+#include "SampleFolderClassifier.h"
+#include "SampleMetadataCache.h"
+#include "BackgroundTask.h"
+#include "WorkerPool.h"
 #include <list>
+#include <vector>
+#include <set>
+#include <map>
 #include <wx/textfile.h>
 #include <wx/dir.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
+
+// What a task changes in one pipe of a rank. The samples of the pipe are
+// added to the pipe of the rank, or replace it when replacesPipe is set.
+class PipeChange {
+public:
+	PipeChange() : replacesPipe(false) {}
+
+	bool replacesPipe;
+	Pipe pipe;
+};
+
+// The changes of a task by the index of the pipe in the rank, they are kept
+// aside until applied so that a cancelled task leaves the rank untouched.
+typedef std::map<unsigned, PipeChange> PipeChanges;
 
 class Rank {
 public:
 	Rank();
-	~Rank();
 
 	void write(wxTextFile *outFile);
 	void writeFromStop(wxTextFile *outFile);
-	void read(wxFileConfig *cfg);
+	// the pipes can be left for readUnreadPipes() so that several ranks can have them read at
+	// once or, when an organ is opened, not until they are needed (see Organ::readUnreadPipes)
+	void read(OdfReader *cfg, bool readingPipes = true);
+	bool hasUnreadPipes() const;
+	// reads the pipes from the section the rank was read from, cfg can be any copy of that reader
+	void readUnreadPipes(OdfReader *cfg);
 
 	bool doesAcceptsRetuning() const;
 	void setAcceptsRetuning(bool acceptsRetuning);
@@ -68,30 +94,60 @@ public:
 	void setOnlyRankWindchest(Windchestgroup *windchest);
 	wxString getPipesRootPath();
 	void setPipesRootPath(wxString path);
-	void readPipes(
+	wxString getSampleFilePattern();
+	void setSampleFilePattern(wxString pattern);
+	// an index that already has the folders of the rank listed can be passed
+	// in, it must have been made with the sample file pattern of the rank
+	bool readPipes(
+		PipeChanges &changes,
+		wxString extraAttackFolder,
+		bool loadOnlyOneAttack,
+		bool loadRelease,
+		wxString releaseFolderPrefix,
+		bool extractKeyPressTime,
+		wxString tremulantFolderPrefix,
+		BackgroundTask *task = NULL,
+		SampleDirectoryIndex *sampleIndex = NULL
+	);
+	bool rescanPipes(
+		PipeChanges &changes,
 		wxString extraAttackFolder,
 		bool loadOnlyOneAttack,
 		bool loadRelease,
 		wxString releaseFolderPrefix,
 		bool extractKeyPressTime,
-		wxString tremulantFolderPrefix
+		wxString tremulantFolderPrefix,
+		SampleMetadataCache *cache,
+		BackgroundTask *task = NULL
 	);
-	void addToPipes(
+	void applyPipeChanges(PipeChanges &changes);
+	bool addToPipes(
+		PipeChanges &changes,
 		wxString extraAttackFolder,
 		bool loadOnlyOneAttack,
 		bool loadRelease,
 		wxString releaseFolderPrefix,
 		bool extractKeyPressTime,
-		wxString tremulantFolderPrefix
+		wxString tremulantFolderPrefix,
+		BackgroundTask *task = NULL
 	);
-	void addTremulantToPipes(
+	bool addTremulantToPipes(
+		PipeChanges &changes,
 		wxString extraAttackFolder,
 		bool loadOnlyOneAttack,
 		bool loadRelease,
 		wxString releaseFolderPrefix,
-		bool extractKeyPressTime
+		bool extractKeyPressTime,
+		BackgroundTask *task = NULL
 	);
-	void addReleasesToPipes();
+	bool addReleasesToPipes(PipeChanges &changes, BackgroundTask *task = NULL);
+	// fills loops and cue points of the changed pipes that aren't set yet from what the sample files contain
+	bool readLoopsAndCuesFromSamples(PipeChanges &changes, SampleMetadataCache *cache, BackgroundTask *task = NULL);
+	// the samples that readLoopsAndCuesFromSamples would need the headers of
+	void getSamplesWithoutLoopsOrCues(const PipeChanges &changes, std::vector<wxString> &fullPaths) const;
+	// gives every attack without loops the best loop a LoopFinder finds in its
+	// sample, false if cancelled or if there was no attack without loops
+	bool findMissingLoops(WorkerPool &pool, BackgroundTask *task = NULL);
 	void clearAllPipes();
 	void createDummyPipes();
 	void addDummyPipeFront();
@@ -105,7 +161,6 @@ public:
 	bool deleteAttackInPipe(unsigned pipeIndex, unsigned attackIndex);
 	void deleteReleaseInPipe(unsigned pipeIndex, unsigned releaseIndex);
 	Pipe* getPipeAt(unsigned index);
-	void updatePipeRelativePaths();
 
 	std::list<Pipe> m_pipes;
 
@@ -125,10 +180,28 @@ protected:
 	float maxVelocityVolume;
 	bool acceptsRetuning;
 	wxString m_latestPipesRootPath;
+	wxString m_sampleFilePattern;
+	wxString m_unreadPipesSection;
 
-	void fillArrayStringWithFiles(wxDir &root, wxString path, wxArrayString &list, int pipeIndex);
+	void readPipesOfSection(OdfReader *cfg);
+	void writePipes(wxTextFile *outFile);
+	bool scanPipes(
+		SampleDirectoryIndex &sampleIndex,
+		std::list<Pipe> &pipes,
+		wxString extraAttackFolder,
+		bool loadOnlyOneAttack,
+		bool loadRelease,
+		wxString releaseFolderPrefix,
+		bool extractKeyPressTime,
+		wxString tremulantFolderPrefix,
+		BackgroundTask *task
+	);
+	void fillArrayStringWithFiles(SampleDirectoryIndex &index, wxString path, wxArrayString &list, int pipeIndex);
 	void onlyAddWaveFiles(wxArrayString &source, wxArrayString &selection);
-	wxString getOnlyFileName(wxString path);
+	bool isSampleStillPresent(wxString fullPath, wxString scannedRoot, const std::set<wxString> &scannedPaths);
+	bool rescanPipe(const Pipe &existing, Pipe &scanned, wxString scannedRoot, SampleMetadataCache *cache, Pipe &merged);
+	void applySampleNameInfo(SampleDirectoryIndex &index, Attack &attack);
+	void applySampleNameInfo(SampleDirectoryIndex &index, Release &release);
 	void setupPipeProperties(Pipe &pipe);
 };
 
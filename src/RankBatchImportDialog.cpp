@@ -0,0 +1,268 @@
+/*
+ * RankBatchImportDialog.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#include "RankBatchImportDialog.h"
+#include "GOODF.h"
+#include "SamplePattern.h"
+#include <wx/statline.h>
+
+IMPLEMENT_CLASS(RankBatchImportDialog, wxDialog)
+
+RankBatchImportDialog::RankBatchImportDialog(wxString sampleSetRoot) {
+	Init(sampleSetRoot);
+}
+
+RankBatchImportDialog::RankBatchImportDialog(
+	wxString sampleSetRoot,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(sampleSetRoot);
+	Create(parent, id, caption, pos, size, style);
+}
+
+RankBatchImportDialog::~RankBatchImportDialog() {
+
+}
+
+void RankBatchImportDialog::Init(wxString sampleSetRoot) {
+	m_sampleSetRoot = sampleSetRoot;
+
+	m_targetList.Add(wxT("Ranks in organ"));
+	m_targetList.Add(wxT("Whole organ with a manual and windchest for each division folder"));
+	unsigned nbrManuals = ::wxGetApp().m_frame->m_organ->getNumberOfManuals();
+	for (unsigned i = 0; i < nbrManuals; i++) {
+		m_targetList.Add(wxT("Stops with internal rank in ") + ::wxGetApp().m_frame->m_organ->getOrganManualAt(i)->getName());
+	}
+}
+
+bool RankBatchImportDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void RankBatchImportDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *rootText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Each folder with samples in ") + m_sampleSetRoot + wxT(" will become a rank.")
+	);
+	firstRow->Add(rootText, 1, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW);
+
+	wxBoxSizer *patternRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *patternText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Sample name pattern: ")
+	);
+	patternRow->Add(patternText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_patternField = new wxTextCtrl(
+		this,
+		wxID_ANY,
+		DEFAULT_SAMPLE_PATTERN
+	);
+	patternRow->Add(m_patternField, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(patternRow, 0, wxGROW);
+
+	wxBoxSizer *secondRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *attackText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Extra attack subfolder: ")
+	);
+	secondRow->Add(attackText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_attackField = new wxTextCtrl(
+		this,
+		wxID_ANY,
+		wxEmptyString
+	);
+	secondRow->Add(m_attackField, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(secondRow, 0, wxGROW);
+
+	wxBoxSizer *thirdRow = new wxBoxSizer(wxHORIZONTAL);
+	m_onlyOneAttack = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxT("Load only one attack")
+	);
+	m_onlyOneAttack->SetValue(false);
+	thirdRow->Add(m_onlyOneAttack, 0, wxALL, 5);
+	m_loadReleaseInAttack = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxT("Load release in attack")
+	);
+	m_loadReleaseInAttack->SetValue(true);
+	thirdRow->Add(m_loadReleaseInAttack, 0, wxALL, 5);
+	mainSizer->Add(thirdRow, 0, wxGROW);
+
+	wxBoxSizer *fourthRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *releaseText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Release subfolder prefix: ")
+	);
+	fourthRow->Add(releaseText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_releaseField = new wxTextCtrl(
+		this,
+		wxID_ANY,
+		wxT("rel")
+	);
+	fourthRow->Add(m_releaseField, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(fourthRow, 0, wxGROW);
+
+	wxBoxSizer *fifthRow = new wxBoxSizer(wxHORIZONTAL);
+	m_keyPressTime = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxT("Extract MaxKeyPressTime from foldername")
+	);
+	m_keyPressTime->SetValue(true);
+	fifthRow->Add(m_keyPressTime, 0, wxALL, 5);
+	fifthRow->AddStretchSpacer();
+	m_readLoopsAndCues = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxT("Read loops and cue points from samples")
+	);
+	m_readLoopsAndCues->SetValue(false);
+	fifthRow->Add(m_readLoopsAndCues, 0, wxALL, 5);
+	mainSizer->Add(fifthRow, 0, wxGROW);
+
+	wxBoxSizer *sixthRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *tremulantText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Tremulant subfolder prefix: ")
+	);
+	sixthRow->Add(tremulantText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_tremulantField = new wxTextCtrl(
+		this,
+		wxID_ANY,
+		wxT("trem")
+	);
+	sixthRow->Add(m_tremulantField, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(sixthRow, 0, wxGROW);
+
+	wxBoxSizer *seventhRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *targetText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxT("Create: ")
+	);
+	seventhRow->Add(targetText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_targetChoice = new wxChoice(
+		this,
+		wxID_ANY,
+		wxDefaultPosition,
+		wxDefaultSize,
+		m_targetList
+	);
+	m_targetChoice->SetSelection(0);
+	seventhRow->Add(m_targetChoice, 1, wxGROW|wxALL, 5);
+	mainSizer->Add(seventhRow, 0, wxGROW);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Import ranks")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+wxString RankBatchImportDialog::GetExtraAttackFolder() {
+	return m_attackField->GetValue();
+}
+
+bool RankBatchImportDialog::GetLoadOnlyOneAttack() {
+	return m_onlyOneAttack->GetValue();
+}
+
+bool RankBatchImportDialog::GetLoadRelease() {
+	return m_loadReleaseInAttack->GetValue();
+}
+
+wxString RankBatchImportDialog::GetReleaseFolderPrefix() {
+	return m_releaseField->GetValue();
+}
+
+bool RankBatchImportDialog::GetExtractKeyPressTime() {
+	return m_keyPressTime->GetValue();
+}
+
+bool RankBatchImportDialog::GetReadLoopsAndCues() {
+	return m_readLoopsAndCues->GetValue();
+}
+
+wxString RankBatchImportDialog::GetTremulantFolderPrefix() {
+	return m_tremulantField->GetValue();
+}
+
+wxString RankBatchImportDialog::GetSampleFilePattern() {
+	return m_patternField->GetValue();
+}
+
+int RankBatchImportDialog::GetTargetManual() {
+	if (m_targetChoice->GetSelection() < 2)
+		return -1;
+	return m_targetChoice->GetSelection() - 2;
+}
+
+bool RankBatchImportDialog::GetBuildWholeOrgan() {
+	return m_targetChoice->GetSelection() == 1;
+}
@@ -0,0 +1,91 @@
+/*
+ * RankBatchImportDialog.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#ifndef RANKBATCHIMPORTDIALOG_H
+#define RANKBATCHIMPORTDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/checkbox.h>
+
+class RankBatchImportDialog : public wxDialog {
+	DECLARE_CLASS(RankBatchImportDialog)
+
+public:
+	// Constructors
+	RankBatchImportDialog(wxString sampleSetRoot);
+	RankBatchImportDialog(
+		wxString sampleSetRoot,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Batch Import Ranks"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~RankBatchImportDialog();
+
+	// Initialize our variables
+	void Init(wxString sampleSetRoot);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Batch Import Ranks"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	wxString GetExtraAttackFolder();
+	bool GetLoadOnlyOneAttack();
+	bool GetLoadRelease();
+	wxString GetReleaseFolderPrefix();
+	bool GetExtractKeyPressTime();
+	bool GetReadLoopsAndCues();
+	wxString GetTremulantFolderPrefix();
+	wxString GetSampleFilePattern();
+	// -1 means organ ranks, otherwise stops with internal ranks are created in this manual
+	int GetTargetManual();
+	// windchests, manuals, ranks and stops are all created from the folders
+	bool GetBuildWholeOrgan();
+
+private:
+	wxString m_sampleSetRoot;
+	wxArrayString m_targetList;
+
+	wxTextCtrl *m_attackField;
+	wxCheckBox *m_onlyOneAttack;
+	wxCheckBox *m_loadReleaseInAttack;
+	wxTextCtrl *m_releaseField;
+	wxCheckBox *m_keyPressTime;
+	wxCheckBox *m_readLoopsAndCues;
+	wxTextCtrl *m_tremulantField;
+	wxTextCtrl *m_patternField;
+	wxChoice *m_targetChoice;
+};
+
+#endif
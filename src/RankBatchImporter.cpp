@@ -0,0 +1,237 @@
+/*
+ * RankBatchImporter.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#include "RankBatchImporter.h"
+#include "SampleHeaderPrefetcher.h"
+#include <algorithm>
+
+// rank folders are not searched for deeper than this below the sample set root
+#define MAX_RANK_FOLDER_DEPTH 3
+
+RankBatchImporter::RankBatchImporter(wxString sampleSetRoot) {
+	m_sampleSetRoot = sampleSetRoot;
+	m_extraAttackFolder = wxEmptyString;
+	m_loadOnlyOneAttack = false;
+	m_loadRelease = true;
+	m_releaseFolderPrefix = wxT("rel");
+	m_extractKeyPressTime = true;
+	m_tremulantFolderPrefix = wxT("trem");
+	m_sampleMetadataCache = NULL;
+}
+
+RankBatchImporter::~RankBatchImporter() {
+
+}
+
+void RankBatchImporter::setReadingOptions(
+	wxString extraAttackFolder,
+	bool loadOnlyOneAttack,
+	bool loadRelease,
+	wxString releaseFolderPrefix,
+	bool extractKeyPressTime,
+	wxString tremulantFolderPrefix
+) {
+	m_extraAttackFolder = extraAttackFolder;
+	m_loadOnlyOneAttack = loadOnlyOneAttack;
+	m_loadRelease = loadRelease;
+	m_releaseFolderPrefix = releaseFolderPrefix;
+	m_extractKeyPressTime = extractKeyPressTime;
+	m_tremulantFolderPrefix = tremulantFolderPrefix;
+}
+
+bool RankBatchImporter::setSampleFilePattern(wxString pattern) {
+	m_pattern = SamplePattern(pattern);
+	return m_pattern.isValid();
+}
+
+void RankBatchImporter::setSampleMetadataCache(SampleMetadataCache *cache) {
+	m_sampleMetadataCache = cache;
+}
+
+bool RankBatchImporter::importRanks(WorkerPool &pool, BackgroundTask *task) {
+	m_ranks.clear();
+
+	if (!m_pattern.isValid())
+		return false;
+
+	// release and tremulant folders are never taken for ranks of their own
+	SampleFolderClassifier folderClassifier(m_releaseFolderPrefix, m_tremulantFolderPrefix, false);
+
+	// the root is listed here and the folders below it are then walked at the same time
+	std::vector<RankFolder> rankFolders;
+	wxArrayString topFolders;
+	findRankFolders(folderClassifier, m_sampleSetRoot, 0, rankFolders, &topFolders);
+
+	std::vector<std::vector<RankFolder>> foundInTopFolder(topFolders.GetCount());
+	pool.parallelFor(topFolders.GetCount(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+
+		findRankFolders(folderClassifier, topFolders.Item(i), 1, foundInTopFolder[i], NULL);
+	});
+
+	if (task && task->isCancelled())
+		return false;
+
+	for (std::vector<RankFolder>& found : foundInTopFolder) {
+		for (RankFolder& folder : found)
+			rankFolders.push_back(std::move(folder));
+	}
+	if (rankFolders.empty())
+		return false;
+
+	std::sort(rankFolders.begin(), rankFolders.end(), [](const RankFolder &a, const RankFolder &b) {
+		return a.path.Cmp(b.path) < 0;
+	});
+
+	// the midi range was found during the walk so the amount of work is already known
+	unsigned nbrFolders = rankFolders.size();
+	std::vector<Rank> ranks(nbrFolders);
+	std::vector<char> rankIsUsable(nbrFolders, 1);
+	std::vector<PipeChanges> pipeChanges(nbrFolders);
+	int totalPipes = 0;
+	for (unsigned i = 0; i < nbrFolders; i++) {
+		Rank &rank = ranks[i];
+		rank.setName(rankFolders[i].path.AfterLast(wxFILE_SEP_PATH));
+		rank.setFirstMidiNoteNumber(rankFolders[i].firstMidiNote);
+		rank.setNumberOfLogicalPipes(rankFolders[i].lastMidiNote - rankFolders[i].firstMidiNote + 1);
+		rank.setPipesRootPath(rankFolders[i].path);
+		rank.setSampleFilePattern(m_pattern.getPattern());
+		totalPipes += rank.getNumberOfLogicalPipes();
+	}
+
+	if (task)
+		task->setTotalSteps(totalPipes);
+
+	// then all the ranks read their pipes at the same time
+	pool.parallelFor(nbrFolders, [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+
+		if (!ranks[i].readPipes(
+			pipeChanges[i],
+			m_extraAttackFolder,
+			m_loadOnlyOneAttack,
+			m_loadRelease,
+			m_releaseFolderPrefix,
+			m_extractKeyPressTime,
+			m_tremulantFolderPrefix,
+			task,
+			rankFolders[i].index.get()
+		)) {
+			rankIsUsable[i] = 0;
+		}
+		rankFolders[i].index.reset();
+	});
+
+	if (task && task->isCancelled())
+		return false;
+
+	if (m_sampleMetadataCache && !readLoopsAndCues(ranks, pipeChanges, rankIsUsable, pool, totalPipes, task))
+		return false;
+
+	for (unsigned i = 0; i < nbrFolders; i++) {
+		if (rankIsUsable[i]) {
+			ranks[i].applyPipeChanges(pipeChanges[i]);
+			m_ranks.push_back(std::move(ranks[i]));
+		}
+	}
+
+	return !m_ranks.empty();
+}
+
+bool RankBatchImporter::readLoopsAndCues(std::vector<Rank> &ranks, std::vector<PipeChanges> &pipeChanges, const std::vector<char> &rankIsUsable, WorkerPool &pool, int totalPipes, BackgroundTask *task) {
+	// the headers of all the ranks are fetched together so the queue of reads stays deep
+	std::vector<wxString> fullPaths;
+	for (unsigned i = 0; i < ranks.size(); i++) {
+		if (rankIsUsable[i])
+			ranks[i].getSamplesWithoutLoopsOrCues(pipeChanges[i], fullPaths);
+	}
+	if (task)
+		task->setTotalSteps(totalPipes * 2 + fullPaths.size());
+
+	SampleHeaderPrefetcher prefetcher(m_sampleMetadataCache);
+	if (!prefetcher.warmCache(fullPaths, task))
+		return false;
+
+	// then the ranks are filled from the cache
+	pool.parallelFor(ranks.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+
+		if (rankIsUsable[i])
+			ranks[i].readLoopsAndCuesFromSamples(pipeChanges[i], m_sampleMetadataCache, task);
+	});
+
+	return !(task && task->isCancelled());
+}
+
+unsigned RankBatchImporter::getNumberOfImportedRanks() {
+	return m_ranks.size();
+}
+
+Rank* RankBatchImporter::getImportedRankAt(unsigned index) {
+	return &m_ranks[index];
+}
+
+wxString RankBatchImporter::getSampleSetRoot() {
+	return m_sampleSetRoot;
+}
+
+void RankBatchImporter::findRankFolders(
+	const SampleFolderClassifier &folderClassifier,
+	wxString folderPath,
+	int depth,
+	std::vector<RankFolder> &rankFolders,
+	wxArrayString *foldersToWalkLater
+) {
+	// every folder is only listed once, both for its samples and its subfolders,
+	// and the index that listed a rank folder is kept for reading its pipes
+	RankFolder rankFolder;
+	rankFolder.path = folderPath;
+	rankFolder.firstMidiNote = 128;
+	rankFolder.lastMidiNote = -1;
+	rankFolder.index = std::make_shared<SampleDirectoryIndex>(0, 128, m_pattern.getPattern());
+	rankFolder.index->extendMidiNoteRange(folderPath, rankFolder.firstMidiNote, rankFolder.lastMidiNote);
+	if (m_extraAttackFolder != wxEmptyString)
+		rankFolder.index->extendMidiNoteRange(folderPath + wxFILE_SEP_PATH + m_extraAttackFolder, rankFolder.firstMidiNote, rankFolder.lastMidiNote);
+
+	// a folder with samples in it (or in its extra attack folder) is a rank
+	if (rankFolder.lastMidiNote > -1) {
+		rankFolders.push_back(rankFolder);
+		return;
+	}
+
+	if (depth >= MAX_RANK_FOLDER_DEPTH)
+		return;
+
+	const wxArrayString &subFolders = rankFolder.index->getSubFolders(folderPath);
+	for (unsigned i = 0; i < subFolders.GetCount(); i++) {
+		if (folderClassifier.classifyFolder(subFolders.Item(i)).type != FOLDER_ATTACK)
+			continue;
+
+		wxString subFolderPath = folderPath + wxFILE_SEP_PATH + subFolders.Item(i);
+		if (foldersToWalkLater)
+			foldersToWalkLater->Add(subFolderPath);
+		else
+			findRankFolders(folderClassifier, subFolderPath, depth + 1, rankFolders, NULL);
+	}
+}
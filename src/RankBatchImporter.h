@@ -0,0 +1,96 @@
+/*
+ * RankBatchImporter.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#ifndef RANKBATCHIMPORTER_H
+#define RANKBATCHIMPORTER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <memory>
+#include "Rank.h"
+#include "BackgroundTask.h"
+#include "SamplePattern.h"
+#include "WorkerPool.h"
+
+// Finds all rank folders below a sample set root and reads the pipes of
+// every rank in parallel with the same folder rules as Rank::readPipes. The
+// folders below the root are walked in parallel too and each folder is only
+// listed once, which also gives the midi range of the ranks.
+class RankBatchImporter {
+public:
+	RankBatchImporter(wxString sampleSetRoot);
+	~RankBatchImporter();
+
+	void setReadingOptions(
+		wxString extraAttackFolder,
+		bool loadOnlyOneAttack,
+		bool loadRelease,
+		wxString releaseFolderPrefix,
+		bool extractKeyPressTime,
+		wxString tremulantFolderPrefix
+	);
+	bool setSampleFilePattern(wxString pattern);
+	// with a cache the loops and cue points are also read from the samples
+	void setSampleMetadataCache(SampleMetadataCache *cache);
+	bool importRanks(WorkerPool &pool, BackgroundTask *task = NULL);
+	unsigned getNumberOfImportedRanks();
+	Rank* getImportedRankAt(unsigned index);
+	wxString getSampleSetRoot();
+
+private:
+	wxString m_sampleSetRoot;
+	wxString m_extraAttackFolder;
+	bool m_loadOnlyOneAttack;
+	bool m_loadRelease;
+	wxString m_releaseFolderPrefix;
+	bool m_extractKeyPressTime;
+	wxString m_tremulantFolderPrefix;
+	SamplePattern m_pattern;
+	SampleMetadataCache *m_sampleMetadataCache;
+	std::vector<Rank> m_ranks;
+
+	class RankFolder {
+	public:
+		wxString path;
+		int firstMidiNote;
+		int lastMidiNote;
+		// the folders listed while looking for the rank, used again to read its pipes
+		std::shared_ptr<SampleDirectoryIndex> index;
+	};
+
+	void findRankFolders(
+		const SampleFolderClassifier &folderClassifier,
+		wxString folderPath,
+		int depth,
+		std::vector<RankFolder> &rankFolders,
+		wxArrayString *foldersToWalkLater
+	);
+	bool readLoopsAndCues(
+		std::vector<Rank> &ranks,
+		std::vector<PipeChanges> &pipeChanges,
+		const std::vector<char> &rankIsUsable,
+		WorkerPool &pool,
+		int totalPipes,
+		BackgroundTask *task
+	);
+};
+
+#endif
@@ -0,0 +1,223 @@
+/*
+ * RankGainAnalyser.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "RankGainAnalyser.h"
+#include "SampleAudioReader.h"
+#include "AudioKernels.h"
+#include <algorithm>
+#include <cmath>
+
+PipeGainAnalysis::PipeGainAnalysis() {
+	pipeNumber = 0;
+	samplePath = wxEmptyString;
+	isAnalysed = false;
+	errorMessage = wxEmptyString;
+	peak = 0;
+	rms = 0;
+	loudness = 0;
+	amplitudeLevel = 100;
+	currentGain = 0;
+	suggestedGain = 0;
+}
+
+RankGainAnalyser::RankGainAnalyser(Rank *rank) {
+	unsigned pipeNumber = 0;
+	for (const Pipe& pipe : rank->m_pipes) {
+		pipeNumber++;
+		PipeGainAnalysis analysis;
+		analysis.pipeNumber = pipeNumber;
+		analysis.amplitudeLevel = pipe.amplitudeLevel;
+		analysis.currentGain = pipe.gain;
+		analysis.suggestedGain = pipe.gain;
+
+		// the main attack is the first one with a sample of its own that isn't for the tremulant
+		AnalysedAttack attack;
+		attack.attackStart = 0;
+		attack.cuePoint = -1;
+		const Attack *mainAttack = NULL;
+		for (const Attack& atk : pipe.m_attacks) {
+			if (atk.isDummy() || atk.isReference())
+				continue;
+			if (!mainAttack || (mainAttack->isTremulant == 1 && atk.isTremulant != 1))
+				mainAttack = &atk;
+		}
+		if (mainAttack) {
+			analysis.samplePath = mainAttack->getFullPath();
+			attack.fullPath = mainAttack->getFullPath();
+			attack.attackStart = mainAttack->attackStart;
+			attack.cuePoint = mainAttack->cuePoint;
+			attack.loops.assign(mainAttack->m_loops.begin(), mainAttack->m_loops.end());
+		} else {
+			analysis.errorMessage = wxT("The pipe has no sample of its own.");
+		}
+
+		m_pipes.push_back(analysis);
+		m_attacks.push_back(attack);
+	}
+}
+
+RankGainAnalyser::~RankGainAnalyser() {
+
+}
+
+bool RankGainAnalyser::analyse(WorkerPool &pool, BackgroundTask *task) {
+	if (task)
+		task->setTotalSteps(m_pipes.size());
+
+	pool.parallelFor(m_pipes.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+		if (m_attacks[i].fullPath != wxEmptyString)
+			analysePipe(m_pipes[i], m_attacks[i]);
+		if (task)
+			task->stepDone();
+	});
+
+	if (task && task->isCancelled())
+		return false;
+
+	suggestGains();
+	return true;
+}
+
+unsigned RankGainAnalyser::getNumberOfPipes() {
+	return m_pipes.size();
+}
+
+const PipeGainAnalysis& RankGainAnalyser::getPipeAnalysisAt(unsigned index) {
+	return m_pipes[index];
+}
+
+unsigned RankGainAnalyser::getNumberOfAnalysedPipes() {
+	unsigned count = 0;
+	for (const PipeGainAnalysis& pipe : m_pipes) {
+		if (pipe.isAnalysed)
+			count++;
+	}
+	return count;
+}
+
+void RankGainAnalyser::applySuggestedGains(Rank *rank) {
+	unsigned index = 0;
+	for (Pipe& pipe : rank->m_pipes) {
+		if (index >= m_pipes.size())
+			break;
+		if (m_pipes[index].isAnalysed)
+			pipe.gain = m_pipes[index].suggestedGain;
+		index++;
+	}
+}
+
+void RankGainAnalyser::analysePipe(PipeGainAnalysis &pipe, const AnalysedAttack &attack) {
+	SampleAudioReader reader;
+	if (!reader.open(attack.fullPath)) {
+		pipe.errorMessage = reader.getErrorMessage();
+		return;
+	}
+
+	// the looped region, or the middle of the sample up to the cue point when there are no loops
+	unsigned numberOfFrames = reader.getNumberOfFrames();
+	unsigned regionStart;
+	unsigned regionEnd;
+	bool hasRegion = reader.getSustainRegion(attack.attackStart, attack.cuePoint, regionStart, regionEnd);
+	if (!attack.loops.empty()) {
+		regionStart = numberOfFrames;
+		regionEnd = 0;
+		for (const Loop& loop : attack.loops) {
+			if (loop.start < 0 || loop.end <= loop.start || (unsigned) loop.end >= numberOfFrames)
+				continue;
+			regionStart = std::min(regionStart, (unsigned) loop.start);
+			regionEnd = std::max(regionEnd, (unsigned) loop.end + 1);
+		}
+		if (regionStart < (unsigned) std::max(attack.attackStart, 0) && (unsigned) attack.attackStart < regionEnd)
+			regionStart = attack.attackStart;
+		hasRegion = regionStart < regionEnd;
+	}
+	if (!hasRegion) {
+		pipe.errorMessage = wxT("The sample has no sustained part to measure.");
+		return;
+	}
+
+	// a few seconds are plenty for a steady tone and the filter gets a tenth of a second to settle first
+	unsigned sampleRate = reader.getSampleRate();
+	unsigned channels = reader.getNumberOfChannels();
+	unsigned regionLength = std::min(regionEnd - regionStart, sampleRate * 8);
+	unsigned warmUp = std::min(regionStart, sampleRate / 10);
+	std::vector<float> samples;
+	if (!reader.readFrames(regionStart - warmUp, warmUp + regionLength, samples)) {
+		pipe.errorMessage = reader.getErrorMessage();
+		return;
+	}
+	// a truncated file can give fewer frames than asked for, even fewer than the warm up
+	size_t framesRead = channels ? samples.size() / channels : 0;
+	if (framesRead <= warmUp) {
+		pipe.errorMessage = wxT("The sample ended before its sustained part.");
+		return;
+	}
+	regionLength = framesRead - warmUp;
+
+	const float *region = samples.data() + (size_t) warmUp * channels;
+	size_t regionSamples = (size_t) regionLength * channels;
+	pipe.peak = AudioKernels::toDecibels(AudioKernels::peakAbs(region, regionSamples));
+	pipe.rms = AudioKernels::toDecibels(std::sqrt(AudioKernels::sumOfSquares(region, regionSamples) / regionSamples));
+
+	// the loudness sums the mean square of all channels as BS.1770 does for the front channels
+	for (unsigned ch = 0; ch < channels; ch++)
+		AudioKernels::applyKWeighting(samples.data(), samples.size() / channels, ch, channels, sampleRate);
+	double meanSquare = AudioKernels::sumOfSquares(region, regionSamples) / regionLength;
+	pipe.loudness = -0.691 + AudioKernels::toDecibels(std::sqrt(meanSquare));
+	pipe.isAnalysed = true;
+}
+
+void RankGainAnalyser::suggestGains() {
+	// the level each pipe sounds at now, with its amplitude level and gain
+	std::vector<double> levels(m_pipes.size(), 0);
+	for (unsigned i = 0; i < m_pipes.size(); i++) {
+		PipeGainAnalysis &pipe = m_pipes[i];
+		if (pipe.isAnalysed && pipe.amplitudeLevel <= 0) {
+			pipe.isAnalysed = false;
+			pipe.errorMessage = wxT("The pipe is silenced by its amplitude level.");
+		}
+		if (pipe.isAnalysed)
+			levels[i] = pipe.loudness + pipe.currentGain + AudioKernels::toDecibels(pipe.amplitudeLevel / 100.0);
+	}
+
+	const int neighbours = 3;
+	for (int i = 0; i < (int) m_pipes.size(); i++) {
+		PipeGainAnalysis &pipe = m_pipes[i];
+		if (!pipe.isAnalysed)
+			continue;
+
+		std::vector<double> nearby;
+		for (int j = std::max(0, i - neighbours); j <= std::min((int) m_pipes.size() - 1, i + neighbours); j++) {
+			if (m_pipes[j].isAnalysed)
+				nearby.push_back(levels[j]);
+		}
+		std::sort(nearby.begin(), nearby.end());
+		double target = nearby[nearby.size() / 2];
+		if (nearby.size() % 2 == 0)
+			target = (target + nearby[nearby.size() / 2 - 1]) / 2;
+
+		// rounded to a tenth of a dB and kept within what a pipe gain can be
+		double gain = pipe.currentGain + target - levels[i];
+		gain = std::round(gain * 10) / 10;
+		pipe.suggestedGain = (float) std::max(-120.0, std::min(40.0, gain));
+	}
+}
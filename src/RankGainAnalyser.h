@@ -0,0 +1,86 @@
+/*
+ * RankGainAnalyser.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RANKGAINANALYSER_H
+#define RANKGAINANALYSER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "Rank.h"
+#include "BackgroundTask.h"
+#include "WorkerPool.h"
+
+// The levels measured for the main attack of one pipe. The pipe number is 1
+// based. Peak and rms are in dBFS and the loudness in LUFS, all measured over
+// the sustained part of the sample before any gain of the pipe is applied.
+class PipeGainAnalysis {
+public:
+	PipeGainAnalysis();
+
+	unsigned pipeNumber;
+	wxString samplePath;
+	bool isAnalysed;
+	wxString errorMessage;
+	double peak;
+	double rms;
+	double loudness;
+	float amplitudeLevel;
+	float currentGain;
+	float suggestedGain;
+};
+
+// Measures the main attack of every pipe of a rank and suggests a gain for
+// each pipe that evens out the loudness of the rank. The sustained part is
+// taken to be the looped region of the attack, or the middle of the sample
+// if it has no loops. Each pipe is aimed at the median loudness of its
+// neighbours so that the overall voicing of the rank, like a treble that is
+// brighter or a bass that is softer, is kept while single pipes that stick
+// out are brought in line. Only the gain is suggested, the amplitude level of
+// the pipes is left as it is.
+class RankGainAnalyser {
+public:
+	RankGainAnalyser(Rank *rank);
+	~RankGainAnalyser();
+
+	// false if cancelled
+	bool analyse(WorkerPool &pool, BackgroundTask *task = NULL);
+	unsigned getNumberOfPipes();
+	const PipeGainAnalysis& getPipeAnalysisAt(unsigned index);
+	unsigned getNumberOfAnalysedPipes();
+	// sets the suggested gain of every analysed pipe to the rank it was made from
+	void applySuggestedGains(Rank *rank);
+
+private:
+	class AnalysedAttack {
+	public:
+		wxString fullPath;
+		int attackStart;
+		int cuePoint;
+		std::vector<Loop> loops;
+	};
+
+	std::vector<PipeGainAnalysis> m_pipes;
+	std::vector<AnalysedAttack> m_attacks;
+
+	void analysePipe(PipeGainAnalysis &pipe, const AnalysedAttack &attack);
+	void suggestGains();
+};
+
+#endif
@@ -31,6 +31,16 @@
 #include "AttackDialog.h"
 #include "StopPanel.h"
 #include "PipeBorrowingDialog.h"
+#include "BackgroundTask.h"
+#include "SampleHeaderPrefetcher.h"
+#include "RankGainAnalyser.h"
+#include "PipeGainDialog.h"
+#include "RankPitchAnalyser.h"
+#include "PipePitchDialog.h"
+#include "AttackStartFinder.h"
+#include "AttackStartDialog.h"
+#include "ReleaseMarkerFinder.h"
+#include "ReleaseMarkerDialog.h"
 
 // Event table
 BEGIN_EVENT_TABLE(RankPanel, wxPanel)
@@ -47,6 +57,7 @@ BEGIN_EVENT_TABLE(RankPanel, wxPanel)
 	EVT_RADIOBUTTON(ID_RANK_ACC_RETUNING_YES, RankPanel::OnRetuningSelection)
 	EVT_RADIOBUTTON(ID_RANK_ACC_RETUNING_NO, RankPanel::OnRetuningSelection)
 	EVT_BUTTON(ID_RANK_READ_PIPES_BTN, RankPanel::OnReadPipesBtn)
+	EVT_BUTTON(ID_RANK_RESCAN_PIPES_BTN, RankPanel::OnRescanPipesBtn)
 	EVT_BUTTON(ID_RANK_REMOVE_BTN, RankPanel::OnRemoveRankBtn)
 	EVT_BUTTON(ID_RANK_CLEAR_PIPES, RankPanel::OnClearPipesBtn)
 	EVT_TREE_ITEM_RIGHT_CLICK(ID_RANK_PIPE_TREE, RankPanel::OnPipeTreeItemRightClick)
@@ -57,6 +68,11 @@ BEGIN_EVENT_TABLE(RankPanel, wxPanel)
 	EVT_BUTTON(ID_RANK_ADD_PIPES_BTN, RankPanel::OnAddPipesBtn)
 	EVT_BUTTON(ID_RANK_ADD_TREMULANT_PIPES_BTN, RankPanel::OnAddTremulantPipesBtn)
 	EVT_BUTTON(ID_RANK_EXPAND_TREE_BTN, RankPanel::OnExpandTreeBtn)
+	EVT_BUTTON(ID_RANK_SUGGEST_GAINS_BTN, RankPanel::OnSuggestGainsBtn)
+	EVT_BUTTON(ID_RANK_FIND_LOOPS_BTN, RankPanel::OnFindLoopsBtn)
+	EVT_BUTTON(ID_RANK_MEASURE_PITCH_BTN, RankPanel::OnMeasurePitchBtn)
+	EVT_BUTTON(ID_RANK_FIND_ATTACK_STARTS_BTN, RankPanel::OnFindAttackStartsBtn)
+	EVT_BUTTON(ID_RANK_FIND_RELEASE_MARKERS_BTN, RankPanel::OnFindReleaseMarkersBtn)
 	EVT_BUTTON(ID_RANK_ADD_RELEASES_BTN, RankPanel::OnAddReleaseSamplesBtn)
 END_EVENT_TABLE()
 
@@ -362,6 +378,39 @@ RankPanel::RankPanel(wxWindow *parent) : wxPanel(parent) {
 	sixthRow->Add(m_acceptsRetuningNo, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
 	panelSizer->Add(sixthRow, 0, wxGROW);
 
+	wxStaticBoxSizer *analysisRow = new wxStaticBoxSizer(wxHORIZONTAL, this, wxT("Analyse the samples of the rank"));
+	m_suggestGainsBtn = new wxButton(
+		analysisRow->GetStaticBox(),
+		ID_RANK_SUGGEST_GAINS_BTN,
+		wxT("Suggest pipe gains...")
+	);
+	analysisRow->Add(m_suggestGainsBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_findLoopsBtn = new wxButton(
+		analysisRow->GetStaticBox(),
+		ID_RANK_FIND_LOOPS_BTN,
+		wxT("Find missing loops")
+	);
+	analysisRow->Add(m_findLoopsBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_measurePitchBtn = new wxButton(
+		analysisRow->GetStaticBox(),
+		ID_RANK_MEASURE_PITCH_BTN,
+		wxT("Measure pipe pitches...")
+	);
+	analysisRow->Add(m_measurePitchBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_findAttackStartsBtn = new wxButton(
+		analysisRow->GetStaticBox(),
+		ID_RANK_FIND_ATTACK_STARTS_BTN,
+		wxT("Find attack starts...")
+	);
+	analysisRow->Add(m_findAttackStartsBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	m_findReleaseMarkersBtn = new wxButton(
+		analysisRow->GetStaticBox(),
+		ID_RANK_FIND_RELEASE_MARKERS_BTN,
+		wxT("Find release markers...")
+	);
+	analysisRow->Add(m_findReleaseMarkersBtn, 0, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	panelSizer->Add(analysisRow, 0, wxGROW|wxALL, 5);
+
 	wxBoxSizer *seventhRow = new wxBoxSizer(wxHORIZONTAL);
 	m_pipeTreeCtrl = new wxTreeCtrl(
 		this,
@@ -381,6 +430,13 @@ RankPanel::RankPanel(wxWindow *parent) : wxPanel(parent) {
 	);
 	actionButtons->Add(readPipesFromFolderBtn, 0, wxALL, 5);
 	actionButtons->AddStretchSpacer();
+	wxButton *rescanPipesBtn = new wxButton(
+		this,
+		ID_RANK_RESCAN_PIPES_BTN,
+		wxT("Rescan for changed samples")
+	);
+	actionButtons->Add(rescanPipesBtn, 0, wxALL, 5);
+	actionButtons->AddStretchSpacer();
 	wxButton *clearPipesBtn = new wxButton(
 		this,
 		ID_RANK_CLEAR_PIPES,
@@ -452,6 +508,16 @@ RankPanel::RankPanel(wxWindow *parent) : wxPanel(parent) {
 	);
 	m_optionsKeyPressTime->SetValue(true);
 	optionsRow3->Add(m_optionsKeyPressTime, 0, wxALL, 2);
+	optionsRow3->AddStretchSpacer();
+	m_optionsReadLoopsAndCues = new wxCheckBox(
+		readingOptions->GetStaticBox(),
+		ID_RANK_READ_LOOPS_CUES_OPTION,
+		wxT("Read loops and cue points from samples"),
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_optionsReadLoopsAndCues->SetValue(false);
+	optionsRow3->Add(m_optionsReadLoopsAndCues, 0, wxALL, 2);
 	readingOptions->Add(optionsRow3, 0, wxGROW);
 	wxBoxSizer *optionsRow4 = new wxBoxSizer(wxHORIZONTAL);
 	wxStaticText *tremulantFolderText = new wxStaticText (
@@ -469,6 +535,23 @@ RankPanel::RankPanel(wxWindow *parent) : wxPanel(parent) {
 	);
 	optionsRow4->Add(m_optionsTremulantField, 1, wxEXPAND|wxALL, 4);
 	readingOptions->Add(optionsRow4, 0, wxGROW);
+	wxBoxSizer *optionsRowPattern = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *patternText = new wxStaticText (
+		readingOptions->GetStaticBox(),
+		wxID_STATIC,
+		wxT("Sample name pattern: ")
+	);
+	optionsRowPattern->Add(patternText, 0, wxALIGN_CENTER_VERTICAL|wxALL, 2);
+	m_optionsPatternField = new wxTextCtrl(
+		readingOptions->GetStaticBox(),
+		ID_RANK_SAMPLE_PATTERN_TEXT,
+		DEFAULT_SAMPLE_PATTERN,
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_optionsPatternField->SetToolTip(wxT("{midi} or {midi:03} = midi note, {vel} = velocity, {rel} = release time in ms, {name} = any text, * = any text, {wav|wv} = alternatives"));
+	optionsRowPattern->Add(m_optionsPatternField, 1, wxEXPAND|wxALL, 4);
+	readingOptions->Add(optionsRowPattern, 0, wxGROW);
 	wxBoxSizer *optionsRow5 = new wxBoxSizer(wxHORIZONTAL);
 	m_addPipesFromFolderBtn = new wxButton(
 		readingOptions->GetStaticBox(),
@@ -521,7 +604,11 @@ RankPanel::~RankPanel() {
 }
 
 void RankPanel::setRank(Rank *rank) {
+	// the pipes of an opened organ may not have been needed until now
+	::wxGetApp().m_frame->m_organ->readUnreadPipes(rank);
+	::wxGetApp().m_frame->ReportCaseFoldedPaths();
 	m_rank = rank;
+	m_optionsPatternField->ChangeValue(m_rank->getSampleFilePattern());
 
 	// update/populate available windchests
 	if (!availableWindchests.IsEmpty())
@@ -707,6 +794,9 @@ void RankPanel::OnRetuningSelection(wxCommandEvent& event) {
 }
 
 void RankPanel::OnReadPipesBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (!ApplySampleFilePattern())
+		return;
+
 	wxString defaultPath;
 	if (m_rank->getPipesRootPath() != wxEmptyString)
 		defaultPath = m_rank->getPipesRootPath();
@@ -721,6 +811,7 @@ void RankPanel::OnReadPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 	);
 
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
+		wxString previousPipesRootPath = m_rank->getPipesRootPath();
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
 		wxString extraAttackFolderPrefix = m_optionsAttackField->GetValue();
 		bool loadOnlyOneAttack = m_optionsOnlyOneAttack->GetValue();
@@ -729,18 +820,106 @@ void RankPanel::OnReadPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 		bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
 		wxString tremulantFolderPrefix = m_optionsTremulantField->GetValue();
 
-		m_rank->readPipes(
+		bool readLoopsAndCues = m_optionsReadLoopsAndCues->GetValue();
+		bool pipesChanged = false;
+		PipeChanges changes;
+		BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Pipes populated"));
+		task.runWithProgress(this, wxT("Reading pipes"), wxT("Reading pipes from ") + m_rank->getPipesRootPath(), [&]() {
+			pipesChanged = m_rank->readPipes(
+				changes,
+				extraAttackFolderPrefix,
+				loadOnlyOneAttack,
+				loadRelease,
+				releaseFolderPrefix,
+				extractKeyPressTime,
+				tremulantFolderPrefix,
+				&task
+			);
+			if (pipesChanged && readLoopsAndCues)
+				ReadLoopsAndCues(changes, task);
+		});
+
+		// the rank is only changed when the whole task is done
+		if (pipesChanged && !task.isCancelled()) {
+			m_rank->applyPipeChanges(changes);
+			RebuildPipeTree();
+			UpdatePipeTree();
+		} else {
+			m_rank->setPipesRootPath(previousPipesRootPath);
+		}
+	}
+}
+
+void RankPanel::OnRescanPipesBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (m_rank->getPipesRootPath() == wxEmptyString || !wxDirExists(m_rank->getPipesRootPath())) {
+		wxMessageDialog msg(this, wxT("The pipes of this rank have not been read from a folder that still exists!"), wxT("Cannot rescan"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+		return;
+	}
+
+	if (!ApplySampleFilePattern())
+		return;
+
+	wxString extraAttackFolderPrefix = m_optionsAttackField->GetValue();
+	bool loadOnlyOneAttack = m_optionsOnlyOneAttack->GetValue();
+	bool loadRelease = m_optionsLoadReleaseInAttack->GetValue();
+	wxString releaseFolderPrefix = m_optionsReleaseField->GetValue();
+	bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
+	wxString tremulantFolderPrefix = m_optionsTremulantField->GetValue();
+
+	bool readLoopsAndCues = m_optionsReadLoopsAndCues->GetValue();
+	bool pipesChanged = false;
+	PipeChanges changes;
+	BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Pipes populated"));
+	task.runWithProgress(this, wxT("Rescanning pipes"), wxT("Rescanning pipes in ") + m_rank->getPipesRootPath(), [&]() {
+		pipesChanged = m_rank->rescanPipes(
+			changes,
 			extraAttackFolderPrefix,
 			loadOnlyOneAttack,
 			loadRelease,
 			releaseFolderPrefix,
 			extractKeyPressTime,
-			tremulantFolderPrefix
+			tremulantFolderPrefix,
+			::wxGetApp().m_sampleMetadataCache,
+			&task
 		);
+		if (pipesChanged && readLoopsAndCues)
+			ReadLoopsAndCues(changes, task);
+	});
 
+	if (task.isCancelled())
+		return;
+
+	if (pipesChanged) {
+		m_rank->applyPipeChanges(changes);
 		RebuildPipeTree();
 		UpdatePipeTree();
+	} else {
+		wxMessageDialog msg(this, wxT("No added, removed or changed sample files were found."), wxT("Rescan done"), wxOK|wxCENTRE);
+		msg.ShowModal();
+	}
+}
+
+void RankPanel::ReadLoopsAndCues(PipeChanges &changes, BackgroundTask &task) {
+	// all the headers are fetched at once first so that the changes are then filled from memory
+	std::vector<wxString> fullPaths;
+	m_rank->getSamplesWithoutLoopsOrCues(changes, fullPaths);
+	task.setTotalSteps(task.getStepsDone() + fullPaths.size() + changes.size());
+
+	SampleHeaderPrefetcher prefetcher(::wxGetApp().m_sampleMetadataCache);
+	if (prefetcher.warmCache(fullPaths, &task))
+		m_rank->readLoopsAndCuesFromSamples(changes, ::wxGetApp().m_sampleMetadataCache, &task);
+}
+
+bool RankPanel::ApplySampleFilePattern() {
+	SamplePattern pattern(m_optionsPatternField->GetValue());
+	if (!pattern.isValid()) {
+		wxMessageDialog msg(this, pattern.getErrorMessage(), wxT("Invalid sample name pattern"), wxOK|wxCENTRE|wxICON_EXCLAMATION);
+		msg.ShowModal();
+		return false;
 	}
+	m_rank->setSampleFilePattern(pattern.getPattern());
+	return true;
 }
 
 void RankPanel::OnRemoveRankBtn(wxCommandEvent& WXUNUSED(event)) {
@@ -839,7 +1018,7 @@ void RankPanel::OnPopupMenuClick(wxCommandEvent &evt) {
 void RankPanel::UpdatePipeTree() {
 	wxTreeItemIdValue cookie;
 	bool firstItem = true;
-	for (Pipe p : m_rank->m_pipes) {
+	for (const Pipe& p : m_rank->m_pipes) {
 		wxTreeItemId currentPipe;
 		if (firstItem) {
 			currentPipe = m_pipeTreeCtrl->GetFirstChild(m_tree_rank_root, cookie);
@@ -851,8 +1030,8 @@ void RankPanel::UpdatePipeTree() {
 		if (m_rank->isPercussive()) {
 			// we can just dump the (attacks of the) pipes into the tree (if they exist)
 			if (!p.m_attacks.empty()) {
-				for (Attack atk : p.m_attacks) {
-					m_pipeTreeCtrl->AppendItem(currentPipe, atk.fileName);
+				for (const Attack& atk : p.m_attacks) {
+					m_pipeTreeCtrl->AppendItem(currentPipe, atk.getFileName());
 				}
 			}
 		} else {
@@ -860,13 +1039,13 @@ void RankPanel::UpdatePipeTree() {
 			wxTreeItemId releases = m_pipeTreeCtrl->GetLastChild(currentPipe);
 			wxTreeItemId attacks = m_pipeTreeCtrl->GetPrevSibling(releases);
 
-			for (Attack atk : p.m_attacks) {
-				m_pipeTreeCtrl->AppendItem(attacks, atk.fileName);
+			for (const Attack& atk : p.m_attacks) {
+				m_pipeTreeCtrl->AppendItem(attacks, atk.getFileName());
 			}
 
 			if (!p.m_releases.empty()) {
-				for (Release rel : p.m_releases) {
-					m_pipeTreeCtrl->AppendItem(releases, rel.fileName);
+				for (const Release& rel : p.m_releases) {
+					m_pipeTreeCtrl->AppendItem(releases, rel.getFileName());
 				}
 			}
 		}
@@ -1083,8 +1262,7 @@ void RankPanel::OnCreateReference() {
 			for (int i = 0; i < pipesToRef; i++) {
 				wxString refString = wxT("REF:") + GOODF_functions::number_format(manId) + wxT(":") + GOODF_functions::number_format(stopId) + wxT(":") + GOODF_functions::number_format(pipeId + i);
 				m_rank->clearPipeAt(pipeIndex + i);
-				m_rank->getPipeAt(pipeIndex + i)->m_attacks.front().fileName = refString;
-				m_rank->getPipeAt(pipeIndex + i)->m_attacks.front().fullPath = refString;
+				m_rank->getPipeAt(pipeIndex + i)->m_attacks.front().setFullPath(refString);
 			}
 
 			RebuildPipeTree();
@@ -1103,10 +1281,10 @@ void RankPanel::OnEditAttack() {
 		// the user wants to copy properties of the selected attack to other
 		// attacks in the same directory
 		auto sourceAttack = std::next(atk_dlg.m_attacklist.begin(), atk_dlg.m_selectedAttackIndex);
-		wxString sourceDir = sourceAttack->fullPath.BeforeLast(wxFILE_SEP_PATH);
+		wxString sourceDir = sourceAttack->getSamplePath().getFolderPath();
 		for (Pipe &p : m_rank->m_pipes) {
 			for (std::list<Attack>::iterator atk = p.m_attacks.begin(); atk != p.m_attacks.end(); ++atk) {
-				if (atk->fullPath.BeforeLast(wxFILE_SEP_PATH).IsSameAs(sourceDir) && atk != sourceAttack) {
+				if (atk->getSamplePath().isInFolder(sourceDir) && atk != sourceAttack) {
 					atk->attackStart = sourceAttack->attackStart;
 					atk->attackVelocity = sourceAttack->attackVelocity;
 					atk->cuePoint = sourceAttack->cuePoint;
@@ -1115,6 +1293,7 @@ void RankPanel::OnEditAttack() {
 					atk->maxKeyPressTime = sourceAttack->maxKeyPressTime;
 					atk->maxTimeSinceLastRelease = sourceAttack->maxTimeSinceLastRelease;
 					atk->releaseEnd = sourceAttack->releaseEnd;
+					atk->releaseMarkerConfidence = -1;
 				}
 			}
 		}
@@ -1131,10 +1310,10 @@ void RankPanel::OnEditRelease() {
 		// the user wants to copy properties of the selected release to other
 		// releases from the same directory
 		Release *sourceRelease = dlg.GetCurrentRelease();
-		wxString sourceDir = sourceRelease->fullPath.BeforeLast(wxFILE_SEP_PATH);
+		wxString sourceDir = sourceRelease->getSamplePath().getFolderPath();
 		for (Pipe &p : m_rank->m_pipes) {
 			for (std::list<Release>::iterator rel = p.m_releases.begin(); rel != p.m_releases.end(); ++rel) {
-				if (rel->fullPath.BeforeLast(wxFILE_SEP_PATH).IsSameAs(sourceDir) && &(*rel) != sourceRelease) {
+				if (rel->getSamplePath().isInFolder(sourceDir) && &(*rel) != sourceRelease) {
 					rel->cuePoint = sourceRelease->cuePoint;
 					rel->isTremulant = sourceRelease->isTremulant;
 					rel->maxKeyPressTime = sourceRelease->maxKeyPressTime;
@@ -1242,6 +1421,9 @@ void RankPanel::OnTrackerDelaySpin(wxSpinEvent& WXUNUSED(event)) {
 }
 
 void RankPanel::OnAddPipesBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (!ApplySampleFilePattern())
+		return;
+
 	wxString defaultPath;
 	if (m_rank->getPipesRootPath() != wxEmptyString)
 		defaultPath = m_rank->getPipesRootPath();
@@ -1256,6 +1438,7 @@ void RankPanel::OnAddPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 	);
 
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
+		wxString previousPipesRootPath = m_rank->getPipesRootPath();
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
 		wxString extraAttackFolderPrefix = m_optionsAttackField->GetValue();
 		bool loadOnlyOneAttack = m_optionsOnlyOneAttack->GetValue();
@@ -1264,21 +1447,39 @@ void RankPanel::OnAddPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 		bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
 		wxString tremulantFolderPrefix = m_optionsTremulantField->GetValue();
 
-		m_rank->addToPipes(
-			extraAttackFolderPrefix,
-			loadOnlyOneAttack,
-			loadRelease,
-			releaseFolderPrefix,
-			extractKeyPressTime,
-			tremulantFolderPrefix
-		);
-
-		RebuildPipeTree();
-		UpdatePipeTree();
+		bool readLoopsAndCues = m_optionsReadLoopsAndCues->GetValue();
+		bool pipesChanged = false;
+		PipeChanges changes;
+		BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Pipes populated"));
+		task.runWithProgress(this, wxT("Adding to pipes"), wxT("Adding attacks/releases from ") + m_rank->getPipesRootPath(), [&]() {
+			pipesChanged = m_rank->addToPipes(
+				changes,
+				extraAttackFolderPrefix,
+				loadOnlyOneAttack,
+				loadRelease,
+				releaseFolderPrefix,
+				extractKeyPressTime,
+				tremulantFolderPrefix,
+				&task
+			);
+			if (pipesChanged && readLoopsAndCues)
+				ReadLoopsAndCues(changes, task);
+		});
+
+		if (pipesChanged && !task.isCancelled()) {
+			m_rank->applyPipeChanges(changes);
+			RebuildPipeTree();
+			UpdatePipeTree();
+		} else {
+			m_rank->setPipesRootPath(previousPipesRootPath);
+		}
 	}
 }
 
 void RankPanel::OnAddTremulantPipesBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (!ApplySampleFilePattern())
+		return;
+
 	wxString defaultPath;
 	if (m_rank->getPipesRootPath() != wxEmptyString)
 		defaultPath = m_rank->getPipesRootPath();
@@ -1293,6 +1494,7 @@ void RankPanel::OnAddTremulantPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 	);
 
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
+		wxString previousPipesRootPath = m_rank->getPipesRootPath();
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
 		wxString extraAttackFolderPrefix = m_optionsAttackField->GetValue();
 		bool loadOnlyOneAttack = m_optionsOnlyOneAttack->GetValue();
@@ -1300,16 +1502,31 @@ void RankPanel::OnAddTremulantPipesBtn(wxCommandEvent& WXUNUSED(event)) {
 		wxString releaseFolderPrefix = m_optionsReleaseField->GetValue();
 		bool extractKeyPressTime = m_optionsKeyPressTime->GetValue();
 
-		m_rank->addTremulantToPipes(
-			extraAttackFolderPrefix,
-			loadOnlyOneAttack,
-			loadRelease,
-			releaseFolderPrefix,
-			extractKeyPressTime
-		);
-
-		RebuildPipeTree();
-		UpdatePipeTree();
+		bool readLoopsAndCues = m_optionsReadLoopsAndCues->GetValue();
+		bool pipesChanged = false;
+		PipeChanges changes;
+		BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Pipes populated"));
+		task.runWithProgress(this, wxT("Adding tremulant pipes"), wxT("Adding tremulant attacks/releases from ") + m_rank->getPipesRootPath(), [&]() {
+			pipesChanged = m_rank->addTremulantToPipes(
+				changes,
+				extraAttackFolderPrefix,
+				loadOnlyOneAttack,
+				loadRelease,
+				releaseFolderPrefix,
+				extractKeyPressTime,
+				&task
+			);
+			if (pipesChanged && readLoopsAndCues)
+				ReadLoopsAndCues(changes, task);
+		});
+
+		if (pipesChanged && !task.isCancelled()) {
+			m_rank->applyPipeChanges(changes);
+			RebuildPipeTree();
+			UpdatePipeTree();
+		} else {
+			m_rank->setPipesRootPath(previousPipesRootPath);
+		}
 	}
 }
 
@@ -1317,7 +1534,124 @@ void RankPanel::OnExpandTreeBtn(wxCommandEvent& WXUNUSED(event)) {
 	m_pipeTreeCtrl->ExpandAll();
 }
 
+void RankPanel::OnSuggestGainsBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (m_rank->m_pipes.empty())
+		return;
+
+	RankGainAnalyser analyser(m_rank);
+	BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Pipes analysed"));
+	task.runWithProgress(this, wxT("Analysing pipes"), wxT("Measuring the levels of the pipes of ") + m_rank->getName(), [&]() {
+		analyser.analyse(*::wxGetApp().m_workerPool, &task);
+	});
+	if (task.isCancelled())
+		return;
+
+	PipeGainDialog gainDialog(analyser, this);
+	if (gainDialog.ShowModal() == wxID_OK) {
+		analyser.applySuggestedGains(m_rank);
+	}
+}
+
+void RankPanel::OnFindLoopsBtn(wxCommandEvent& WXUNUSED(event)) {
+	BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Attacks searched"));
+	bool loopsAdded = false;
+	task.runWithProgress(this, wxT("Finding loops"), wxT("Searching the attacks without loops of ") + m_rank->getName(), [&]() {
+		loopsAdded = m_rank->findMissingLoops(*::wxGetApp().m_workerPool, &task);
+	});
+	if (task.isCancelled())
+		return;
+
+	if (!loopsAdded) {
+		wxMessageDialog msg(this, wxT("All attacks of this rank already have loops."), wxT("Nothing to search"), wxOK|wxCENTRE);
+		msg.ShowModal();
+		return;
+	}
+
+	wxMessageDialog msg(
+		this,
+		wxString::Format(wxT("Loops were added to %u of the %i attacks that had none."), task.getItemsFound(), task.getStepsDone()),
+		wxT("Loops found"),
+		wxOK|wxCENTRE
+	);
+	msg.ShowModal();
+}
+
+void RankPanel::OnMeasurePitchBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (m_rank->m_pipes.empty())
+		return;
+
+	RankPitchAnalyser analyser(m_rank);
+	BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Pipes measured"));
+	task.runWithProgress(this, wxT("Measuring pitch"), wxT("Measuring the pitch of the pipes of ") + m_rank->getName(), [&]() {
+		analyser.analyse(*::wxGetApp().m_workerPool, &task);
+	});
+	if (task.isCancelled())
+		return;
+
+	PipePitchDialog pitchDialog(analyser, this);
+	if (pitchDialog.ShowModal() == wxID_OK) {
+		if (pitchDialog.IsWritingPitchTuning())
+			analyser.applyPitchTuning(m_rank, pitchDialog.IsKeepingRankPitch());
+		else
+			analyser.applyMidiPitchFraction(m_rank);
+	}
+}
+
+void RankPanel::OnFindAttackStartsBtn(wxCommandEvent& WXUNUSED(event)) {
+	AttackStartDialog options(this);
+	if (options.ShowModal() != wxID_OK)
+		return;
+
+	AttackStartFinder finder(options.GetThreshold(), options.GetMargin(), options.GetReplaceExisting());
+	finder.addRank(m_rank);
+	if (finder.getNumberOfAttacks() == 0) {
+		wxMessageDialog msg(this, wxT("The rank has no attacks to search!"), wxT("Nothing to search"), wxOK|wxCENTRE);
+		msg.ShowModal();
+		return;
+	}
+
+	BackgroundTask task(finder.getNumberOfAttacks(), wxT("Attacks searched"));
+	task.runWithProgress(this, wxT("Finding attack starts"), wxT("Searching the attacks of ") + m_rank->getName(), [&]() {
+		finder.findAttackStarts(*::wxGetApp().m_workerPool, &task);
+	});
+	if (task.isCancelled())
+		return;
+
+	finder.applyAttackStarts();
+	wxMessageDialog msg(this, finder.getSummary(), wxT("Attack starts found"), wxOK|wxCENTRE);
+	msg.ShowModal();
+}
+
+void RankPanel::OnFindReleaseMarkersBtn(wxCommandEvent& WXUNUSED(event)) {
+	wxMessageDialog replaceDlg(this, wxT("Should cuepoints that already are set be replaced too?"), wxT("Find release markers"), wxYES_NO|wxCANCEL|wxCENTRE);
+	int answer = replaceDlg.ShowModal();
+	if (answer == wxID_CANCEL)
+		return;
+
+	ReleaseMarkerFinder finder(answer == wxID_YES);
+	finder.addRank(m_rank, m_rank->getName());
+	if (finder.getNumberOfAttacks() == 0) {
+		wxMessageDialog msg(this, wxT("The rank has no attacks to search!"), wxT("Nothing to search"), wxOK|wxCENTRE);
+		msg.ShowModal();
+		return;
+	}
+
+	BackgroundTask task(finder.getNumberOfAttacks(), wxT("Attacks searched"));
+	task.runWithProgress(this, wxT("Finding release markers"), wxT("Searching the attacks of ") + m_rank->getName(), [&]() {
+		finder.findMarkers(*::wxGetApp().m_workerPool, &task);
+	});
+	if (task.isCancelled())
+		return;
+
+	ReleaseMarkerDialog report(finder, this);
+	if (report.ShowModal() == wxID_OK)
+		finder.applyMarkers(report.IsSkippingDoubtful() ? DOUBTFUL_RELEASE_CONFIDENCE : 0);
+}
+
 void RankPanel::OnAddReleaseSamplesBtn(wxCommandEvent& WXUNUSED(event)) {
+	if (!ApplySampleFilePattern())
+		return;
+
 	wxString defaultPath;
 	if (m_rank->getPipesRootPath() != wxEmptyString)
 		defaultPath = m_rank->getPipesRootPath();
@@ -1332,11 +1666,25 @@ void RankPanel::OnAddReleaseSamplesBtn(wxCommandEvent& WXUNUSED(event)) {
 	);
 
 	if (rankPipesPathDialog.ShowModal() == wxID_OK) {
+		wxString previousPipesRootPath = m_rank->getPipesRootPath();
 		m_rank->setPipesRootPath(rankPipesPathDialog.GetPath());
 
-		m_rank->addReleasesToPipes();
-
-		RebuildPipeTree();
-		UpdatePipeTree();
+		bool readLoopsAndCues = m_optionsReadLoopsAndCues->GetValue();
+		bool pipesChanged = false;
+		PipeChanges changes;
+		BackgroundTask task(m_rank->getNumberOfLogicalPipes(), wxT("Pipes populated"));
+		task.runWithProgress(this, wxT("Adding release samples"), wxT("Adding release samples from ") + m_rank->getPipesRootPath(), [&]() {
+			pipesChanged = m_rank->addReleasesToPipes(changes, &task);
+			if (pipesChanged && readLoopsAndCues)
+				ReadLoopsAndCues(changes, task);
+		});
+
+		if (pipesChanged && !task.isCancelled()) {
+			m_rank->applyPipeChanges(changes);
+			RebuildPipeTree();
+			UpdatePipeTree();
+		} else {
+			m_rank->setPipesRootPath(previousPipesRootPath);
+		}
 	}
 }
@@ -64,10 +64,17 @@ private:
 	wxCheckBox *m_optionsLoadReleaseInAttack;
 	wxTextCtrl *m_optionsReleaseField;
 	wxCheckBox *m_optionsKeyPressTime;
+	wxCheckBox *m_optionsReadLoopsAndCues;
 	wxTextCtrl *m_optionsTremulantField;
+	wxTextCtrl *m_optionsPatternField;
 	wxButton *m_addPipesFromFolderBtn;
 	wxButton *m_addTremulantPipesBtn;
 	wxButton *m_expandTreeBtn;
+	wxButton *m_suggestGainsBtn;
+	wxButton *m_findLoopsBtn;
+	wxButton *m_measurePitchBtn;
+	wxButton *m_findAttackStartsBtn;
+	wxButton *m_findReleaseMarkersBtn;
 	wxButton *m_addReleaseSamplesBtn;
 
 	wxButton *removeRankBtn;
@@ -87,6 +94,7 @@ private:
 	void OnMaxVelocitySpin(wxSpinDoubleEvent& event);
 	void OnRetuningSelection(wxCommandEvent& event);
 	void OnReadPipesBtn(wxCommandEvent& event);
+	void OnRescanPipesBtn(wxCommandEvent& event);
 	void OnRemoveRankBtn(wxCommandEvent& event);
 	void OnClearPipesBtn(wxCommandEvent& event);
 	void OnPipeTreeItemRightClick(wxTreeEvent &evt);
@@ -98,10 +106,18 @@ private:
 	void OnAddPipesBtn(wxCommandEvent& event);
 	void OnAddTremulantPipesBtn(wxCommandEvent& event);
 	void OnExpandTreeBtn(wxCommandEvent& event);
+	void OnSuggestGainsBtn(wxCommandEvent& event);
+	void OnFindLoopsBtn(wxCommandEvent& event);
+	void OnMeasurePitchBtn(wxCommandEvent& event);
+	void OnFindAttackStartsBtn(wxCommandEvent& event);
+	void OnFindReleaseMarkersBtn(wxCommandEvent& event);
 	void OnAddReleaseSamplesBtn(wxCommandEvent& event);
 
 	void UpdatePipeTree();
 	void RebuildPipeTree();
+	bool ApplySampleFilePattern();
+	// runs on the worker of the task that just read the pipes
+	void ReadLoopsAndCues(PipeChanges &changes, BackgroundTask &task);
 
 	int GetSelectedItemIndexRelativeParent();
 	int GetItemIndexRelativeParent(wxTreeItemId item);
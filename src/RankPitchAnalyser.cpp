@@ -0,0 +1,170 @@
+/*
+ * RankPitchAnalyser.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "RankPitchAnalyser.h"
+#include "PitchDetector.h"
+#include <algorithm>
+#include <cmath>
+
+PipePitchAnalysis::PipePitchAnalysis() {
+	pipeNumber = 0;
+	samplePath = wxEmptyString;
+	isAnalysed = false;
+	errorMessage = wxEmptyString;
+	nominalFrequency = 0;
+	frequency = 0;
+	deviation = 0;
+	clarity = 0;
+}
+
+RankPitchAnalyser::RankPitchAnalyser(Rank *rank) {
+	unsigned pipeNumber = 0;
+	for (const Pipe& pipe : rank->m_pipes) {
+		pipeNumber++;
+		PipePitchAnalysis analysis;
+		analysis.pipeNumber = pipeNumber;
+		int midiNote = rank->getFirstMidiNoteNumber() + pipeNumber - 1;
+		analysis.nominalFrequency = 440.0 * std::pow(2.0, (midiNote - 69) / 12.0) * pipe.harmonicNumber / 8.0;
+
+		// the main attack is the first one with a sample of its own that isn't for the tremulant
+		AnalysedAttack attack;
+		attack.attackStart = 0;
+		attack.cuePoint = -1;
+		const Attack *mainAttack = NULL;
+		for (const Attack& atk : pipe.m_attacks) {
+			if (atk.isDummy() || atk.isReference())
+				continue;
+			if (!mainAttack || (mainAttack->isTremulant == 1 && atk.isTremulant != 1))
+				mainAttack = &atk;
+		}
+		if (mainAttack) {
+			analysis.samplePath = mainAttack->getFullPath();
+			attack.fullPath = mainAttack->getFullPath();
+			attack.attackStart = mainAttack->attackStart;
+			attack.cuePoint = mainAttack->cuePoint;
+		} else {
+			analysis.errorMessage = wxT("The pipe has no sample of its own.");
+		}
+
+		m_pipes.push_back(analysis);
+		m_attacks.push_back(attack);
+	}
+}
+
+RankPitchAnalyser::~RankPitchAnalyser() {
+
+}
+
+bool RankPitchAnalyser::analyse(WorkerPool &pool, BackgroundTask *task) {
+	if (task)
+		task->setTotalSteps(m_pipes.size());
+
+	pool.parallelFor(m_pipes.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+		PipePitchAnalysis &pipe = m_pipes[i];
+		if (m_attacks[i].fullPath != wxEmptyString) {
+			PitchDetector detector;
+			if (detector.findPitch(m_attacks[i].fullPath, m_attacks[i].attackStart, m_attacks[i].cuePoint, pipe.nominalFrequency)) {
+				pipe.frequency = detector.getFrequency();
+				pipe.clarity = detector.getClarity();
+				pipe.deviation = 1200.0 * std::log2(pipe.frequency / pipe.nominalFrequency);
+				pipe.isAnalysed = true;
+			} else {
+				pipe.errorMessage = detector.getErrorMessage();
+			}
+		}
+		if (task)
+			task->stepDone();
+	});
+
+	return !(task && task->isCancelled());
+}
+
+unsigned RankPitchAnalyser::getNumberOfPipes() {
+	return m_pipes.size();
+}
+
+const PipePitchAnalysis& RankPitchAnalyser::getPipeAnalysisAt(unsigned index) {
+	return m_pipes[index];
+}
+
+unsigned RankPitchAnalyser::getNumberOfAnalysedPipes() {
+	unsigned count = 0;
+	for (const PipePitchAnalysis& pipe : m_pipes) {
+		if (pipe.isAnalysed)
+			count++;
+	}
+	return count;
+}
+
+double RankPitchAnalyser::getMedianDeviation() {
+	std::vector<double> deviations;
+	for (const PipePitchAnalysis& pipe : m_pipes) {
+		if (pipe.isAnalysed)
+			deviations.push_back(pipe.deviation);
+	}
+	if (deviations.empty())
+		return 0;
+
+	std::sort(deviations.begin(), deviations.end());
+	double median = deviations[deviations.size() / 2];
+	if (deviations.size() % 2 == 0)
+		median = (median + deviations[deviations.size() / 2 - 1]) / 2;
+	return median;
+}
+
+void RankPitchAnalyser::applyPitchTuning(Rank *rank, bool keepRankPitch) {
+	double offset = keepRankPitch ? getMedianDeviation() : 0;
+	unsigned index = 0;
+	for (Pipe& pipe : rank->m_pipes) {
+		if (index >= m_pipes.size())
+			break;
+		if (m_pipes[index].isAnalysed) {
+			// rounded to a tenth of a cent and kept within what the pitch tuning can be
+			double tuning = std::round((offset - m_pipes[index].deviation) * 10) / 10;
+			pipe.pitchTuning = (float) std::max(-1800.0, std::min(1800.0, tuning));
+		}
+		index++;
+	}
+}
+
+void RankPitchAnalyser::applyMidiPitchFraction(Rank *rank) {
+	unsigned index = 0;
+	for (Pipe& pipe : rank->m_pipes) {
+		if (index >= m_pipes.size())
+			break;
+		if (m_pipes[index].isAnalysed) {
+			// the key and fraction are of the pitch that the sample sounds at
+			double note = 69.0 + 12.0 * std::log2(m_pipes[index].frequency / 440.0);
+			int key = (int) std::floor(note);
+			float fraction = (float) (std::round((note - key) * 1000) / 10);
+			if (fraction >= 100) {
+				key++;
+				fraction = 0;
+			}
+			if (key >= 0 && key < 128) {
+				pipe.midiKeyNumber = key;
+				pipe.midiPitchFraction = fraction;
+			}
+		}
+		index++;
+	}
+}
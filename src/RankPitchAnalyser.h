@@ -0,0 +1,81 @@
+/*
+ * RankPitchAnalyser.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RANKPITCHANALYSER_H
+#define RANKPITCHANALYSER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "Rank.h"
+#include "BackgroundTask.h"
+#include "WorkerPool.h"
+
+// The pitch measured for the main attack of one pipe. The pipe number is 1
+// based. The nominal frequency is that of the key of the pipe in equal
+// temperament at a' = 440 Hz, moved by the harmonic number of the pipe, and
+// the deviation is how far the sample is from it in cents.
+class PipePitchAnalysis {
+public:
+	PipePitchAnalysis();
+
+	unsigned pipeNumber;
+	wxString samplePath;
+	bool isAnalysed;
+	wxString errorMessage;
+	double nominalFrequency;
+	double frequency;
+	double deviation;
+	double clarity;
+};
+
+// Measures the pitch of every pipe of a rank with a PitchDetector and writes
+// the result back either as a PitchTuning that moves each pipe to its nominal
+// pitch, or as the MIDIKeyNumber and MIDIPitchFraction that tell GrandOrgue
+// the pitch the sample really has, leaving any retuning to the temperament.
+class RankPitchAnalyser {
+public:
+	RankPitchAnalyser(Rank *rank);
+	~RankPitchAnalyser();
+
+	// false if cancelled
+	bool analyse(WorkerPool &pool, BackgroundTask *task = NULL);
+	unsigned getNumberOfPipes();
+	const PipePitchAnalysis& getPipeAnalysisAt(unsigned index);
+	unsigned getNumberOfAnalysedPipes();
+	// of the analysed pipes, the pitch that the rank as a whole is at
+	double getMedianDeviation();
+	// with keepRankPitch only the deviation from the median is corrected,
+	// so that an organ tuned below or above 440 Hz stays where it is
+	void applyPitchTuning(Rank *rank, bool keepRankPitch);
+	void applyMidiPitchFraction(Rank *rank);
+
+private:
+	class AnalysedAttack {
+	public:
+		wxString fullPath;
+		int attackStart;
+		int cuePoint;
+	};
+
+	std::vector<PipePitchAnalysis> m_pipes;
+	std::vector<AnalysedAttack> m_attacks;
+};
+
+#endif
@@ -21,23 +21,32 @@
 #include "Release.h"
 
 Release::Release() {
-	fileName = wxEmptyString;
-	fullPath = wxEmptyString;
 	isTremulant = -1;
 	maxKeyPressTime = -1;
 	cuePoint = -1;
 	releaseEnd = -1;
 }
 
-Release::Release(const Release& rel) {
-	fileName = rel.fileName;
-	fullPath = rel.fullPath;
-	isTremulant = rel.isTremulant;
-	maxKeyPressTime = rel.maxKeyPressTime;
-	cuePoint = rel.cuePoint;
-	releaseEnd = rel.releaseEnd;
+wxString Release::getFileName() const {
+	return m_path.getRelativePath();
 }
 
-Release::~Release() {
+wxString Release::getFullPath() const {
+	return m_path.getFullPath();
+}
+
+void Release::setFullPath(wxString fullPath) {
+	m_path = SamplePath(fullPath);
+}
+
+const SamplePath& Release::getSamplePath() const {
+	return m_path;
+}
+
+bool Release::isDummy() const {
+	return m_path.isDummy();
+}
 
+bool Release::isReference() const {
+	return m_path.isReference();
 }
@@ -22,20 +22,27 @@
 #define RELEASE_H
 
 #include <wx/wx.h>
+#include "SamplePath.h"
 
 class Release {
 public:
 	Release();
-	Release(const Release& rel);
-	~Release();
 
-	wxString fileName;
-	wxString fullPath;
+	wxString getFileName() const;
+	wxString getFullPath() const;
+	void setFullPath(wxString fullPath);
+	const SamplePath& getSamplePath() const;
+	bool isDummy() const;
+	bool isReference() const;
+
 	int isTremulant;
 	int maxKeyPressTime;
 	int cuePoint;
 	int releaseEnd;
 
+private:
+	SamplePath m_path;
+
 };
 
 #endif
@@ -22,7 +22,6 @@
 #include "GOODFFunctions.h"
 #include "GOODF.h"
 #include <wx/statline.h>
-#include "WAVfileParser.h"
 
 IMPLEMENT_CLASS(ReleaseDialog, wxDialog)
 
@@ -327,16 +326,16 @@ void ReleaseDialog::SetButtonState() {
 }
 
 void ReleaseDialog::TransferReleaseValuesToWindow() {
-	if (!m_currentRelease->fullPath.IsSameAs(wxT("DUMMY"))) {
-		WAVfileParser sample(m_currentRelease->fullPath);
-		if (sample.isWavOk()) {
-			m_cuePointSpin->SetRange(-1, sample.getNumberOfFrames() - 1);
-			m_releaseEndSpin->SetRange(-1, sample.getNumberOfFrames() - 1);
+	if (!m_currentRelease->isDummy()) {
+		SampleMetadata sample;
+		if (::wxGetApp().m_sampleMetadataCache->getMetadata(m_currentRelease->getFullPath(), sample) && sample.isOk) {
+			m_cuePointSpin->SetRange(-1, sample.numberOfFrames - 1);
+			m_releaseEndSpin->SetRange(-1, sample.numberOfFrames - 1);
 		}
 	}
 	m_releaseLabel->SetLabel(wxString::Format(wxT("Release%s"), GOODF_functions::number_format(m_selectedReleaseIndex + 1)));
-	m_releaseName->SetLabel(m_currentRelease->fileName);
-	m_releasePath->SetLabel(m_currentRelease->fullPath);
+	m_releaseName->SetLabel(m_currentRelease->getFileName());
+	m_releasePath->SetLabel(m_currentRelease->getFullPath());
 	m_isTremulantChoice->SetSelection(m_currentRelease->isTremulant + 1);
 	m_maxKeyPressTime->SetValue(m_currentRelease->maxKeyPressTime);
 	m_cuePointSpin->SetValue(m_currentRelease->cuePoint);
@@ -0,0 +1,210 @@
+/*
+ * ReleaseMarkerDetector.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ReleaseMarkerDetector.h"
+#include "SampleAudioReader.h"
+#include "AudioKernels.h"
+#include <vector>
+#include <complex>
+#include <algorithm>
+#include <cmath>
+
+ReleaseMarkerDetector::ReleaseMarkerDetector() {
+	m_cuePoint = -1;
+	m_releaseEnd = -1;
+	m_confidence = 0;
+	m_errorMessage = wxEmptyString;
+}
+
+ReleaseMarkerDetector::~ReleaseMarkerDetector() {
+
+}
+
+bool ReleaseMarkerDetector::findMarkers(wxString fullPath, int attackStart, int searchFrom) {
+	m_cuePoint = -1;
+	m_releaseEnd = -1;
+	m_confidence = 0;
+
+	SampleAudioReader reader;
+	if (!reader.open(fullPath)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned sampleRate = reader.getSampleRate();
+	unsigned channels = reader.getNumberOfChannels();
+	std::vector<float> samples;
+	if (!reader.readFrames(0, reader.getNumberOfFrames(), samples)) {
+		m_errorMessage = reader.getErrorMessage();
+		return false;
+	}
+	unsigned numberOfFrames = samples.size() / channels;
+	std::vector<float> mono(numberOfFrames);
+	for (unsigned i = 0; i < numberOfFrames; i++) {
+		float sum = 0;
+		for (unsigned ch = 0; ch < channels; ch++)
+			sum += samples[i * channels + ch];
+		mono[i] = sum / channels;
+	}
+	samples.clear();
+
+	unsigned hop = std::max(sampleRate / 100, 1u);
+	unsigned numberOfHops = numberOfFrames / hop;
+	std::vector<double> envelope(numberOfHops);
+	for (unsigned k = 0; k < numberOfHops; k++)
+		envelope[k] = AudioKernels::toDecibels(std::sqrt(AudioKernels::sumOfSquares(mono.data() + k * hop, hop) / hop));
+
+	// the transient of the attack is never taken for the sustained tone
+	unsigned firstFrame = std::max(std::max(attackStart, 0) + (int) (sampleRate / 5), std::max(searchFrom, 0));
+	unsigned firstHop = firstFrame / hop + 1;
+	if (firstHop + 100 > numberOfHops) {
+		m_errorMessage = wxT("Less than a second of the sample is left to search.");
+		return false;
+	}
+
+	std::vector<double> sorted(envelope.begin() + firstHop, envelope.end());
+	std::sort(sorted.begin(), sorted.end());
+	double sustainLevel = sorted[sorted.size() * 4 / 5];
+
+	// the key is released after the last moment the tone is held at its level
+	unsigned heldHop = numberOfHops;
+	for (unsigned k = numberOfHops; k-- > firstHop; ) {
+		if (envelope[k] >= sustainLevel - 3) {
+			heldHop = k;
+			break;
+		}
+	}
+	if (heldHop + 20 >= numberOfHops) {
+		m_errorMessage = wxT("The tone is held until the end of the sample, there is no release in it.");
+		return false;
+	}
+	double lowestAfter = envelope[heldHop];
+	for (unsigned k = heldHop + 1; k < numberOfHops && k <= heldHop + 50; k++)
+		lowestAfter = std::min(lowestAfter, envelope[k]);
+	double depth = sustainLevel - lowestAfter;
+	if (depth < 6) {
+		m_errorMessage = wxT("The sample never falls clearly below the level of its tone.");
+		return false;
+	}
+
+	// how steady the tone was during the last second before the release
+	unsigned steadyStart = heldHop > firstHop + 100 ? heldHop - 100 : firstHop;
+	double mean = 0;
+	for (unsigned k = steadyStart; k <= heldHop; k++)
+		mean += envelope[k];
+	mean /= heldHop - steadyStart + 1;
+	double variance = 0;
+	for (unsigned k = steadyStart; k <= heldHop; k++)
+		variance += (envelope[k] - mean) * (envelope[k] - mean);
+	double deviation = std::sqrt(variance / (heldHop - steadyStart + 1));
+
+	// the part of the spectrum that falls from one hop to the next, relative
+	// to what there was, from 150 ms before the held hop to 50 ms after it
+	unsigned fftSize = 1;
+	while (fftSize < hop * 4)
+		fftSize <<= 1;
+	std::vector<float> window(fftSize);
+	const double pi = 3.14159265358979323846;
+	for (unsigned i = 0; i < fftSize; i++)
+		window[i] = (float) (0.5 - 0.5 * std::cos(2 * pi * i / fftSize));
+	unsigned fluxStart = std::max(heldHop > 15 ? heldHop - 15 : 0, firstHop);
+	unsigned fluxEnd = std::min(heldHop + 5, numberOfHops - 1);
+	std::vector<std::complex<float>> spectrum(fftSize);
+	std::vector<float> magnitudes;
+	std::vector<float> previousMagnitudes;
+	std::vector<double> flux;
+	for (unsigned k = fluxStart - 1; k <= fluxEnd; k++) {
+		long first = (long) k * hop + hop / 2 - fftSize / 2;
+		for (unsigned i = 0; i < fftSize; i++) {
+			long frame = first + i;
+			float value = frame >= 0 && frame < (long) numberOfFrames ? mono[frame] : 0;
+			spectrum[i] = std::complex<float>(value * window[i], 0);
+		}
+		AudioKernels::fft(spectrum);
+		magnitudes.resize(fftSize / 2);
+		for (unsigned i = 0; i < fftSize / 2; i++)
+			magnitudes[i] = std::abs(spectrum[i]);
+		if (!previousMagnitudes.empty()) {
+			double fallen = 0;
+			double total = 0;
+			for (unsigned i = 0; i < fftSize / 2; i++) {
+				fallen += std::max(previousMagnitudes[i] - magnitudes[i], 0.0f);
+				total += previousMagnitudes[i];
+			}
+			flux.push_back(total > 0 ? fallen / total : 0);
+		}
+		previousMagnitudes.swap(magnitudes);
+	}
+
+	// the release starts where the flux came up to half its highest and then
+	// stayed there, a tremulant could have brought it there earlier for a moment
+	unsigned peakIndex = std::max_element(flux.begin(), flux.end()) - flux.begin();
+	double peakFlux = flux[peakIndex];
+	unsigned releaseIndex = peakIndex;
+	while (releaseIndex > 0 && flux[releaseIndex - 1] >= peakFlux * 0.5)
+		releaseIndex--;
+	unsigned releaseHop = fluxStart + releaseIndex;
+	std::vector<double> sortedFlux(flux);
+	std::sort(sortedFlux.begin(), sortedFlux.end());
+	double typicalFlux = sortedFlux[sortedFlux.size() / 2];
+	double prominence = peakFlux / (typicalFlux + 1e-9);
+
+	// placed on a rising zero crossing so the release joins without a click
+	unsigned cuePoint = releaseHop * hop;
+	for (unsigned i = cuePoint; i > 0 && i + hop > cuePoint; i--) {
+		if (mono[i - 1] < 0 && mono[i] >= 0) {
+			cuePoint = i;
+			break;
+		}
+	}
+	m_cuePoint = cuePoint;
+
+	std::vector<double> tail(envelope.begin() + releaseHop, envelope.end());
+	std::sort(tail.begin(), tail.end());
+	double noiseFloor = tail[tail.size() / 10];
+	double endLevel = std::max(noiseFloor + 3, sustainLevel - 60);
+	for (unsigned k = releaseHop + 1; k + 2 < numberOfHops; k++) {
+		if (envelope[k] <= endLevel) {
+			m_releaseEnd = (k + 1) * hop - 1;
+			break;
+		}
+	}
+
+	double depthScore = std::min(depth / 20.0, 1.0);
+	double steadinessScore = std::max(0.0, std::min(1.0, 1.0 - deviation / 4.0));
+	double fluxScore = std::max(0.0, std::min(1.0, (prominence - 1.0) / 4.0));
+	m_confidence = (float) (depthScore * steadinessScore * (0.5 + 0.5 * fluxScore));
+	return true;
+}
+
+int ReleaseMarkerDetector::getCuePoint() {
+	return m_cuePoint;
+}
+
+int ReleaseMarkerDetector::getReleaseEnd() {
+	return m_releaseEnd;
+}
+
+float ReleaseMarkerDetector::getConfidence() {
+	return m_confidence;
+}
+
+wxString ReleaseMarkerDetector::getErrorMessage() {
+	return m_errorMessage;
+}
@@ -0,0 +1,59 @@
+/*
+ * ReleaseMarkerDetector.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RELEASEMARKERDETECTOR_H
+#define RELEASEMARKERDETECTOR_H
+
+#include <wx/wx.h>
+
+// markers found with less confidence should be listened to
+#define DOUBTFUL_RELEASE_CONFIDENCE 0.5f
+
+// Finds where the key was released in an attack sample recorded with its
+// release, and where the release has died away. A 10 ms energy envelope of
+// the sample gives the level of the sustained tone and the last moment the
+// tone is still held at it. The spectral flux around that moment then shows
+// where the spectrum starts falling, which is taken as the cue point. The
+// release ends where the envelope reaches the noise floor of the recording,
+// or 60 dB below the sustain if the recording is quieter than that.
+// The confidence, between 0 and 1, tells how clear the release was: a deep
+// drop from a steady tone at a sharp change of the spectrum scores highest.
+class ReleaseMarkerDetector {
+public:
+	ReleaseMarkerDetector();
+	~ReleaseMarkerDetector();
+
+	// the release is only searched for after the attack start and the given frame,
+	// which should be the end of the last loop of the attack
+	bool findMarkers(wxString fullPath, int attackStart, int searchFrom);
+	int getCuePoint();
+	// -1 if the release lasts until the end of the sample
+	int getReleaseEnd();
+	float getConfidence();
+	wxString getErrorMessage();
+
+private:
+	int m_cuePoint;
+	int m_releaseEnd;
+	float m_confidence;
+	wxString m_errorMessage;
+};
+
+#endif
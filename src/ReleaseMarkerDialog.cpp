@@ -0,0 +1,160 @@
+/*
+ * ReleaseMarkerDialog.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ReleaseMarkerDialog.h"
+#include <wx/statline.h>
+
+IMPLEMENT_CLASS(ReleaseMarkerDialog, wxDialog)
+
+ReleaseMarkerDialog::ReleaseMarkerDialog(ReleaseMarkerFinder &finder) {
+	Init(finder);
+}
+
+ReleaseMarkerDialog::ReleaseMarkerDialog(
+	ReleaseMarkerFinder &finder,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(finder);
+	Create(parent, id, caption, pos, size, style);
+}
+
+ReleaseMarkerDialog::~ReleaseMarkerDialog() {
+
+}
+
+void ReleaseMarkerDialog::Init(ReleaseMarkerFinder &finder) {
+	m_finder = &finder;
+	m_markerList = NULL;
+	m_skipDoubtfulBox = NULL;
+}
+
+bool ReleaseMarkerDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void ReleaseMarkerDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxString::Format(
+			wxT("Releases were found in %u of %u attacks, %u of them with a confidence below %.1f that should be listened to."),
+			m_finder->getNumberOfFound(),
+			m_finder->getNumberOfAttacks(),
+			m_finder->getNumberOfDoubtful(DOUBTFUL_RELEASE_CONFIDENCE),
+			DOUBTFUL_RELEASE_CONFIDENCE
+		)
+	);
+	firstRow->Add(summaryText, 1, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW);
+
+	m_markerList = new wxListCtrl(
+		this,
+		wxID_ANY,
+		wxDefaultPosition,
+		wxSize(900, 400),
+		wxLC_REPORT|wxLC_SINGLE_SEL
+	);
+	m_markerList->InsertColumn(0, wxT("Rank"));
+	m_markerList->InsertColumn(1, wxT("Pipe"));
+	m_markerList->InsertColumn(2, wxT("Confidence"));
+	m_markerList->InsertColumn(3, wxT("Cuepoint"));
+	m_markerList->InsertColumn(4, wxT("Release end"));
+	m_markerList->InsertColumn(5, wxT("Sample"));
+	m_markerList->SetColumnWidth(0, 150);
+	m_markerList->SetColumnWidth(1, 50);
+	m_markerList->SetColumnWidth(2, 90);
+	m_markerList->SetColumnWidth(3, 90);
+	m_markerList->SetColumnWidth(4, 90);
+	m_markerList->SetColumnWidth(5, 420);
+	for (unsigned i = 0; i < m_finder->getNumberOfAttacks(); i++) {
+		const ReleaseMarkers &markers = m_finder->getMarkersAt(i);
+		long item = m_markerList->InsertItem(i, markers.rankName);
+		m_markerList->SetItem(item, 1, wxString::Format(wxT("%u"), markers.pipeNumber));
+		if (markers.isFound) {
+			m_markerList->SetItem(item, 2, wxString::Format(wxT("%.2f"), markers.confidence));
+			m_markerList->SetItem(item, 3, wxString::Format(wxT("%d"), markers.cuePoint));
+			m_markerList->SetItem(item, 4, wxString::Format(wxT("%d"), markers.releaseEnd));
+			m_markerList->SetItem(item, 5, markers.samplePath);
+		} else {
+			// the reason is shown where the sample would be
+			m_markerList->SetItem(item, 2, wxT("-"));
+			m_markerList->SetItem(item, 5, markers.errorMessage);
+		}
+	}
+	mainSizer->Add(m_markerList, 1, wxGROW|wxALL, 5);
+
+	m_skipDoubtfulBox = new wxCheckBox(
+		this,
+		wxID_ANY,
+		wxString::Format(wxT("Leave out the markers with a confidence below %.1f"), DOUBTFUL_RELEASE_CONFIDENCE),
+		wxDefaultPosition,
+		wxDefaultSize
+	);
+	m_skipDoubtfulBox->SetValue(false);
+	mainSizer->Add(m_skipDoubtfulBox, 0, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theCancelButton = new wxButton(
+		this,
+		wxID_CANCEL,
+		wxT("Cancel")
+	);
+	bottomRow->Add(theCancelButton, 0, wxALIGN_CENTER|wxALL, 10);
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Apply release markers")
+	);
+	theOkButton->Enable(m_finder->getNumberOfFound() > 0);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+bool ReleaseMarkerDialog::IsSkippingDoubtful() {
+	return m_skipDoubtfulBox->GetValue();
+}
@@ -0,0 +1,75 @@
+/*
+ * ReleaseMarkerDialog.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RELEASEMARKERDIALOG_H
+#define RELEASEMARKERDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include "ReleaseMarkerFinder.h"
+
+// Lists the release markers found by a ReleaseMarkerFinder with the least
+// certain first. Nothing is changed here, the caller applies the markers if
+// the dialog returns wxID_OK.
+class ReleaseMarkerDialog : public wxDialog {
+	DECLARE_CLASS(ReleaseMarkerDialog)
+
+public:
+	// Constructors
+	ReleaseMarkerDialog(ReleaseMarkerFinder &finder);
+	ReleaseMarkerDialog(
+		ReleaseMarkerFinder &finder,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Release Markers Found"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~ReleaseMarkerDialog();
+
+	// Initialize our variables
+	void Init(ReleaseMarkerFinder &finder);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Release Markers Found"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+	// Accessors
+	bool IsSkippingDoubtful();
+
+private:
+	ReleaseMarkerFinder *m_finder;
+
+	wxListCtrl *m_markerList;
+	wxCheckBox *m_skipDoubtfulBox;
+};
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * ReleaseMarkerFinder.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "ReleaseMarkerFinder.h"
+#include <algorithm>
+
+ReleaseMarkers::ReleaseMarkers() {
+	attack = NULL;
+	rankName = wxEmptyString;
+	pipeNumber = 0;
+	samplePath = wxEmptyString;
+	attackStart = 0;
+	searchFrom = 0;
+	isFound = false;
+	cuePoint = -1;
+	releaseEnd = -1;
+	confidence = 0;
+	errorMessage = wxEmptyString;
+}
+
+ReleaseMarkerFinder::ReleaseMarkerFinder(bool replaceExisting) {
+	m_replaceExisting = replaceExisting;
+}
+
+ReleaseMarkerFinder::~ReleaseMarkerFinder() {
+
+}
+
+void ReleaseMarkerFinder::addRank(Rank *rank, wxString rankName) {
+	unsigned pipeNumber = 0;
+	for (Pipe& pipe : rank->m_pipes) {
+		pipeNumber++;
+		for (Attack& atk : pipe.m_attacks) {
+			if (atk.isDummy() || atk.isReference())
+				continue;
+			if (!atk.loadRelease || (atk.cuePoint != -1 && !m_replaceExisting))
+				continue;
+
+			ReleaseMarkers markers;
+			markers.attack = &atk;
+			markers.rankName = rankName;
+			markers.pipeNumber = pipeNumber;
+			markers.samplePath = atk.getFullPath();
+			markers.attackStart = atk.attackStart;
+			// the release can't start before the loops have been played
+			for (const Loop& loop : atk.m_loops) {
+				if (loop.end > markers.searchFrom)
+					markers.searchFrom = loop.end;
+			}
+			m_markers.push_back(markers);
+		}
+	}
+}
+
+void ReleaseMarkerFinder::addOrgan(Organ *organ) {
+	for (unsigned i = 0; i < organ->getNumberOfRanks(); i++) {
+		Rank *rank = organ->getOrganRankAt(i);
+		addRank(rank, rank->getName());
+	}
+	for (unsigned i = 0; i < organ->getNumberOfStops(); i++) {
+		Stop *stop = organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank() && stop->getInternalRank())
+			addRank(stop->getInternalRank(), stop->getName());
+	}
+}
+
+unsigned ReleaseMarkerFinder::getNumberOfAttacks() {
+	return m_markers.size();
+}
+
+bool ReleaseMarkerFinder::findMarkers(WorkerPool &pool, BackgroundTask *task) {
+	if (task)
+		task->setTotalSteps(m_markers.size());
+
+	pool.parallelFor(m_markers.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+		ReleaseMarkers &markers = m_markers[i];
+		ReleaseMarkerDetector detector;
+		if (detector.findMarkers(markers.samplePath, markers.attackStart, markers.searchFrom)) {
+			markers.isFound = true;
+			markers.cuePoint = detector.getCuePoint();
+			markers.releaseEnd = detector.getReleaseEnd();
+			markers.confidence = detector.getConfidence();
+			if (task)
+				task->addItemsFound(1);
+		} else {
+			markers.errorMessage = detector.getErrorMessage();
+		}
+		if (task)
+			task->stepDone();
+	});
+
+	if (task && task->isCancelled())
+		return false;
+
+	std::stable_sort(m_markers.begin(), m_markers.end(), [](const ReleaseMarkers &a, const ReleaseMarkers &b) {
+		if (a.isFound != b.isFound)
+			return a.isFound;
+		return a.isFound && a.confidence < b.confidence;
+	});
+	return true;
+}
+
+const ReleaseMarkers& ReleaseMarkerFinder::getMarkersAt(unsigned index) {
+	return m_markers[index];
+}
+
+unsigned ReleaseMarkerFinder::getNumberOfFound() {
+	unsigned count = 0;
+	for (const ReleaseMarkers& markers : m_markers) {
+		if (markers.isFound)
+			count++;
+	}
+	return count;
+}
+
+unsigned ReleaseMarkerFinder::getNumberOfDoubtful(float minConfidence) {
+	unsigned count = 0;
+	for (const ReleaseMarkers& markers : m_markers) {
+		if (markers.isFound && markers.confidence < minConfidence)
+			count++;
+	}
+	return count;
+}
+
+void ReleaseMarkerFinder::applyMarkers(float minConfidence) {
+	for (const ReleaseMarkers& markers : m_markers) {
+		if (!markers.isFound || markers.confidence < minConfidence)
+			continue;
+		markers.attack->cuePoint = markers.cuePoint;
+		markers.attack->releaseEnd = markers.releaseEnd;
+		markers.attack->releaseMarkerConfidence = markers.confidence;
+	}
+}
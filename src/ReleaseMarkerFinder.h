@@ -0,0 +1,79 @@
+/*
+ * ReleaseMarkerFinder.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RELEASEMARKERFINDER_H
+#define RELEASEMARKERFINDER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "Organ.h"
+#include "BackgroundTask.h"
+#include "WorkerPool.h"
+#include "ReleaseMarkerDetector.h"
+
+// What was found for one attack. The pipe number is 1 based.
+class ReleaseMarkers {
+public:
+	ReleaseMarkers();
+
+	Attack *attack;
+	wxString rankName;
+	unsigned pipeNumber;
+	wxString samplePath;
+	int attackStart;
+	int searchFrom;
+	bool isFound;
+	int cuePoint;
+	int releaseEnd;
+	float confidence;
+	wxString errorMessage;
+};
+
+// Sets the CuePoint and ReleaseEnd of the attacks of a rank or a whole organ
+// that have their release recorded in the same sample. Only attacks that load
+// their release and have no cue point yet are searched unless existing cue
+// points should be replaced. The markers are found in parallel by
+// ReleaseMarkerDetectors after the last loop of each attack and only applied
+// afterwards, together with the confidence so that doubtful attacks can be
+// found again in the attack dialog.
+class ReleaseMarkerFinder {
+public:
+	ReleaseMarkerFinder(bool replaceExisting);
+	~ReleaseMarkerFinder();
+
+	void addRank(Rank *rank, wxString rankName);
+	// all the ranks of the organ and the internal ranks of its stops
+	void addOrgan(Organ *organ);
+	unsigned getNumberOfAttacks();
+	// false if cancelled, the markers are sorted with the least certain first
+	// and the attacks where nothing was found last
+	bool findMarkers(WorkerPool &pool, BackgroundTask *task = NULL);
+	const ReleaseMarkers& getMarkersAt(unsigned index);
+	unsigned getNumberOfFound();
+	unsigned getNumberOfDoubtful(float minConfidence);
+	// markers with less confidence are left out
+	void applyMarkers(float minConfidence = 0);
+
+private:
+	bool m_replaceExisting;
+	std::vector<ReleaseMarkers> m_markers;
+};
+
+#endif
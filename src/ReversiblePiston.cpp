@@ -59,7 +59,7 @@ void ReversiblePiston::write(wxTextFile *outFile) {
 	}
 }
 
-void ReversiblePiston::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void ReversiblePiston::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	Button::read(cfg, usingOldPanelFormat);
 	wxString type = cfg->Read("ObjectType", wxEmptyString);
 	if (type.IsSameAs(wxT("STOP"), false)) {
@@ -0,0 +1,341 @@
+/*
+ * RiffChunkReader.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "RiffChunkReader.h"
+#include <cstring>
+
+// how much is read at once, enough for all header chunks of most samples
+static size_t const REGION_SIZE = 65536;
+// larger chunks than this (except the audio data) are listed but not read
+static unsigned const MAX_CHUNK_READ = 4194304;
+// the wavpack block header and the metadata sub block ids of interest
+static size_t const WAVPACK_HEADER_SIZE = 32;
+static unsigned char const WAVPACK_ID_UNIQUE = 0x3f;
+static unsigned char const WAVPACK_ID_CHANNEL_INFO = 0x0d;
+static unsigned char const WAVPACK_ID_SAMPLE_RATE = 0x27;
+static unsigned char const WAVPACK_ID_ODD_SIZE = 0x40;
+static unsigned char const WAVPACK_ID_LARGE = 0x80;
+static unsigned char const WAVPACK_ID_RIFF_HEADER = 0x21;
+static unsigned char const WAVPACK_ID_RIFF_TRAILER = 0x22;
+
+RiffChunk::RiffChunk() {
+	memset(id, 0, 4);
+	size = 0;
+	offset = 0;
+	data = NULL;
+}
+
+bool RiffChunk::hasId(const char *fourCC) const {
+	return memcmp(id, fourCC, 4) == 0;
+}
+
+WavpackBlock::WavpackBlock() {
+	offset = 0;
+	size = 0;
+	version = 0;
+	totalSamples = 0;
+	blockIndex = 0;
+	blockSamples = 0;
+	flags = 0;
+	sampleRate = 0;
+	numberOfChannels = 0;
+}
+
+RiffChunkReader::RiffChunkReader() {
+	m_fileLength = 0;
+	m_isRiff = false;
+	m_isWavpack = false;
+	m_isTruncated = false;
+	memset(m_formType, 0, 4);
+	m_errorMessage = wxEmptyString;
+}
+
+RiffChunkReader::~RiffChunkReader() {
+
+}
+
+bool RiffChunkReader::readFile(wxString fileName) {
+	m_regions.clear();
+	m_chunks.clear();
+	m_wavpackBlocks.clear();
+	m_isRiff = false;
+	m_isWavpack = false;
+	m_isTruncated = false;
+
+	wxFile file;
+	if (!wxFileExists(fileName) || !file.Open(fileName, wxFile::read)) {
+		m_errorMessage = wxT("Failed to open stream.");
+		return false;
+	}
+
+	m_fileLength = file.Length();
+	const unsigned char *header = getBytes(file, 0, 12);
+	if (!header) {
+		// the file might still be long enough for the caller to recognize
+		if (m_fileLength > 0)
+			getBytes(file, 0, m_fileLength);
+		return true;
+	}
+
+	if (memcmp(header, "RIFF", 4) == 0) {
+		m_isRiff = true;
+		memcpy(m_formType, header + 8, 4);
+		walkChunks(file);
+	} else if (memcmp(header, "wvpk", 4) == 0) {
+		m_isWavpack = true;
+		walkWavpackBlocks(file);
+	}
+
+	return true;
+}
+
+bool RiffChunkReader::startsWith(const char *fourCC) const {
+	size_t length;
+	const unsigned char *start = getStart(length);
+	return start && length >= 4 && memcmp(start, fourCC, 4) == 0;
+}
+
+const unsigned char* RiffChunkReader::getStart(size_t &length) const {
+	if (m_regions.empty() || m_regions.front().offset != 0) {
+		length = 0;
+		return NULL;
+	}
+
+	length = m_regions.front().bytes.size();
+	return m_regions.front().bytes.data();
+}
+
+bool RiffChunkReader::isRiff() const {
+	return m_isRiff;
+}
+
+bool RiffChunkReader::isWavpack() const {
+	return m_isWavpack;
+}
+
+unsigned RiffChunkReader::getNumberOfWavpackBlocks() const {
+	return m_wavpackBlocks.size();
+}
+
+const WavpackBlock& RiffChunkReader::getWavpackBlockAt(unsigned index) const {
+	return m_wavpackBlocks[index];
+}
+
+bool RiffChunkReader::hasFormType(const char *fourCC) const {
+	return m_isRiff && memcmp(m_formType, fourCC, 4) == 0;
+}
+
+bool RiffChunkReader::isTruncated() const {
+	return m_isTruncated;
+}
+
+unsigned RiffChunkReader::getNumberOfChunks() const {
+	return m_chunks.size();
+}
+
+const RiffChunk& RiffChunkReader::getChunkAt(unsigned index) const {
+	return m_chunks[index];
+}
+
+const RiffChunk* RiffChunkReader::findChunk(const char *fourCC, unsigned fromIndex, unsigned *foundIndex) const {
+	for (unsigned i = fromIndex; i < m_chunks.size(); i++) {
+		if (m_chunks[i].hasId(fourCC)) {
+			if (foundIndex)
+				*foundIndex = i;
+			return &m_chunks[i];
+		}
+	}
+	return NULL;
+}
+
+wxString RiffChunkReader::getErrorMessage() const {
+	return m_errorMessage;
+}
+
+unsigned RiffChunkReader::readUnsigned(const unsigned char *data) {
+	// riff data is always little endian whatever the host is
+	return (unsigned) data[0] | ((unsigned) data[1] << 8) | ((unsigned) data[2] << 16) | ((unsigned) data[3] << 24);
+}
+
+unsigned short RiffChunkReader::readUnsignedShort(const unsigned char *data) {
+	return (unsigned short) (data[0] | (data[1] << 8));
+}
+
+const unsigned char* RiffChunkReader::getBytes(wxFile &file, wxFileOffset offset, size_t length, size_t readAhead) {
+	if (offset < 0 || offset + (wxFileOffset) length > m_fileLength)
+		return NULL;
+
+	for (const Region& region : m_regions) {
+		if (offset >= region.offset && offset + (wxFileOffset) length <= region.offset + (wxFileOffset) region.bytes.size())
+			return region.bytes.data() + (offset - region.offset);
+	}
+
+	// a new region is read from the offset on, as much as there is up to the region size
+	if (readAhead == 0)
+		readAhead = REGION_SIZE;
+	size_t toRead = length > readAhead ? length : readAhead;
+	if (offset + (wxFileOffset) toRead > m_fileLength)
+		toRead = m_fileLength - offset;
+
+	Region region;
+	region.offset = offset;
+	region.bytes.resize(toRead);
+	if (file.Seek(offset, wxFromStart) != offset)
+		return NULL;
+	if (file.Read(region.bytes.data(), toRead) != (ssize_t) toRead)
+		return NULL;
+
+	m_regions.push_back(std::move(region));
+	return m_regions.back().bytes.data();
+}
+
+void RiffChunkReader::walkChunks(wxFile &file) {
+	wxFileOffset offset = 12;
+	while (offset + 8 <= m_fileLength) {
+		const unsigned char *header = getBytes(file, offset, 8);
+		if (!header)
+			break;
+
+		RiffChunk chunk;
+		memcpy(chunk.id, header, 4);
+		chunk.size = readUnsigned(header + 4);
+		chunk.offset = offset + 8;
+
+		// the audio data is never needed to describe a sample so it's skipped
+		if (!chunk.hasId("data") && chunk.size <= MAX_CHUNK_READ)
+			chunk.data = getBytes(file, chunk.offset, chunk.size);
+
+		m_chunks.push_back(chunk);
+		offset = chunk.offset + chunk.size + (chunk.size & 1);
+		if (chunk.offset + chunk.size > m_fileLength)
+			m_isTruncated = true;
+	}
+}
+
+void RiffChunkReader::walkChunksInMemory(const unsigned char *data, size_t length, wxFileOffset fileOffset) {
+	size_t position = 0;
+	while (position + 8 <= length) {
+		RiffChunk chunk;
+		memcpy(chunk.id, data + position, 4);
+		chunk.size = readUnsigned(data + position + 4);
+		chunk.offset = fileOffset + position + 8;
+
+		// in a stored riff header the data chunk is the last one and its samples aren't there
+		bool isData = chunk.hasId("data");
+		if (!isData && position + 8 + chunk.size <= length)
+			chunk.data = data + position + 8;
+
+		m_chunks.push_back(chunk);
+		if (isData)
+			break;
+		position += 8 + chunk.size + (chunk.size & 1);
+	}
+}
+
+void RiffChunkReader::walkWavpackBlocks(wxFile &file) {
+	// only the block headers are read, not the audio in between them
+	wxFileOffset offset = 0;
+	while (offset + (wxFileOffset) WAVPACK_HEADER_SIZE <= m_fileLength) {
+		const unsigned char *header = getBytes(file, offset, WAVPACK_HEADER_SIZE, WAVPACK_HEADER_SIZE);
+		if (!header || memcmp(header, "wvpk", 4) != 0)
+			break;
+
+		WavpackBlock block;
+		block.offset = offset;
+		block.size = readUnsigned(header + 4) + 8;
+		block.version = readUnsignedShort(header + 8);
+		block.totalSamples = readUnsigned(header + 12);
+		block.blockIndex = readUnsigned(header + 16);
+		block.blockSamples = readUnsigned(header + 20);
+		block.flags = readUnsigned(header + 24);
+		if (block.size < WAVPACK_HEADER_SIZE)
+			break;
+		if (offset + block.size > m_fileLength) {
+			m_isTruncated = true;
+			break;
+		}
+
+		m_wavpackBlocks.push_back(block);
+		offset += block.size;
+	}
+
+	if (m_wavpackBlocks.empty())
+		return;
+
+	// the riff header is stored in the first block and the trailer in the last
+	walkWavpackMetadata(file, m_wavpackBlocks.front(), true);
+	if (m_wavpackBlocks.size() > 1)
+		walkWavpackMetadata(file, m_wavpackBlocks.back(), false);
+}
+
+void RiffChunkReader::walkWavpackMetadata(wxFile &file, WavpackBlock &block, bool inFirstBlock) {
+	wxFileOffset position = block.offset + WAVPACK_HEADER_SIZE;
+	wxFileOffset blockEnd = block.offset + block.size;
+	while (position + 2 <= blockEnd) {
+		const unsigned char *subBlock = getBytes(file, position, 2);
+		if (!subBlock)
+			return;
+
+		unsigned char id = subBlock[0];
+		size_t length = subBlock[1] * 2;
+		wxFileOffset dataOffset = position + 2;
+		if (id & WAVPACK_ID_LARGE) {
+			subBlock = getBytes(file, position, 4);
+			if (!subBlock)
+				return;
+			length = (subBlock[1] | (subBlock[2] << 8) | (subBlock[3] << 16)) * 2;
+			dataOffset = position + 4;
+		}
+		if (dataOffset + (wxFileOffset) length > blockEnd)
+			return;
+
+		size_t dataLength = length;
+		if ((id & WAVPACK_ID_ODD_SIZE) && dataLength > 0)
+			dataLength--;
+
+		unsigned char function = id & WAVPACK_ID_UNIQUE;
+		if (function == WAVPACK_ID_RIFF_HEADER && inFirstBlock) {
+			const unsigned char *riff = getBytes(file, dataOffset, dataLength);
+			if (riff && dataLength >= 12 && memcmp(riff, "RIFF", 4) == 0) {
+				m_isRiff = true;
+				memcpy(m_formType, riff + 8, 4);
+				walkChunksInMemory(riff + 12, dataLength - 12, dataOffset + 12);
+			}
+		} else if (function == WAVPACK_ID_RIFF_TRAILER) {
+			const unsigned char *trailer = getBytes(file, dataOffset, dataLength);
+			if (trailer)
+				walkChunksInMemory(trailer, dataLength, dataOffset);
+		} else if (function == WAVPACK_ID_SAMPLE_RATE && dataLength >= 3) {
+			// only used when the rate isn't one of those that the block flags can tell
+			const unsigned char *rate = getBytes(file, dataOffset, dataLength);
+			if (rate)
+				block.sampleRate = rate[0] | (rate[1] << 8) | (rate[2] << 16) | (dataLength >= 4 ? (rate[3] & 0x7f) << 24 : 0);
+		} else if (function == WAVPACK_ID_CHANNEL_INFO && dataLength >= 1) {
+			// newer files with up to 4096 channels use a longer form
+			const unsigned char *channels = getBytes(file, dataOffset, dataLength);
+			if (channels && dataLength >= 6)
+				block.numberOfChannels = (channels[0] | ((channels[2] & 0x0f) << 8)) + 1;
+			else if (channels)
+				block.numberOfChannels = channels[0];
+		}
+
+		position = dataOffset + length;
+	}
+}
@@ -0,0 +1,116 @@
+/*
+ * RiffChunkReader.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef RIFFCHUNKREADER_H
+#define RIFFCHUNKREADER_H
+
+#include <wx/wx.h>
+#include <wx/file.h>
+#include <list>
+#include <vector>
+
+// One chunk of a RIFF file. The data points straight into the buffer that the
+// file was read into, so nothing is copied. It's NULL for chunks that never
+// are read, like the audio data itself.
+class RiffChunk {
+public:
+	RiffChunk();
+
+	char id[4];
+	unsigned size;
+	wxFileOffset offset;
+	const unsigned char *data;
+
+	bool hasId(const char *fourCC) const;
+};
+
+// The header of one block of a WavPack file. The sample rate and channel
+// count are only set when the metadata of the block has them (0 otherwise),
+// which is only looked for in the first and last block.
+class WavpackBlock {
+public:
+	WavpackBlock();
+
+	wxFileOffset offset;
+	unsigned size;
+	unsigned short version;
+	unsigned totalSamples;
+	unsigned blockIndex;
+	unsigned blockSamples;
+	unsigned flags;
+	unsigned sampleRate;
+	unsigned numberOfChannels;
+};
+
+// Reads the header region of a file in one go and walks all the chunks of it
+// from memory. The audio data is skipped, so a typical wave file is read with
+// one read for the chunks before the data and one for those after it. For a
+// WavPack file only the block headers are read, and the chunks are taken from
+// the RIFF header and trailer that WavPack keeps of the original wave file.
+class RiffChunkReader {
+public:
+	RiffChunkReader();
+	~RiffChunkReader();
+
+	bool readFile(wxString fileName);
+	bool startsWith(const char *fourCC) const;
+	const unsigned char* getStart(size_t &length) const;
+	bool isRiff() const;
+	bool isWavpack() const;
+	unsigned getNumberOfWavpackBlocks() const;
+	const WavpackBlock& getWavpackBlockAt(unsigned index) const;
+	bool hasFormType(const char *fourCC) const;
+	// true if a chunk or wavpack block claims to go on past the end of the file
+	bool isTruncated() const;
+	unsigned getNumberOfChunks() const;
+	const RiffChunk& getChunkAt(unsigned index) const;
+	// the first chunk with the id at or after the index, or NULL
+	const RiffChunk* findChunk(const char *fourCC, unsigned fromIndex = 0, unsigned *foundIndex = NULL) const;
+	wxString getErrorMessage() const;
+
+	static unsigned readUnsigned(const unsigned char *data);
+	static unsigned short readUnsignedShort(const unsigned char *data);
+
+private:
+	class Region {
+	public:
+		wxFileOffset offset;
+		std::vector<unsigned char> bytes;
+	};
+
+	// regions are never removed while reading so the chunk data stays valid
+	std::list<Region> m_regions;
+	std::vector<RiffChunk> m_chunks;
+	std::vector<WavpackBlock> m_wavpackBlocks;
+	wxFileOffset m_fileLength;
+	bool m_isRiff;
+	bool m_isWavpack;
+	bool m_isTruncated;
+	char m_formType[4];
+	wxString m_errorMessage;
+
+	const unsigned char* getBytes(wxFile &file, wxFileOffset offset, size_t length, size_t readAhead = 0);
+	void walkChunks(wxFile &file);
+	void walkChunksInMemory(const unsigned char *data, size_t length, wxFileOffset fileOffset);
+	void walkWavpackBlocks(wxFile &file);
+	void walkWavpackMetadata(wxFile &file, WavpackBlock &block, bool inFirstBlock);
+};
+
+#endif
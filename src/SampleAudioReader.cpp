@@ -0,0 +1,154 @@
+/*
+ * SampleAudioReader.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleAudioReader.h"
+#include "WAVfileParser.h"
+#include <cstring>
+
+SampleAudioReader::SampleAudioReader() {
+	m_dataOffset = -1;
+	m_numberOfFrames = 0;
+	m_numberOfChannels = 0;
+	m_sampleRate = 0;
+	m_bitsPerSample = 0;
+	m_sampleFormat = 0;
+	m_bytesPerFrame = 0;
+	m_errorMessage = wxEmptyString;
+}
+
+SampleAudioReader::~SampleAudioReader() {
+
+}
+
+bool SampleAudioReader::open(wxString fullPath) {
+	if (m_file.IsOpened())
+		m_file.Close();
+	m_numberOfFrames = 0;
+
+	WAVfileParser parser(fullPath);
+	if (!parser.isWavOk()) {
+		m_errorMessage = parser.getErrorMessage();
+		return false;
+	}
+	if (parser.isWavpack() || parser.getDataOffset() < 0) {
+		m_errorMessage = wxT("WavPack compressed samples can't be decoded.");
+		return false;
+	}
+
+	m_dataOffset = parser.getDataOffset();
+	m_numberOfFrames = parser.getNumberOfFrames();
+	m_numberOfChannels = parser.getNumberOfChannels();
+	m_sampleRate = parser.getSampleRate();
+	m_bitsPerSample = parser.getBitsPerSample();
+	m_sampleFormat = parser.getSampleFormat();
+
+	bool supported = false;
+	if (m_sampleFormat == 1)
+		supported = m_bitsPerSample == 8 || m_bitsPerSample == 16 || m_bitsPerSample == 24 || m_bitsPerSample == 32;
+	else if (m_sampleFormat == 3)
+		supported = m_bitsPerSample == 32;
+	if (!supported || m_numberOfChannels == 0) {
+		m_errorMessage = wxString::Format(wxT("Decoding %u bit samples of format %u isn't supported."), (unsigned) m_bitsPerSample, (unsigned) m_sampleFormat);
+		m_numberOfFrames = 0;
+		return false;
+	}
+	m_bytesPerFrame = m_bitsPerSample / 8 * m_numberOfChannels;
+
+	if (!m_file.Open(fullPath, wxFile::read)) {
+		m_errorMessage = wxT("Failed to open stream.");
+		m_numberOfFrames = 0;
+		return false;
+	}
+	return true;
+}
+
+bool SampleAudioReader::readFrames(unsigned firstFrame, unsigned numberOfFrames, std::vector<float> &samples) {
+	samples.clear();
+	if (!m_file.IsOpened() || firstFrame >= m_numberOfFrames)
+		return false;
+	if (numberOfFrames > m_numberOfFrames - firstFrame)
+		numberOfFrames = m_numberOfFrames - firstFrame;
+	if (numberOfFrames == 0)
+		return false;
+
+	size_t length = (size_t) numberOfFrames * m_bytesPerFrame;
+	wxFileOffset offset = m_dataOffset + (wxFileOffset) firstFrame * m_bytesPerFrame;
+	m_buffer.resize(length);
+	if (m_file.Seek(offset, wxFromStart) != offset || m_file.Read(m_buffer.data(), length) != (ssize_t) length) {
+		m_errorMessage = wxT("Failed to read the audio data.");
+		return false;
+	}
+
+	// plain loops that the compiler can vectorize, one for each sample format
+	size_t count = (size_t) numberOfFrames * m_numberOfChannels;
+	samples.resize(count);
+	const unsigned char *src = m_buffer.data();
+	float *dst = samples.data();
+	if (m_sampleFormat == 3) {
+		memcpy(dst, src, count * sizeof(float));
+	} else if (m_bitsPerSample == 8) {
+		for (size_t i = 0; i < count; i++)
+			dst[i] = ((int) src[i] - 128) * (1.0f / 128.0f);
+	} else if (m_bitsPerSample == 16) {
+		for (size_t i = 0; i < count; i++)
+			dst[i] = (short) (src[i * 2] | (src[i * 2 + 1] << 8)) * (1.0f / 32768.0f);
+	} else if (m_bitsPerSample == 24) {
+		for (size_t i = 0; i < count; i++) {
+			int value = (int) ((src[i * 3] << 8) | (src[i * 3 + 1] << 16) | ((unsigned) src[i * 3 + 2] << 24));
+			dst[i] = (value >> 8) * (1.0f / 8388608.0f);
+		}
+	} else {
+		for (size_t i = 0; i < count; i++) {
+			int value = (int) (src[i * 4] | (src[i * 4 + 1] << 8) | (src[i * 4 + 2] << 16) | ((unsigned) src[i * 4 + 3] << 24));
+			dst[i] = value * (1.0f / 2147483648.0f);
+		}
+	}
+	return true;
+}
+
+bool SampleAudioReader::getSustainRegion(int attackStart, int cuePoint, unsigned &start, unsigned &end) {
+	start = m_numberOfFrames / 4;
+	end = m_numberOfFrames * 3 / 4;
+	if (cuePoint > 0 && (unsigned) cuePoint <= m_numberOfFrames)
+		end = cuePoint;
+	if (attackStart > 0 && (unsigned) attackStart > start)
+		start = attackStart;
+	return start < end;
+}
+
+unsigned SampleAudioReader::getNumberOfFrames() {
+	return m_numberOfFrames;
+}
+
+unsigned short SampleAudioReader::getNumberOfChannels() {
+	return m_numberOfChannels;
+}
+
+unsigned SampleAudioReader::getSampleRate() {
+	return m_sampleRate;
+}
+
+unsigned SampleAudioReader::getBytesPerFrame() {
+	return m_bytesPerFrame;
+}
+
+wxString SampleAudioReader::getErrorMessage() {
+	return m_errorMessage;
+}
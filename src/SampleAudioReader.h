@@ -0,0 +1,63 @@
+/*
+ * SampleAudioReader.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEAUDIOREADER_H
+#define SAMPLEAUDIOREADER_H
+
+#include <wx/wx.h>
+#include <wx/file.h>
+#include <vector>
+
+// Decodes the audio data of an uncompressed wave file into interleaved
+// floats between -1 and 1. Unsigned 8 bit, signed 16, 24 and 32 bit PCM and
+// 32 bit float are understood. The header is parsed by open() and any range
+// of frames can then be read without reading the rest of the file. WavPack
+// compressed files can't be decoded here, open() fails for them.
+class SampleAudioReader {
+public:
+	SampleAudioReader();
+	~SampleAudioReader();
+
+	bool open(wxString fullPath);
+	// the frames read are clipped to the end of the data, returns false if nothing could be read
+	bool readFrames(unsigned firstFrame, unsigned numberOfFrames, std::vector<float> &samples);
+	// the part of the sample that is taken to hold the steady tone when nothing better is known,
+	// the middle half of it but after the attack start and before the cue point
+	bool getSustainRegion(int attackStart, int cuePoint, unsigned &start, unsigned &end);
+	unsigned getNumberOfFrames();
+	unsigned short getNumberOfChannels();
+	unsigned getSampleRate();
+	unsigned getBytesPerFrame();
+	wxString getErrorMessage();
+
+private:
+	wxFile m_file;
+	wxFileOffset m_dataOffset;
+	unsigned m_numberOfFrames;
+	unsigned short m_numberOfChannels;
+	unsigned m_sampleRate;
+	unsigned short m_bitsPerSample;
+	unsigned short m_sampleFormat;
+	unsigned m_bytesPerFrame;
+	wxString m_errorMessage;
+	std::vector<unsigned char> m_buffer;
+};
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * SampleAuditDialog.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleAuditDialog.h"
+#include "GOODFDef.h"
+#include <wx/statline.h>
+#include <algorithm>
+
+SampleAuditList::SampleAuditList(wxWindow *parent, wxWindowID id, const std::vector<SampleAuditIssue> &issues) :
+	wxListCtrl(parent, id, wxDefaultPosition, wxSize(900, 400), wxLC_REPORT|wxLC_VIRTUAL|wxLC_SINGLE_SEL),
+	m_issues(issues) {
+	m_sortColumn = -1;
+	m_sortAscending = true;
+
+	InsertColumn(0, wxT("Severity"));
+	InsertColumn(1, wxT("Rank"));
+	InsertColumn(2, wxT("Pipe"));
+	InsertColumn(3, wxT("Sample"));
+	InsertColumn(4, wxT("Problem"));
+	SetColumnWidth(0, 80);
+	SetColumnWidth(1, 150);
+	SetColumnWidth(2, 50);
+	SetColumnWidth(3, 300);
+	SetColumnWidth(4, 320);
+
+	// the auditor delivers the issues grouped by rank and pipe
+	for (unsigned i = 0; i < m_issues.size(); i++)
+		m_order.push_back(i);
+	SetItemCount(m_order.size());
+}
+
+void SampleAuditList::SortByColumn(int column) {
+	if (column == m_sortColumn)
+		m_sortAscending = !m_sortAscending;
+	else
+		m_sortAscending = true;
+	m_sortColumn = column;
+
+	// the sort is stable so that a previous sort decides the order within equal values
+	const std::vector<SampleAuditIssue> &issues = m_issues;
+	bool ascending = m_sortAscending;
+	std::stable_sort(m_order.begin(), m_order.end(), [&issues, column, ascending](unsigned a, unsigned b) {
+		const SampleAuditIssue &first = ascending ? issues[a] : issues[b];
+		const SampleAuditIssue &second = ascending ? issues[b] : issues[a];
+		switch (column) {
+			case 0:
+				return first.severity < second.severity;
+			case 1:
+				return first.rankName.CmpNoCase(second.rankName) < 0;
+			case 2:
+				return first.pipeNumber < second.pipeNumber;
+			case 3:
+				return first.samplePath.CmpNoCase(second.samplePath) < 0;
+			default:
+				return first.message.CmpNoCase(second.message) < 0;
+		}
+	});
+	Refresh();
+}
+
+wxString SampleAuditList::OnGetItemText(long item, long column) const {
+	const SampleAuditIssue &issue = m_issues[m_order[item]];
+	switch (column) {
+		case 0:
+			return issue.severity == AUDIT_ERROR ? wxT("Error") : wxT("Warning");
+		case 1:
+			return issue.rankName;
+		case 2:
+			return issue.pipeNumber ? wxString::Format(wxT("%u"), issue.pipeNumber) : wxString(wxT("-"));
+		case 3:
+			return issue.samplePath;
+		default:
+			return issue.message;
+	}
+}
+
+IMPLEMENT_CLASS(SampleAuditDialog, wxDialog)
+
+BEGIN_EVENT_TABLE(SampleAuditDialog, wxDialog)
+	EVT_LIST_COL_CLICK(ID_AUDIT_DIALOG_LIST, SampleAuditDialog::OnColumnClick)
+END_EVENT_TABLE()
+
+SampleAuditDialog::SampleAuditDialog(SampleAuditor &auditor) {
+	Init(auditor);
+}
+
+SampleAuditDialog::SampleAuditDialog(
+	SampleAuditor &auditor,
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style) {
+	Init(auditor);
+	Create(parent, id, caption, pos, size, style);
+}
+
+SampleAuditDialog::~SampleAuditDialog() {
+
+}
+
+void SampleAuditDialog::Init(SampleAuditor &auditor) {
+	m_issues = auditor.getIssues();
+	m_numberOfSamples = auditor.getNumberOfSamples();
+	m_numberOfErrors = auditor.getNumberOfErrors();
+	m_numberOfWarnings = auditor.getNumberOfWarnings();
+	m_issueList = NULL;
+}
+
+bool SampleAuditDialog::Create(
+	wxWindow* parent,
+	wxWindowID id,
+	const wxString& caption,
+	const wxPoint& pos,
+	const wxSize& size,
+	long style ) {
+	if (!wxDialog::Create(parent, id, caption, pos, size, style))
+		return false;
+
+	CreateControls();
+
+	GetSizer()->Fit(this);
+	GetSizer()->SetSizeHints(this);
+	Centre();
+
+	return true;
+}
+
+void SampleAuditDialog::CreateControls() {
+	wxBoxSizer *mainSizer = new wxBoxSizer(wxVERTICAL);
+
+	wxBoxSizer *firstRow = new wxBoxSizer(wxHORIZONTAL);
+	wxStaticText *summaryText = new wxStaticText (
+		this,
+		wxID_STATIC,
+		wxString::Format(
+			wxT("%u samples audited: %u errors and %u warnings found. Click a column title to sort by it."),
+			m_numberOfSamples,
+			m_numberOfErrors,
+			m_numberOfWarnings
+		)
+	);
+	firstRow->Add(summaryText, 1, wxALIGN_CENTER_VERTICAL|wxALL, 5);
+	mainSizer->Add(firstRow, 0, wxGROW);
+
+	m_issueList = new SampleAuditList(this, ID_AUDIT_DIALOG_LIST, m_issues);
+	mainSizer->Add(m_issueList, 1, wxGROW|wxALL, 5);
+
+	wxStaticLine *bottomDivider = new wxStaticLine(this);
+	mainSizer->Add(bottomDivider, 0, wxEXPAND);
+
+	wxBoxSizer *bottomRow = new wxBoxSizer(wxHORIZONTAL);
+	bottomRow->AddStretchSpacer();
+	wxButton *theOkButton = new wxButton(
+		this,
+		wxID_OK,
+		wxT("Close")
+	);
+	bottomRow->Add(theOkButton, 0, wxALIGN_CENTER|wxALL, 10);
+	bottomRow->AddStretchSpacer();
+	mainSizer->Add(bottomRow, 0, wxGROW);
+
+	SetSizer(mainSizer);
+}
+
+void SampleAuditDialog::OnColumnClick(wxListEvent& event) {
+	m_issueList->SortByColumn(event.GetColumn());
+}
@@ -0,0 +1,92 @@
+/*
+ * SampleAuditDialog.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEAUDITDIALOG_H
+#define SAMPLEAUDITDIALOG_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <vector>
+#include "SampleAuditor.h"
+
+// A virtual list so that even a very large report is shown at once
+class SampleAuditList : public wxListCtrl {
+public:
+	SampleAuditList(wxWindow *parent, wxWindowID id, const std::vector<SampleAuditIssue> &issues);
+
+	void SortByColumn(int column);
+
+private:
+	const std::vector<SampleAuditIssue> &m_issues;
+	std::vector<unsigned> m_order;
+	int m_sortColumn;
+	bool m_sortAscending;
+
+	wxString OnGetItemText(long item, long column) const;
+};
+
+class SampleAuditDialog : public wxDialog {
+	DECLARE_CLASS(SampleAuditDialog)
+	DECLARE_EVENT_TABLE()
+
+public:
+	// Constructors
+	SampleAuditDialog(SampleAuditor &auditor);
+	SampleAuditDialog(
+		SampleAuditor &auditor,
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Sample Audit Report"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	~SampleAuditDialog();
+
+	// Initialize our variables
+	void Init(SampleAuditor &auditor);
+
+	// Creation
+	bool Create(
+		wxWindow* parent,
+		wxWindowID id = wxID_ANY,
+		const wxString& caption = wxT("Sample Audit Report"),
+		const wxPoint& pos = wxDefaultPosition,
+		const wxSize& size = wxDefaultSize,
+		long style = wxCAPTION|wxRESIZE_BORDER|wxSYSTEM_MENU|wxCLOSE_BOX
+	);
+
+	// Creates the controls and sizers
+	void CreateControls();
+
+private:
+	std::vector<SampleAuditIssue> m_issues;
+	unsigned m_numberOfSamples;
+	unsigned m_numberOfErrors;
+	unsigned m_numberOfWarnings;
+
+	SampleAuditList *m_issueList;
+
+	// Event methods
+	void OnColumnClick(wxListEvent& event);
+};
+
+#endif
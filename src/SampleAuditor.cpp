@@ -0,0 +1,256 @@
+/*
+ * SampleAuditor.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleAuditor.h"
+#include "SampleHeaderPrefetcher.h"
+#include <algorithm>
+#include <map>
+
+SampleAuditIssue::SampleAuditIssue() {
+	severity = AUDIT_ERROR;
+	rankName = wxEmptyString;
+	pipeNumber = 0;
+	samplePath = wxEmptyString;
+	message = wxEmptyString;
+}
+
+SampleAuditor::SampleAuditor(Organ *organ, SampleMetadataCache *cache) {
+	m_cache = cache;
+	m_numberOfErrors = 0;
+
+	for (unsigned i = 0; i < organ->getNumberOfRanks(); i++) {
+		Rank *rank = organ->getOrganRankAt(i);
+		addRank(rank, rank->getName());
+	}
+	for (unsigned i = 0; i < organ->getNumberOfStops(); i++) {
+		Stop *stop = organ->getOrganStopAt(i);
+		if (stop->isUsingInternalRank() && stop->getInternalRank())
+			addRank(stop->getInternalRank(), stop->getName());
+	}
+}
+
+SampleAuditor::~SampleAuditor() {
+
+}
+
+unsigned SampleAuditor::getNumberOfSamples() {
+	return m_samples.size();
+}
+
+bool SampleAuditor::runAudit(BackgroundTask *task) {
+	m_issues.clear();
+	m_numberOfErrors = 0;
+
+	if (task)
+		task->setTotalSteps(m_samples.size());
+
+	std::vector<wxString> fullPaths;
+	fullPaths.reserve(m_samples.size());
+	for (const AuditedSample& sample : m_samples)
+		fullPaths.push_back(sample.fullPath);
+
+	// every sample gets a list of its own so that the headers can be checked as they arrive
+	std::vector<std::vector<SampleAuditIssue>> sampleIssues(m_samples.size());
+	SampleHeaderPrefetcher prefetcher(m_cache);
+	prefetcher.fetch(fullPaths, [&](unsigned i, bool found, const SampleMetadata &metadata) {
+		auditSample(m_samples[i], found, metadata, sampleIssues[i]);
+		if (task)
+			task->addItemsFound(sampleIssues[i].size());
+	}, task);
+
+	if (task && task->isCancelled())
+		return false;
+
+	std::vector<std::vector<SampleAuditIssue>> rankIssues(m_rankNames.GetCount());
+	for (unsigned i = 0; i < m_samples.size(); i++) {
+		for (SampleAuditIssue& issue : sampleIssues[i])
+			rankIssues[m_samples[i].rankIndex].push_back(std::move(issue));
+	}
+	auditFormats(rankIssues);
+
+	// the issues are kept grouped by rank and pipe in the order the ranks were added
+	for (std::vector<SampleAuditIssue>& issues : rankIssues) {
+		std::stable_sort(issues.begin(), issues.end(), [](const SampleAuditIssue &a, const SampleAuditIssue &b) {
+			return a.pipeNumber < b.pipeNumber;
+		});
+		for (SampleAuditIssue& issue : issues) {
+			if (issue.severity == AUDIT_ERROR)
+				m_numberOfErrors++;
+			m_issues.push_back(std::move(issue));
+		}
+	}
+
+	return true;
+}
+
+const std::vector<SampleAuditIssue>& SampleAuditor::getIssues() {
+	return m_issues;
+}
+
+unsigned SampleAuditor::getNumberOfErrors() {
+	return m_numberOfErrors;
+}
+
+unsigned SampleAuditor::getNumberOfWarnings() {
+	return m_issues.size() - m_numberOfErrors;
+}
+
+void SampleAuditor::addRank(Rank *rank, wxString rankName) {
+	unsigned rankIndex = m_rankNames.GetCount();
+	m_rankNames.Add(rankName);
+
+	unsigned pipeNumber = 0;
+	for (const Pipe& pipe : rank->m_pipes) {
+		pipeNumber++;
+		for (const Attack& atk : pipe.m_attacks) {
+			// dummies and borrowed pipes have no sample of their own here
+			if (atk.isDummy() || atk.isReference())
+				continue;
+
+			AuditedSample sample;
+			sample.rankIndex = rankIndex;
+			sample.pipeNumber = pipeNumber;
+			sample.fullPath = atk.getFullPath();
+			sample.isRelease = false;
+			sample.attackStart = atk.attackStart;
+			sample.cuePoint = atk.cuePoint;
+			sample.releaseEnd = atk.releaseEnd;
+			sample.loops.assign(atk.m_loops.begin(), atk.m_loops.end());
+			sample.isOk = false;
+			sample.sampleRate = 0;
+			sample.numberOfChannels = 0;
+			m_samples.push_back(sample);
+		}
+		for (const Release& rel : pipe.m_releases) {
+			AuditedSample sample;
+			sample.rankIndex = rankIndex;
+			sample.pipeNumber = pipeNumber;
+			sample.fullPath = rel.getFullPath();
+			sample.isRelease = true;
+			sample.attackStart = 0;
+			sample.cuePoint = rel.cuePoint;
+			sample.releaseEnd = rel.releaseEnd;
+			sample.isOk = false;
+			sample.sampleRate = 0;
+			sample.numberOfChannels = 0;
+			m_samples.push_back(sample);
+		}
+	}
+}
+
+void SampleAuditor::auditSample(AuditedSample &sample, bool found, const SampleMetadata &metadata, std::vector<SampleAuditIssue> &issues) {
+	if (!found) {
+		addIssue(issues, sample, AUDIT_ERROR, wxT("The sample file is missing."));
+		return;
+	}
+	if (!metadata.isOk) {
+		addIssue(issues, sample, AUDIT_ERROR, metadata.errorMessage);
+		return;
+	}
+	if (metadata.numberOfFrames == 0) {
+		addIssue(issues, sample, AUDIT_ERROR, wxT("The sample has no audio data."));
+		return;
+	}
+
+	sample.isOk = true;
+	sample.sampleRate = metadata.sampleRate;
+	sample.numberOfChannels = metadata.numberOfChannels;
+
+	int lastFrame = metadata.numberOfFrames - 1;
+	if (sample.attackStart > lastFrame)
+		addIssue(issues, sample, AUDIT_ERROR, wxString::Format(wxT("AttackStart %d is past the last frame %d."), sample.attackStart, lastFrame));
+	if (sample.cuePoint > lastFrame)
+		addIssue(issues, sample, AUDIT_ERROR, wxString::Format(wxT("CuePoint %d is past the last frame %d."), sample.cuePoint, lastFrame));
+	if (sample.releaseEnd > lastFrame)
+		addIssue(issues, sample, AUDIT_ERROR, wxString::Format(wxT("ReleaseEnd %d is past the last frame %d."), sample.releaseEnd, lastFrame));
+
+	unsigned loopNumber = 0;
+	for (const Loop& loop : sample.loops) {
+		loopNumber++;
+		if (loop.start >= loop.end)
+			addIssue(issues, sample, AUDIT_ERROR, wxString::Format(wxT("Loop %u starts at %d which isn't before its end at %d."), loopNumber, loop.start, loop.end));
+		else if (loop.end > lastFrame)
+			addIssue(issues, sample, AUDIT_ERROR, wxString::Format(wxT("Loop %u ends at %d past the last frame %d."), loopNumber, loop.end, lastFrame));
+	}
+}
+
+void SampleAuditor::auditFormats(std::vector<std::vector<SampleAuditIssue>> &rankIssues) {
+	unsigned nbrRanks = m_rankNames.GetCount();
+	std::vector<std::map<unsigned, unsigned>> ratesInRank(nbrRanks);
+	std::vector<std::map<unsigned, unsigned>> channelsInRank(nbrRanks);
+	std::map<unsigned, unsigned> ratesInOrgan;
+	for (const AuditedSample& sample : m_samples) {
+		if (!sample.isOk)
+			continue;
+		ratesInRank[sample.rankIndex][sample.sampleRate]++;
+		channelsInRank[sample.rankIndex][sample.numberOfChannels]++;
+		ratesInOrgan[sample.sampleRate]++;
+	}
+
+	auto mostUsed = [](const std::map<unsigned, unsigned> &counts) {
+		unsigned value = 0;
+		unsigned highestCount = 0;
+		for (auto& count : counts) {
+			if (count.second > highestCount) {
+				value = count.first;
+				highestCount = count.second;
+			}
+		}
+		return value;
+	};
+
+	// samples that differ from the rest of their rank are reported with the rank
+	std::vector<unsigned> rankRates(nbrRanks);
+	std::vector<unsigned> rankChannels(nbrRanks);
+	for (unsigned i = 0; i < nbrRanks; i++) {
+		rankRates[i] = mostUsed(ratesInRank[i]);
+		rankChannels[i] = mostUsed(channelsInRank[i]);
+	}
+
+	unsigned organRate = mostUsed(ratesInOrgan);
+	for (unsigned i = 0; i < nbrRanks; i++) {
+		if (ratesInRank[i].empty() || rankRates[i] == organRate)
+			continue;
+		SampleAuditIssue issue;
+		issue.severity = AUDIT_WARNING;
+		issue.rankName = m_rankNames.Item(i);
+		issue.message = wxString::Format(wxT("Most samples of the rank are %u Hz while the organ mostly uses %u Hz."), rankRates[i], organRate);
+		rankIssues[i].push_back(issue);
+	}
+
+	for (const AuditedSample& sample : m_samples) {
+		if (!sample.isOk)
+			continue;
+		if (sample.sampleRate != rankRates[sample.rankIndex])
+			addIssue(rankIssues[sample.rankIndex], sample, AUDIT_WARNING, wxString::Format(wxT("Sample rate %u Hz differs from the %u Hz of most samples in the rank."), sample.sampleRate, rankRates[sample.rankIndex]));
+		if (sample.numberOfChannels != rankChannels[sample.rankIndex])
+			addIssue(rankIssues[sample.rankIndex], sample, AUDIT_WARNING, wxString::Format(wxT("%u channel(s) while most samples in the rank have %u."), (unsigned) sample.numberOfChannels, rankChannels[sample.rankIndex]));
+	}
+}
+
+void SampleAuditor::addIssue(std::vector<SampleAuditIssue> &issues, const AuditedSample &sample, AuditSeverity severity, wxString message) {
+	SampleAuditIssue issue;
+	issue.severity = severity;
+	issue.rankName = m_rankNames.Item(sample.rankIndex);
+	issue.pipeNumber = sample.pipeNumber;
+	issue.samplePath = sample.fullPath;
+	issue.message = message;
+	issues.push_back(issue);
+}
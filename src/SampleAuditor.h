@@ -0,0 +1,94 @@
+/*
+ * SampleAuditor.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEAUDITOR_H
+#define SAMPLEAUDITOR_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "Organ.h"
+#include "SampleMetadataCache.h"
+#include "BackgroundTask.h"
+
+typedef enum {
+	AUDIT_ERROR,
+	AUDIT_WARNING
+} AuditSeverity;
+
+// One problem found with a sample. The pipe number is 1 based and 0 for
+// problems that concern the whole rank.
+class SampleAuditIssue {
+public:
+	SampleAuditIssue();
+
+	AuditSeverity severity;
+	wxString rankName;
+	unsigned pipeNumber;
+	wxString samplePath;
+	wxString message;
+};
+
+// Checks every attack and release of all the ranks of an organ, including
+// the internal ranks of stops, against what the sample files really contain.
+// The headers are read through a SampleHeaderPrefetcher and each sample is
+// checked as soon as its header has arrived. The samples are then compared
+// within their rank and the whole organ for mismatched rates and channels.
+class SampleAuditor {
+public:
+	SampleAuditor(Organ *organ, SampleMetadataCache *cache);
+	~SampleAuditor();
+
+	unsigned getNumberOfSamples();
+	// false if cancelled
+	bool runAudit(BackgroundTask *task = NULL);
+	const std::vector<SampleAuditIssue>& getIssues();
+	unsigned getNumberOfErrors();
+	unsigned getNumberOfWarnings();
+
+private:
+	// everything needed to check a sample is copied so the organ isn't touched by the workers
+	class AuditedSample {
+	public:
+		unsigned rankIndex;
+		unsigned pipeNumber;
+		wxString fullPath;
+		bool isRelease;
+		int attackStart;
+		int cuePoint;
+		int releaseEnd;
+		std::vector<Loop> loops;
+		bool isOk;
+		unsigned sampleRate;
+		unsigned short numberOfChannels;
+	};
+
+	SampleMetadataCache *m_cache;
+	wxArrayString m_rankNames;
+	std::vector<AuditedSample> m_samples;
+	std::vector<SampleAuditIssue> m_issues;
+	unsigned m_numberOfErrors;
+
+	void addRank(Rank *rank, wxString rankName);
+	void auditSample(AuditedSample &sample, bool found, const SampleMetadata &metadata, std::vector<SampleAuditIssue> &issues);
+	void auditFormats(std::vector<std::vector<SampleAuditIssue>> &rankIssues);
+	void addIssue(std::vector<SampleAuditIssue> &issues, const AuditedSample &sample, AuditSeverity severity, wxString message);
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * SampleDirectoryIndex.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleDirectoryIndex.h"
+#include <wx/dir.h>
+#include <algorithm>
+
+SampleDirectoryIndex::SampleDirectoryIndex(int firstMidiNote, int numberOfNotes, wxString samplePattern) : m_pattern(samplePattern) {
+	m_pattern.setMidiRange(firstMidiNote, firstMidiNote + numberOfNotes - 1);
+	m_indexedFiles = 0;
+}
+
+SampleDirectoryIndex::~SampleDirectoryIndex() {
+
+}
+
+bool SampleDirectoryIndex::isFolderReadable(wxString folderPath) {
+	return getFolder(folderPath).isOpened;
+}
+
+const wxArrayString& SampleDirectoryIndex::getSubFolders(wxString folderPath) {
+	return getFolder(folderPath).subFolders;
+}
+
+void SampleDirectoryIndex::appendFilesForMidiNote(wxString folderPath, int midiNote, wxArrayString &list) {
+	IndexedFolder &folder = getFolder(folderPath);
+	std::map<int, wxArrayString>::iterator it = folder.filesByMidiNote.find(midiNote);
+	if (it != folder.filesByMidiNote.end()) {
+		for (unsigned i = 0; i < it->second.GetCount(); i++)
+			list.Add(it->second.Item(i));
+	}
+}
+
+void SampleDirectoryIndex::extendMidiNoteRange(wxString folderPath, int &firstMidiNote, int &lastMidiNote) {
+	IndexedFolder &folder = getFolder(folderPath);
+	if (folder.filesByMidiNote.empty())
+		return;
+
+	firstMidiNote = std::min(firstMidiNote, folder.filesByMidiNote.begin()->first);
+	lastMidiNote = std::max(lastMidiNote, folder.filesByMidiNote.rbegin()->first);
+}
+
+bool SampleDirectoryIndex::getSampleNameInfo(wxString fullPath, SampleNameInfo &info) {
+	IndexedFolder &folder = getFolder(fullPath.BeforeLast(wxFILE_SEP_PATH));
+	std::map<wxString, SampleNameInfo>::iterator it = folder.nameInfos.find(fullPath.AfterLast(wxFILE_SEP_PATH));
+	if (it == folder.nameInfos.end())
+		return false;
+
+	info = it->second;
+	return true;
+}
+
+bool SampleDirectoryIndex::isPatternValid() const {
+	return m_pattern.isValid();
+}
+
+unsigned SampleDirectoryIndex::getNumberOfIndexedFiles() {
+	return m_indexedFiles;
+}
+
+SampleDirectoryIndex::IndexedFolder& SampleDirectoryIndex::getFolder(wxString folderPath) {
+	std::map<wxString, IndexedFolder>::iterator it = m_folders.find(folderPath);
+	if (it != m_folders.end())
+		return it->second;
+
+	IndexedFolder &folder = m_folders[folderPath];
+	indexFolder(folderPath, folder);
+	return folder;
+}
+
+void SampleDirectoryIndex::indexFolder(wxString folderPath, IndexedFolder &folder) {
+	folder.isOpened = false;
+
+	// checking first avoids wxDir logging an error for folders that don't exist
+	if (!wxDir::Exists(folderPath))
+		return;
+
+	wxDir dir(folderPath);
+	if (!dir.IsOpened())
+		return;
+
+	folder.isOpened = true;
+
+	// the folder is opened once and its entries are enumerated twice, as
+	// wxDir can only tell sub folders and files apart by asking for each kind
+	wxString name;
+	bool cont = dir.GetFirst(&name, wxEmptyString, wxDIR_DIRS);
+	while (cont) {
+		folder.subFolders.Add(name);
+		cont = dir.GetNext(&name);
+	}
+
+	cont = dir.GetFirst(&name, wxEmptyString, wxDIR_FILES);
+	while (cont) {
+		addFileToMidiNote(folderPath, name, folder);
+		m_indexedFiles++;
+		cont = dir.GetNext(&name);
+	}
+
+	for (auto& bucket : folder.filesByMidiNote) {
+		bucket.second.Sort();
+	}
+}
+
+void SampleDirectoryIndex::addFileToMidiNote(wxString folderPath, wxString fileName, IndexedFolder &folder) {
+	SampleNameInfo info;
+	if (!m_pattern.match(fileName, info))
+		return;
+
+	folder.filesByMidiNote[info.midiNote].Add(folderPath + wxFILE_SEP_PATH + fileName);
+	folder.nameInfos[fileName] = info;
+}
@@ -0,0 +1,64 @@
+/*
+ * SampleDirectoryIndex.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEDIRECTORYINDEX_H
+#define SAMPLEDIRECTORYINDEX_H
+
+#include <wx/wx.h>
+#include <map>
+#include "SamplePattern.h"
+
+// Lists every sample folder only once and keeps the files bucketed by the
+// midi note that the sample name pattern finds in their names so that all
+// the pipes of a rank can be served from memory instead of one directory
+// walk each.
+class SampleDirectoryIndex {
+public:
+	SampleDirectoryIndex(int firstMidiNote, int numberOfNotes, wxString samplePattern = DEFAULT_SAMPLE_PATTERN);
+	~SampleDirectoryIndex();
+
+	bool isFolderReadable(wxString folderPath);
+	const wxArrayString& getSubFolders(wxString folderPath);
+	void appendFilesForMidiNote(wxString folderPath, int midiNote, wxArrayString &list);
+	// widens the range to the midi notes of the samples in the folder
+	void extendMidiNoteRange(wxString folderPath, int &firstMidiNote, int &lastMidiNote);
+	bool getSampleNameInfo(wxString fullPath, SampleNameInfo &info);
+	bool isPatternValid() const;
+	unsigned getNumberOfIndexedFiles();
+
+private:
+	class IndexedFolder {
+	public:
+		bool isOpened;
+		wxArrayString subFolders;
+		std::map<int, wxArrayString> filesByMidiNote;
+		std::map<wxString, SampleNameInfo> nameInfos;
+	};
+
+	SamplePattern m_pattern;
+	unsigned m_indexedFiles;
+	std::map<wxString, IndexedFolder> m_folders;
+
+	IndexedFolder& getFolder(wxString folderPath);
+	void indexFolder(wxString folderPath, IndexedFolder &folder);
+	void addFileToMidiNote(wxString folderPath, wxString fileName, IndexedFolder &folder);
+};
+
+#endif
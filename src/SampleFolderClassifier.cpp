@@ -0,0 +1,246 @@
+/*
+ * SampleFolderClassifier.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleFolderClassifier.h"
+#include <wx/textfile.h>
+#include <wx/filefn.h>
+#include <algorithm>
+#include <mutex>
+
+// the user rules are shared by every import, also those running in worker threads
+static std::vector<SampleFolderRule> userRules;
+static std::mutex userRuleMutex;
+
+SampleFolderInfo::SampleFolderInfo() {
+	name = wxEmptyString;
+	type = FOLDER_ATTACK;
+	maxKeyPressTime = -1;
+}
+
+SampleFolderRule::SampleFolderRule() {
+	pattern = wxEmptyString;
+	type = FOLDER_ATTACK;
+	extractKeyPressTime = true;
+	maxKeyPressTime = -1;
+}
+
+bool SampleFolderRule::matches(const wxString &lowerCaseName) const {
+	return wxMatchWild(pattern, lowerCaseName, false);
+}
+
+SampleFolderClassifier::SampleFolderClassifier(wxString releaseFolderPrefix, wxString tremulantFolderPrefix, bool extractKeyPressTime) {
+	m_extractKeyPressTime = extractKeyPressTime;
+	m_rules = getUserRules();
+
+	// the prefixes only need to be found somewhere in the folder name
+	if (releaseFolderPrefix != wxEmptyString) {
+		SampleFolderRule releaseRule;
+		releaseRule.pattern = wxT("*") + releaseFolderPrefix.Lower() + wxT("*");
+		releaseRule.type = FOLDER_RELEASE;
+		m_rules.push_back(releaseRule);
+	}
+	if (tremulantFolderPrefix != wxEmptyString) {
+		SampleFolderRule tremulantRule;
+		tremulantRule.pattern = wxT("*") + tremulantFolderPrefix.Lower() + wxT("*");
+		tremulantRule.type = FOLDER_TREMULANT;
+		m_rules.push_back(tremulantRule);
+	}
+}
+
+SampleFolderClassifier::~SampleFolderClassifier() {
+
+}
+
+void SampleFolderClassifier::classifyFolders(SampleDirectoryIndex &index, wxString rootPath) {
+	m_releaseFolders.clear();
+	m_tremulantFolders.clear();
+
+	const wxArrayString &allFolders = index.getSubFolders(rootPath);
+	for (unsigned i = 0; i < allFolders.GetCount(); i++) {
+		SampleFolderInfo info = classifyFolder(allFolders.Item(i));
+
+		if (info.type == FOLDER_RELEASE) {
+			m_releaseFolders.push_back(info);
+		} else if (info.type == FOLDER_TREMULANT) {
+			wxString tremulantPath = rootPath + wxFILE_SEP_PATH + info.name;
+			if (index.isFolderReadable(tremulantPath)) {
+				const wxArrayString &foldersInTremulantFolder = index.getSubFolders(tremulantPath);
+				for (unsigned j = 0; j < foldersInTremulantFolder.GetCount(); j++) {
+					SampleFolderInfo releaseInfo = classifyFolder(foldersInTremulantFolder.Item(j), true);
+					if (releaseInfo.type == FOLDER_TREMULANT_RELEASE)
+						info.releaseFolders.push_back(releaseInfo);
+				}
+			}
+			m_tremulantFolders.push_back(info);
+		}
+	}
+
+	auto byName = [](const SampleFolderInfo &a, const SampleFolderInfo &b) {
+		return a.name.Cmp(b.name) < 0;
+	};
+	std::sort(m_releaseFolders.begin(), m_releaseFolders.end(), byName);
+	for (SampleFolderInfo& tremulant : m_tremulantFolders) {
+		std::sort(tremulant.releaseFolders.begin(), tremulant.releaseFolders.end(), byName);
+	}
+}
+
+SampleFolderInfo SampleFolderClassifier::classifyFolder(wxString folderName, bool isInTremulantFolder) const {
+	SampleFolderInfo info;
+	info.name = folderName;
+
+	wxString lowerCaseName = folderName.Lower();
+	const SampleFolderRule *matchingRule = NULL;
+	for (const SampleFolderRule& rule : m_rules) {
+		if (rule.matches(lowerCaseName)) {
+			matchingRule = &rule;
+			break;
+		}
+	}
+
+	if (matchingRule) {
+		info.type = matchingRule->type;
+		if (!matchingRule->extractKeyPressTime)
+			info.maxKeyPressTime = matchingRule->maxKeyPressTime;
+	}
+
+	// releases inside a tremulant folder belong to the tremulant
+	if (isInTremulantFolder)
+		info.type = info.type == FOLDER_RELEASE ? FOLDER_TREMULANT_RELEASE : FOLDER_ATTACK;
+
+	if ((!matchingRule || matchingRule->extractKeyPressTime) && m_extractKeyPressTime)
+		info.maxKeyPressTime = parseKeyPressTime(folderName);
+
+	return info;
+}
+
+const std::vector<SampleFolderInfo>& SampleFolderClassifier::getReleaseFolders() const {
+	return m_releaseFolders;
+}
+
+const std::vector<SampleFolderInfo>& SampleFolderClassifier::getTremulantFolders() const {
+	return m_tremulantFolders;
+}
+
+bool SampleFolderClassifier::hasTremulantFolders() const {
+	return !m_tremulantFolders.empty();
+}
+
+int SampleFolderClassifier::parseKeyPressTime(wxString folderName) {
+	// the first number in the folder name is used if it has at least 2 digits
+	unsigned firstDigit = 0;
+	while (firstDigit < folderName.Length() && !wxIsdigit(folderName.GetChar(firstDigit)))
+		firstDigit++;
+
+	if (firstDigit == folderName.Length())
+		return -1;
+
+	unsigned lastDigit = firstDigit;
+	while (lastDigit < folderName.Length() && wxIsdigit(folderName.GetChar(lastDigit)))
+		lastDigit++;
+
+	long keyPressTime = -1;
+	if (!folderName.Mid(firstDigit, lastDigit - firstDigit).ToLong(&keyPressTime))
+		return -1;
+
+	if (keyPressTime > 9 && keyPressTime < 99999)
+		return keyPressTime;
+
+	return -1;
+}
+
+bool SampleFolderClassifier::parseRule(wxString line, SampleFolderRule &rule) {
+	line.Trim(false);
+	line.Trim(true);
+	if (line.IsEmpty() || line.StartsWith(wxT("#")))
+		return false;
+
+	int separator = line.Find('=');
+	if (separator == wxNOT_FOUND)
+		return false;
+
+	wxString pattern = line.Left(separator).Trim(true);
+
+	// the values may be separated by any number of spaces
+	wxArrayString values;
+	wxArrayString parts = wxSplit(line.Mid(separator + 1), ' ', '\0');
+	for (unsigned i = 0; i < parts.GetCount(); i++) {
+		if (!parts.Item(i).IsEmpty())
+			values.Add(parts.Item(i));
+	}
+	if (pattern.IsEmpty() || values.IsEmpty() || values.GetCount() > 2)
+		return false;
+
+	wxString type = values.Item(0).Lower();
+	if (type == wxT("attack"))
+		rule.type = FOLDER_ATTACK;
+	else if (type == wxT("release"))
+		rule.type = FOLDER_RELEASE;
+	else if (type == wxT("tremulant"))
+		rule.type = FOLDER_TREMULANT;
+	else
+		return false;
+
+	rule.pattern = pattern.Lower();
+	rule.extractKeyPressTime = true;
+	rule.maxKeyPressTime = -1;
+	if (values.GetCount() == 2) {
+		wxString keyPressTime = values.Item(1).Lower();
+		long time;
+		if (keyPressTime == wxT("none")) {
+			rule.extractKeyPressTime = false;
+		} else if (keyPressTime.ToLong(&time) && time > 0 && time < 99999) {
+			rule.extractKeyPressTime = false;
+			rule.maxKeyPressTime = time;
+		} else if (keyPressTime != wxT("auto")) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool SampleFolderClassifier::loadUserRules(wxString ruleFile) {
+	std::vector<SampleFolderRule> rules;
+	if (wxFileExists(ruleFile)) {
+		wxTextFile ruleText;
+		if (!ruleText.Open(ruleFile, wxConvUTF8))
+			return false;
+
+		for (size_t i = 0; i < ruleText.GetLineCount(); i++) {
+			SampleFolderRule rule;
+			if (parseRule(ruleText.GetLine(i), rule))
+				rules.push_back(rule);
+		}
+		ruleText.Close();
+	}
+
+	setUserRules(rules);
+	return true;
+}
+
+void SampleFolderClassifier::setUserRules(const std::vector<SampleFolderRule> &rules) {
+	std::lock_guard<std::mutex> lock(userRuleMutex);
+	userRules = rules;
+}
+
+std::vector<SampleFolderRule> SampleFolderClassifier::getUserRules() {
+	std::lock_guard<std::mutex> lock(userRuleMutex);
+	return userRules;
+}
@@ -0,0 +1,91 @@
+/*
+ * SampleFolderClassifier.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEFOLDERCLASSIFIER_H
+#define SAMPLEFOLDERCLASSIFIER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include "SampleDirectoryIndex.h"
+
+enum SAMPLE_FOLDER_TYPE {
+	FOLDER_ATTACK,
+	FOLDER_RELEASE,
+	FOLDER_TREMULANT,
+	FOLDER_TREMULANT_RELEASE
+};
+
+// The outcome of classifying one sample folder. Release folders found inside
+// a tremulant folder are kept together with it.
+class SampleFolderInfo {
+public:
+	SampleFolderInfo();
+
+	wxString name;
+	int type;
+	int maxKeyPressTime;
+	std::vector<SampleFolderInfo> releaseFolders;
+};
+
+// One line of the rule table, like "rel-*ms = release" or "r?_long = release none".
+// The pattern is matched case insensitive against the folder name with * and ?
+// as wildcards. The key press time is either taken from the first number in
+// the folder name (auto), given explicitly or left out (none).
+class SampleFolderRule {
+public:
+	SampleFolderRule();
+
+	wxString pattern;
+	int type;
+	bool extractKeyPressTime;
+	int maxKeyPressTime;
+
+	bool matches(const wxString &lowerCaseName) const;
+};
+
+// Decides once per import what the folders of a sample set hold, so that all
+// the pipes of a rank can share the result instead of each looking at every
+// folder name again. Rules from the user rule table are tried first, in order,
+// then the release and tremulant folder prefixes as before.
+class SampleFolderClassifier {
+public:
+	SampleFolderClassifier(wxString releaseFolderPrefix, wxString tremulantFolderPrefix, bool extractKeyPressTime);
+	~SampleFolderClassifier();
+
+	void classifyFolders(SampleDirectoryIndex &index, wxString rootPath);
+	SampleFolderInfo classifyFolder(wxString folderName, bool isInTremulantFolder = false) const;
+	const std::vector<SampleFolderInfo>& getReleaseFolders() const;
+	const std::vector<SampleFolderInfo>& getTremulantFolders() const;
+	bool hasTremulantFolders() const;
+
+	static int parseKeyPressTime(wxString folderName);
+	static bool parseRule(wxString line, SampleFolderRule &rule);
+	static bool loadUserRules(wxString ruleFile);
+	static void setUserRules(const std::vector<SampleFolderRule> &rules);
+	static std::vector<SampleFolderRule> getUserRules();
+
+private:
+	std::vector<SampleFolderRule> m_rules;
+	bool m_extractKeyPressTime;
+	std::vector<SampleFolderInfo> m_releaseFolders;
+	std::vector<SampleFolderInfo> m_tremulantFolders;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * SampleHeaderPrefetcher.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleHeaderPrefetcher.h"
+#include <thread>
+
+// enough reads in flight for the disk to reorder them, but not so many threads that they get costly
+static unsigned const MIN_QUEUE_DEPTH = 32;
+static unsigned const MAX_QUEUE_DEPTH = 128;
+
+static unsigned defaultQueueDepth() {
+	unsigned depth = std::thread::hardware_concurrency() * 4;
+	if (depth < MIN_QUEUE_DEPTH)
+		depth = MIN_QUEUE_DEPTH;
+	if (depth > MAX_QUEUE_DEPTH)
+		depth = MAX_QUEUE_DEPTH;
+	return depth;
+}
+
+SampleHeaderPrefetcher::SampleHeaderPrefetcher(SampleMetadataCache *cache, unsigned queueDepth) :
+	m_pool(queueDepth ? queueDepth : defaultQueueDepth()) {
+	m_cache = cache;
+}
+
+SampleHeaderPrefetcher::~SampleHeaderPrefetcher() {
+
+}
+
+unsigned SampleHeaderPrefetcher::getQueueDepth() {
+	return m_pool.getNumberOfThreads();
+}
+
+bool SampleHeaderPrefetcher::fetch(
+	const std::vector<wxString> &fullPaths,
+	std::function<void(unsigned index, bool found, const SampleMetadata &metadata)> onFetched,
+	BackgroundTask *task
+) {
+	m_pool.parallelFor(fullPaths.size(), [&](unsigned i) {
+		if (task && task->isCancelled())
+			return;
+
+		SampleMetadata metadata;
+		bool found = m_cache->getMetadata(fullPaths[i], metadata);
+		if (onFetched)
+			onFetched(i, found, metadata);
+
+		if (task)
+			task->stepDone();
+	});
+
+	return !(task && task->isCancelled());
+}
+
+bool SampleHeaderPrefetcher::warmCache(const std::vector<wxString> &fullPaths, BackgroundTask *task) {
+	return fetch(fullPaths, NULL, task);
+}
@@ -0,0 +1,57 @@
+/*
+ * SampleHeaderPrefetcher.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEHEADERPREFETCHER_H
+#define SAMPLEHEADERPREFETCHER_H
+
+#include <wx/wx.h>
+#include <vector>
+#include <functional>
+#include "SampleMetadataCache.h"
+#include "BackgroundTask.h"
+#include "WorkerPool.h"
+
+// Reads the headers of many sample files through the metadata cache with a
+// deep queue of reads in flight. The threads mostly wait for the disk, so
+// there are many more of them than there are cores, which keeps a spinning
+// disk or a network mount busy instead of waiting on one open and seek at a
+// time. Each result is handed to the callback as soon as it's done, on the
+// thread that read it, so the callback must be safe to run concurrently.
+class SampleHeaderPrefetcher {
+public:
+	SampleHeaderPrefetcher(SampleMetadataCache *cache, unsigned queueDepth = 0);
+	~SampleHeaderPrefetcher();
+
+	unsigned getQueueDepth();
+	// found is false if the file couldn't be found, returns false if cancelled
+	bool fetch(
+		const std::vector<wxString> &fullPaths,
+		std::function<void(unsigned index, bool found, const SampleMetadata &metadata)> onFetched,
+		BackgroundTask *task = NULL
+	);
+	// only fills the cache so that later lookups are answered from memory
+	bool warmCache(const std::vector<wxString> &fullPaths, BackgroundTask *task = NULL);
+
+private:
+	SampleMetadataCache *m_cache;
+	WorkerPool m_pool;
+};
+
+#endif
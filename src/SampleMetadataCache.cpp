@@ -0,0 +1,267 @@
+/*
+ * SampleMetadataCache.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SampleMetadataCache.h"
+#include "WAVfileParser.h"
+#include <wx/textfile.h>
+#include <wx/filename.h>
+#include <wx/filefn.h>
+
+static wxString const CACHE_HEADER = wxT("GOODF sample metadata cache 4");
+
+// path, size, mtime, ok, error, frames, format, channels, rate, bits, cue, number of loops
+static unsigned const FIXED_FIELDS = 12;
+
+SampleMetadata::SampleMetadata() {
+	fileSize = 0;
+	modificationTime = 0;
+	isOk = false;
+	errorMessage = wxEmptyString;
+	numberOfFrames = 0;
+	audioFormat = 0;
+	numberOfChannels = 0;
+	sampleRate = 0;
+	bitsPerSample = 0;
+	cuePoint = -1;
+}
+
+SampleMetadataCache::SampleMetadataCache(wxString cacheFile) {
+	m_cacheFile = cacheFile;
+	m_isModified = false;
+}
+
+SampleMetadataCache::~SampleMetadataCache() {
+
+}
+
+bool SampleMetadataCache::load() {
+	if (!wxFileExists(m_cacheFile))
+		return false;
+
+	wxTextFile cache;
+	if (!cache.Open(m_cacheFile, wxConvUTF8))
+		return false;
+
+	if (cache.GetLineCount() == 0 || !cache.GetLine(0).IsSameAs(CACHE_HEADER)) {
+		// an unknown or older format is simply rebuilt as samples are parsed again
+		cache.Close();
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (size_t i = 1; i < cache.GetLineCount(); i++) {
+		wxString fullPath;
+		SampleMetadata metadata;
+		if (lineToEntry(cache.GetLine(i), fullPath, metadata))
+			m_entries[fullPath] = metadata;
+	}
+	cache.Close();
+	m_isModified = false;
+
+	return true;
+}
+
+bool SampleMetadataCache::save() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_isModified)
+		return true;
+
+	wxFileName cacheName(m_cacheFile);
+	if (!wxFileName::DirExists(cacheName.GetPath()) && !wxFileName::Mkdir(cacheName.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL))
+		return false;
+
+	wxTextFile cache(m_cacheFile);
+	if (cache.Exists()) {
+		if (!cache.Open(wxConvUTF8))
+			return false;
+		cache.Clear();
+	} else {
+		if (!cache.Create())
+			return false;
+	}
+
+	// samples that are gone are forgotten so the cache doesn't keep growing
+	cache.AddLine(CACHE_HEADER);
+	for (std::map<wxString, SampleMetadata>::iterator it = m_entries.begin(); it != m_entries.end();) {
+		if (!wxFileExists(it->first)) {
+			it = m_entries.erase(it);
+			continue;
+		}
+		cache.AddLine(entryToLine(it->first, it->second));
+		++it;
+	}
+
+	bool written = cache.Write(wxTextFileType_Unix, wxConvUTF8);
+	cache.Close();
+	if (written)
+		m_isModified = false;
+
+	return written;
+}
+
+bool SampleMetadataCache::getMetadata(wxString fullPath, SampleMetadata &metadata) {
+	wxULongLong_t fileSize;
+	long long modificationTime;
+	if (!readFileStatus(fullPath, fileSize, modificationTime))
+		return false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::map<wxString, SampleMetadata>::iterator it = m_entries.find(fullPath);
+		if (it != m_entries.end() && it->second.fileSize == fileSize && it->second.modificationTime == modificationTime) {
+			metadata = it->second;
+			return true;
+		}
+	}
+
+	// the file is parsed without holding the lock so that other threads can keep using the cache
+	SampleMetadata parsed;
+	parsed.fileSize = fileSize;
+	parsed.modificationTime = modificationTime;
+	parseSample(fullPath, parsed);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries[fullPath] = parsed;
+	m_isModified = true;
+	metadata = parsed;
+
+	return true;
+}
+
+bool SampleMetadataCache::hasChanged(wxString fullPath) {
+	wxULongLong_t fileSize;
+	long long modificationTime;
+	if (!readFileStatus(fullPath, fileSize, modificationTime))
+		return false;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// a file never parsed may have been replaced since its data was taken
+	std::map<wxString, SampleMetadata>::iterator it = m_entries.find(fullPath);
+	if (it == m_entries.end())
+		return true;
+
+	return it->second.fileSize != fileSize || it->second.modificationTime != modificationTime;
+}
+
+void SampleMetadataCache::clear() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_entries.empty())
+		m_isModified = true;
+	m_entries.clear();
+}
+
+unsigned SampleMetadataCache::getNumberOfEntries() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+bool SampleMetadataCache::readFileStatus(wxString fullPath, wxULongLong_t &fileSize, long long &modificationTime) {
+	wxULongLong size = wxFileName::GetSize(fullPath);
+	if (size == wxInvalidSize)
+		return false;
+
+	time_t mtime = wxFileModificationTime(fullPath);
+	if (mtime == (time_t) -1)
+		return false;
+
+	fileSize = size.GetValue();
+	modificationTime = mtime;
+	return true;
+}
+
+void SampleMetadataCache::parseSample(wxString fullPath, SampleMetadata &metadata) {
+	WAVfileParser sample(fullPath);
+	metadata.isOk = sample.isWavOk();
+	metadata.errorMessage = sample.getErrorMessage();
+	metadata.numberOfFrames = sample.getNumberOfFrames();
+	metadata.audioFormat = sample.getAudioFormat();
+	metadata.numberOfChannels = sample.getNumberOfChannels();
+	metadata.sampleRate = sample.getSampleRate();
+	metadata.bitsPerSample = sample.getBitsPerSample();
+	metadata.cuePoint = sample.getCuePoint();
+	metadata.loops = sample.getLoops();
+}
+
+wxString SampleMetadataCache::entryToLine(wxString fullPath, const SampleMetadata &metadata) {
+	wxString line = fullPath;
+	line += wxString::Format(wxT("\t%llu\t%lld\t%d\t"), (unsigned long long) metadata.fileSize, metadata.modificationTime, metadata.isOk ? 1 : 0);
+	line += metadata.errorMessage;
+	line += wxString::Format(
+		wxT("\t%u\t%u\t%u\t%u\t%u\t%d\t%u"),
+		metadata.numberOfFrames,
+		(unsigned) metadata.audioFormat,
+		(unsigned) metadata.numberOfChannels,
+		metadata.sampleRate,
+		(unsigned) metadata.bitsPerSample,
+		metadata.cuePoint,
+		(unsigned) metadata.loops.size()
+	);
+	for (const Loop& loop : metadata.loops) {
+		line += wxString::Format(wxT("\t%d\t%d"), loop.start, loop.end);
+	}
+	return line;
+}
+
+bool SampleMetadataCache::lineToEntry(wxString line, wxString &fullPath, SampleMetadata &metadata) {
+	// no escape character as backslashes are path separators on Windows
+	wxArrayString fields = wxSplit(line, '\t', '\0');
+	if (fields.GetCount() < FIXED_FIELDS)
+		return false;
+
+	wxULongLong_t fileSize;
+	long long modificationTime;
+	long numbers[8];
+	if (!fields.Item(1).ToULongLong(&fileSize) || !fields.Item(2).ToLongLong(&modificationTime))
+		return false;
+	if (!fields.Item(3).ToLong(&numbers[0]))
+		return false;
+	for (unsigned i = 5; i < FIXED_FIELDS; i++) {
+		if (!fields.Item(i).ToLong(&numbers[i - 4]))
+			return false;
+	}
+
+	unsigned numberOfLoops = numbers[7];
+	if (fields.GetCount() != FIXED_FIELDS + numberOfLoops * 2)
+		return false;
+
+	fullPath = fields.Item(0);
+	metadata.fileSize = fileSize;
+	metadata.modificationTime = modificationTime;
+	metadata.isOk = numbers[0] == 1;
+	metadata.errorMessage = fields.Item(4);
+	metadata.numberOfFrames = numbers[1];
+	metadata.audioFormat = numbers[2];
+	metadata.numberOfChannels = numbers[3];
+	metadata.sampleRate = numbers[4];
+	metadata.bitsPerSample = numbers[5];
+	metadata.cuePoint = numbers[6];
+	metadata.loops.clear();
+	for (unsigned i = 0; i < numberOfLoops; i++) {
+		long start, end;
+		if (!fields.Item(FIXED_FIELDS + i * 2).ToLong(&start) || !fields.Item(FIXED_FIELDS + i * 2 + 1).ToLong(&end))
+			return false;
+		Loop loop;
+		loop.start = start;
+		loop.end = end;
+		metadata.loops.push_back(loop);
+	}
+
+	return true;
+}
@@ -0,0 +1,78 @@
+/*
+ * SampleMetadataCache.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEMETADATACACHE_H
+#define SAMPLEMETADATACACHE_H
+
+#include <wx/wx.h>
+#include "Loop.h"
+#include <list>
+#include <map>
+#include <mutex>
+
+// The header information of one sample file as it was when last parsed
+class SampleMetadata {
+public:
+	SampleMetadata();
+
+	wxULongLong_t fileSize;
+	long long modificationTime;
+	bool isOk;
+	wxString errorMessage;
+	unsigned numberOfFrames;
+	unsigned short audioFormat;
+	unsigned short numberOfChannels;
+	unsigned sampleRate;
+	unsigned short bitsPerSample;
+	int cuePoint;
+	std::list<Loop> loops;
+};
+
+// Remembers the metadata of every sample file that has been parsed, also
+// between sessions. An entry is only trusted as long as the size and the
+// modification time of the file still are the same, otherwise the file is
+// parsed again. Entries of files that are gone are dropped when the cache
+// is saved. Lookups may be done from several threads at once.
+class SampleMetadataCache {
+public:
+	SampleMetadataCache(wxString cacheFile);
+	~SampleMetadataCache();
+
+	bool load();
+	bool save();
+	bool getMetadata(wxString fullPath, SampleMetadata &metadata);
+	// true if the file differs from when its entry was made or has no entry, without parsing it
+	bool hasChanged(wxString fullPath);
+	void clear();
+	unsigned getNumberOfEntries();
+
+private:
+	wxString m_cacheFile;
+	bool m_isModified;
+	std::map<wxString, SampleMetadata> m_entries;
+	std::mutex m_mutex;
+
+	bool readFileStatus(wxString fullPath, wxULongLong_t &fileSize, long long &modificationTime);
+	void parseSample(wxString fullPath, SampleMetadata &metadata);
+	wxString entryToLine(wxString fullPath, const SampleMetadata &metadata);
+	bool lineToEntry(wxString line, wxString &fullPath, SampleMetadata &metadata);
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * SamplePath.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#include "SamplePath.h"
+#include <map>
+#include <mutex>
+
+// the folders are never removed so the pointers handed out stay valid, there
+// are only as many as folders with samples have been seen in this session
+static std::map<wxString, SampleFolder> sampleFolders;
+static wxString sampleBasePath;
+static std::mutex sampleFolderMutex;
+
+SamplePath::SamplePath() {
+	m_folder = NULL;
+}
+
+SamplePath::SamplePath(wxString fullPath) {
+	int separator = fullPath.Find(wxFILE_SEP_PATH, true);
+	if (separator == wxNOT_FOUND) {
+		m_folder = NULL;
+		m_name = fullPath;
+	} else {
+		m_folder = internFolder(fullPath.Left(separator));
+		m_name = fullPath.Mid(separator + 1);
+	}
+}
+
+wxString SamplePath::getFullPath() const {
+	if (!m_folder)
+		return m_name;
+
+	return m_folder->path + wxFILE_SEP_PATH + m_name;
+}
+
+wxString SamplePath::getRelativePath() const {
+	if (!m_folder)
+		return m_name;
+
+	// the relative path changes with the base path, which can happen from any thread
+	wxString relativePath;
+	{
+		std::lock_guard<std::mutex> lock(sampleFolderMutex);
+		relativePath = m_folder->relativePath;
+	}
+	if (relativePath.IsEmpty())
+		return m_name;
+
+	return relativePath + wxFILE_SEP_PATH + m_name;
+}
+
+wxString SamplePath::getFolderPath() const {
+	if (!m_folder)
+		return wxEmptyString;
+
+	return m_folder->path;
+}
+
+const wxString& SamplePath::getName() const {
+	return m_name;
+}
+
+bool SamplePath::isInFolder(const wxString &folderPath) const {
+	return m_folder && m_folder->path.IsSameAs(folderPath);
+}
+
+bool SamplePath::isDummy() const {
+	return !m_folder && m_name == wxT("DUMMY");
+}
+
+bool SamplePath::isReference() const {
+	return !m_folder && m_name.StartsWith(wxT("REF"));
+}
+
+void SamplePath::setBasePath(wxString basePath) {
+	std::lock_guard<std::mutex> lock(sampleFolderMutex);
+	if (basePath == sampleBasePath)
+		return;
+
+	sampleBasePath = basePath;
+	for (auto& folder : sampleFolders) {
+		folder.second.relativePath = makeRelative(folder.second.path, sampleBasePath);
+	}
+}
+
+unsigned SamplePath::getNumberOfFolders() {
+	std::lock_guard<std::mutex> lock(sampleFolderMutex);
+	return sampleFolders.size();
+}
+
+const SampleFolder* SamplePath::internFolder(wxString folderPath) {
+	std::lock_guard<std::mutex> lock(sampleFolderMutex);
+	std::map<wxString, SampleFolder>::iterator it = sampleFolders.find(folderPath);
+	if (it != sampleFolders.end())
+		return &it->second;
+
+	SampleFolder &folder = sampleFolders[folderPath];
+	folder.path = folderPath;
+	folder.relativePath = makeRelative(folderPath, sampleBasePath);
+	return &folder;
+}
+
+wxString SamplePath::makeRelative(wxString folderPath, wxString basePath) {
+	// without a base path the full path is used just as before
+	if (basePath.IsEmpty())
+		return folderPath;
+
+	wxString relative;
+	if (folderPath == basePath)
+		return wxEmptyString;
+	if (folderPath.StartsWith(basePath + wxFILE_SEP_PATH, &relative))
+		return relative;
+
+	return folderPath;
+}
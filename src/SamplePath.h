@@ -0,0 +1,65 @@
+/*
+ * SamplePath.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+#ifndef SAMPLEPATH_H
+#define SAMPLEPATH_H
+
+#include <wx/wx.h>
+
+// A folder that sample files are stored in, shared by all samples in it
+class SampleFolder {
+public:
+	wxString path;
+	wxString relativePath;
+};
+
+// The path of a sample file kept as a shared folder plus the name of the
+// file. The path relative to the odf root is taken from the folder so when
+// the root changes only the folders need updating, not every sample. Values
+// without any folder like DUMMY or REF:xxx:yyy:zzz are kept as they are. The
+// base path is the odf root of the organ the frame shows, set through
+// Organ::setOdfRoot() only.
+class SamplePath {
+public:
+	SamplePath();
+	SamplePath(wxString fullPath);
+
+	wxString getFullPath() const;
+	wxString getRelativePath() const;
+	wxString getFolderPath() const;
+	const wxString& getName() const;
+	bool isInFolder(const wxString &folderPath) const;
+	// told from the name alone, without putting the full path together
+	bool isDummy() const;
+	bool isReference() const;
+
+	static void setBasePath(wxString basePath);
+	static unsigned getNumberOfFolders();
+	// only a leading base path is removed, any other path is returned as it is
+	static wxString makeRelative(wxString folderPath, wxString basePath);
+
+private:
+	const SampleFolder *m_folder;
+	wxString m_name;
+
+	static const SampleFolder* internFolder(wxString folderPath);
+};
+
+#endif
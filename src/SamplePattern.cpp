@@ -0,0 +1,227 @@
+/*
+ * SamplePattern.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#include "SamplePattern.h"
+
+SampleNameInfo::SampleNameInfo() {
+	midiNote = -1;
+	velocity = -1;
+	releaseTime = -1;
+	name = wxEmptyString;
+}
+
+SamplePattern::SamplePattern(wxString pattern) {
+	m_pattern = pattern;
+	m_isValid = false;
+	m_firstMidiNote = 0;
+	m_lastMidiNote = 127;
+	compile();
+}
+
+SamplePattern::~SamplePattern() {
+
+}
+
+bool SamplePattern::isValid() const {
+	return m_isValid;
+}
+
+wxString SamplePattern::getErrorMessage() const {
+	return m_errorMessage;
+}
+
+wxString SamplePattern::getPattern() const {
+	return m_pattern;
+}
+
+void SamplePattern::setMidiRange(int firstMidiNote, int lastMidiNote) {
+	m_firstMidiNote = firstMidiNote;
+	m_lastMidiNote = lastMidiNote;
+}
+
+bool SamplePattern::match(wxString fileName, SampleNameInfo &info) const {
+	if (!m_isValid)
+		return false;
+
+	info = SampleNameInfo();
+	return matchFrom(0, fileName.Lower(), 0, info);
+}
+
+void SamplePattern::compile() {
+	m_tokens.clear();
+	m_isValid = false;
+
+	bool hasMidiToken = false;
+	unsigned i = 0;
+	while (i < m_pattern.Length()) {
+		wxChar c = m_pattern.GetChar(i);
+		if (c == '{') {
+			size_t closing = m_pattern.find('}', i);
+			if (closing == wxString::npos) {
+				m_errorMessage = wxT("Missing } in sample name pattern!");
+				return;
+			}
+			if (!compilePlaceholder(m_pattern.Mid(i + 1, closing - i - 1)))
+				return;
+			if (m_tokens.back().type == MIDI)
+				hasMidiToken = true;
+			i = closing + 1;
+		} else if (c == '*') {
+			// several wildcards in a row are the same as one
+			if (m_tokens.empty() || m_tokens.back().type != ANY_TEXT) {
+				Token t;
+				t.type = ANY_TEXT;
+				t.width = 0;
+				m_tokens.push_back(t);
+			}
+			i++;
+		} else {
+			addLiteral(c);
+			i++;
+		}
+	}
+
+	if (!hasMidiToken) {
+		m_errorMessage = wxT("Sample name pattern must contain {midi}!");
+		return;
+	}
+
+	m_errorMessage = wxEmptyString;
+	m_isValid = true;
+}
+
+bool SamplePattern::compilePlaceholder(wxString placeholder) {
+	Token t;
+	t.width = 0;
+	wxString tokenName = placeholder.BeforeFirst(':').Lower();
+
+	if (tokenName == wxT("midi") || tokenName == wxT("vel") || tokenName == wxT("rel")) {
+		if (tokenName == wxT("midi"))
+			t.type = MIDI;
+		else if (tokenName == wxT("vel"))
+			t.type = VELOCITY;
+		else
+			t.type = RELEASE_TIME;
+
+		if (placeholder.Find(':') != wxNOT_FOUND) {
+			unsigned long width = 0;
+			if (!placeholder.AfterFirst(':').ToULong(&width) || width == 0 || width > 9) {
+				m_errorMessage = wxT("Invalid digit count in {") + placeholder + wxT("}!");
+				return false;
+			}
+			t.width = width;
+		}
+	} else if (tokenName == wxT("name")) {
+		t.type = NAME;
+	} else if (placeholder.Find('|') != wxNOT_FOUND) {
+		t.type = ALTERNATIVES;
+		wxString rest = placeholder.Lower();
+		while (true) {
+			t.alternatives.Add(rest.BeforeFirst('|'));
+			if (rest.Find('|') == wxNOT_FOUND)
+				break;
+			rest = rest.AfterFirst('|');
+		}
+	} else {
+		m_errorMessage = wxT("Unknown placeholder {") + placeholder + wxT("} in sample name pattern!");
+		return false;
+	}
+
+	m_tokens.push_back(t);
+	return true;
+}
+
+void SamplePattern::addLiteral(wxChar c) {
+	if (m_tokens.empty() || m_tokens.back().type != LITERAL) {
+		Token t;
+		t.type = LITERAL;
+		t.width = 0;
+		m_tokens.push_back(t);
+	}
+	m_tokens.back().text += wxString(c).Lower();
+}
+
+bool SamplePattern::matchFrom(unsigned tokenIndex, const wxString &name, unsigned pos, SampleNameInfo &info) const {
+	if (tokenIndex == m_tokens.size())
+		return pos == name.Length();
+
+	const Token &t = m_tokens[tokenIndex];
+	switch (t.type) {
+		case LITERAL:
+			if (name.compare(pos, t.text.Length(), t.text) != 0)
+				return false;
+			return matchFrom(tokenIndex + 1, name, pos + t.text.Length(), info);
+
+		case ALTERNATIVES:
+			for (unsigned i = 0; i < t.alternatives.GetCount(); i++) {
+				const wxString &alt = t.alternatives.Item(i);
+				if (name.compare(pos, alt.Length(), alt) == 0 && matchFrom(tokenIndex + 1, name, pos + alt.Length(), info))
+					return true;
+			}
+			return false;
+
+		case ANY_TEXT:
+		case NAME:
+			// the shortest text that lets the rest match wins, except at the
+			// start of the pattern where the longest one does so that in
+			// vel64_036.wav the number closest to the end is the midi note
+			for (unsigned n = 0; n <= name.Length() - pos; n++) {
+				unsigned end = tokenIndex == 0 ? name.Length() - n : pos + n;
+				if (matchFrom(tokenIndex + 1, name, end, info)) {
+					if (t.type == NAME)
+						info.name = name.Mid(pos, end - pos);
+					return true;
+				}
+			}
+			return false;
+
+		case MIDI:
+		case VELOCITY:
+		case RELEASE_TIME: {
+			// a number must be a whole run of digits
+			if (pos > 0 && wxIsdigit(name.GetChar(pos - 1)))
+				return false;
+			unsigned end = pos;
+			while (end < name.Length() && wxIsdigit(name.GetChar(end)))
+				end++;
+			if (end == pos || end - pos > 9 || (t.width > 0 && end - pos != t.width))
+				return false;
+
+			long value = 0;
+			name.Mid(pos, end - pos).ToLong(&value);
+			if (t.type == MIDI && (value < m_firstMidiNote || value > m_lastMidiNote))
+				return false;
+
+			if (!matchFrom(tokenIndex + 1, name, end, info))
+				return false;
+
+			if (t.type == MIDI)
+				info.midiNote = value;
+			else if (t.type == VELOCITY)
+				info.velocity = value;
+			else
+				info.releaseTime = value;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,94 @@
+/*
+ * SamplePattern.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#ifndef SAMPLEPATTERN_H
+#define SAMPLEPATTERN_H
+
+#include <wx/wx.h>
+#include <vector>
+
+#define DEFAULT_SAMPLE_PATTERN wxT("*{midi}*.{wav|wv}")
+
+// What could be read out of a sample file name, -1 when not in the pattern
+class SampleNameInfo {
+public:
+	SampleNameInfo();
+
+	int midiNote;
+	int velocity;
+	int releaseTime;
+	wxString name;
+};
+
+// A file name template compiled once and then matched against many names.
+//   {midi} or {midi:03}  midi note number, optionally with a fixed digit count
+//   {vel}                velocity layer number
+//   {rel}                release (key press) time in ms
+//   {name}               any text, matched like *
+//   {wav|wv}             one of the alternatives
+//   *                    any text, at the start of the pattern as much as
+//                        possible, elsewhere as little as possible
+// Everything else must match literally, case is ignored. Number tokens
+// only match a complete run of digits, so {midi} never matches 36 in 136.
+class SamplePattern {
+public:
+	SamplePattern(wxString pattern = DEFAULT_SAMPLE_PATTERN);
+	~SamplePattern();
+
+	bool isValid() const;
+	wxString getErrorMessage() const;
+	wxString getPattern() const;
+	void setMidiRange(int firstMidiNote, int lastMidiNote);
+	bool match(wxString fileName, SampleNameInfo &info) const;
+
+private:
+	enum TokenType {
+		LITERAL,
+		ANY_TEXT,
+		NAME,
+		ALTERNATIVES,
+		MIDI,
+		VELOCITY,
+		RELEASE_TIME
+	};
+
+	class Token {
+	public:
+		TokenType type;
+		wxString text;
+		wxArrayString alternatives;
+		unsigned width;
+	};
+
+	wxString m_pattern;
+	std::vector<Token> m_tokens;
+	bool m_isValid;
+	wxString m_errorMessage;
+	int m_firstMidiNote;
+	int m_lastMidiNote;
+
+	void compile();
+	bool compilePlaceholder(wxString placeholder);
+	void addLiteral(wxChar c);
+	bool matchFrom(unsigned tokenIndex, const wxString &name, unsigned pos, SampleNameInfo &info) const;
+};
+
+#endif
@@ -32,10 +32,6 @@ Stop::Stop() : Drawstop() {
 	m_owningManual = NULL;
 }
 
-Stop::~Stop() {
-
-}
-
 void Stop::write(wxTextFile *outFile) {
 	Drawstop::write(outFile);
 	outFile->AddLine(wxT("FirstAccessiblePipeLogicalKeyNumber=") + wxString::Format(wxT("%i"), m_FirstAccessiblePipeLogicalKeyNumber));
@@ -66,7 +62,7 @@ void Stop::write(wxTextFile *outFile) {
 
 }
 
-void Stop::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manual) {
+void Stop::read(OdfReader *cfg, bool usingOldPanelFormat, Manual* owning_manual, bool readingPipes) {
 	m_owningManual = owning_manual;
 	Drawstop::read(cfg, usingOldPanelFormat);
 	int firstPipeKeyNbr = static_cast<int>(cfg->ReadLong("FirstAccessiblePipeLogicalKeyNumber", 1));
@@ -109,7 +105,7 @@ void Stop::read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manu
 	} else {
 		// this stop uses an internal rank that must be read
 		m_usingInternalRank = true;
-		m_internalRank.read(cfg);
+		m_internalRank.read(cfg, readingPipes);
 	}
 }
 
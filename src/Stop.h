@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include "Drawstop.h"
 #include <list>
 #include "RankReference.h"
@@ -33,10 +33,9 @@ class Manual;
 class Stop : public Drawstop {
 public:
 	Stop();
-	~Stop();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat, Manual* owning_manual);
+	void read(OdfReader *cfg, bool usingOldPanelFormat, Manual* owning_manual, bool readingPipes = true);
 
 	Rank* getRankAt(unsigned index);
 	RankReference* getRankReferenceAt(unsigned index);
@@ -707,6 +707,9 @@ void StopPanel::OnUseInternalRankSelection(wxCommandEvent& event) {
 void StopPanel::OnRemoveStopBtn(wxCommandEvent& WXUNUSED(event)) {
 	wxMessageDialog msg(this, wxT("Are you really sure you want to delete this stop?"), wxT("Are you sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 	if (msg.ShowModal() == wxID_YES) {
+		// pipes not read yet can borrow from this stop
+		if (!::wxGetApp().m_frame->ReadUnreadPipes())
+			return;
 		// references to this stop are removed in manual and in any generals
 		// and when the organ removes this stop any gui representations are removed too from panels
 		::wxGetApp().m_frame->RemoveCurrentItemFromOrgan();
@@ -45,7 +45,7 @@ void Tremulant::write(wxTextFile *outFile) {
 	}
 }
 
-void Tremulant::read(wxFileConfig *cfg, bool usingOldPanelFormat) {
+void Tremulant::read(OdfReader *cfg, bool usingOldPanelFormat) {
 	Drawstop::read(cfg, usingOldPanelFormat);
 	wxString typeValue = cfg->Read("TremulantType", wxT("Synth"));
 	if (typeValue.IsSameAs(wxT("Synth"), false)) {
@@ -31,7 +31,7 @@ public:
 	~Tremulant();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg, bool usingOldPanelFormat);
+	void read(OdfReader *cfg, bool usingOldPanelFormat);
 
 	int getAmpModDepth();
 	void setAmpModDepth(int ampModDepth);
@@ -21,27 +21,65 @@
 #include "WAVfileParser.h"
 #include <climits>
 
-wxString const WAVE_RIFF = wxT("RIFF");
-wxString const WAVE_ID = wxT("WAVE");
-wxString const WAVE_FMT = wxT("fmt ");
-wxString const WAVE_DATA = wxT("data");
-wxString const WVPK_ID = wxT("wvpk");
+// the wavpack block flags that describe the audio format
+static unsigned short const WAVPACK_MIN_VERSION = 0x402;
+static unsigned short const WAVPACK_MAX_VERSION = 0x410;
+static unsigned const WAVPACK_BYTES_STORED = 0x3;
+static unsigned const WAVPACK_MONO_FLAG = 0x4;
+static unsigned const WAVPACK_FLOAT_DATA = 0x80;
+static unsigned const WAVPACK_INITIAL_BLOCK = 0x800;
+static unsigned const WAVPACK_SHIFT_LSB = 13;
+static unsigned const WAVPACK_SHIFT_MASK = 0x1f << WAVPACK_SHIFT_LSB;
+static unsigned const WAVPACK_SRATE_LSB = 23;
+static unsigned const WAVPACK_SRATE_MASK = 0xf << WAVPACK_SRATE_LSB;
+static unsigned const WAVPACK_DSD_FLAG = 0x80000000;
+static unsigned const WAVPACK_NUMBER_OF_RATES = 15;
+static unsigned const WAVPACK_SAMPLE_RATES[WAVPACK_NUMBER_OF_RATES] = {
+	6000, 8000, 9600, 11025, 12000, 16000, 22050, 24000,
+	32000, 44100, 48000, 64000, 88200, 96000, 192000
+};
 
 WAVfileParser::WAVfileParser(wxString file) {
 	m_wavpackUsed = false;
 	m_fileName = file;
 	m_errorMessage = wxEmptyString;
+	m_AudioFormat = 0;
+	m_NumChannels = 0;
+	m_SampleRate = 0;
+	m_ByteRate = 0;
+	m_BlockAlign = 0;
+	m_BitsPerSample = 0;
+	m_sampleFormat = 0;
+	m_dataSize = 0;
+	m_dataOffset = -1;
+	m_numberOfFrames = 0;
+	m_cuePoint = -1;
+	m_midiUnityNote = 0;
+	m_midiPitchFraction = 0;
 
-	if (tryParsingFile(m_fileName))
-		m_wavOk = true;
-	else
+	// the file is only opened and read once whatever kind of file it turns out to be
+	RiffChunkReader reader;
+	if (!reader.readFile(m_fileName)) {
+		m_errorMessage = reader.getErrorMessage();
 		m_wavOk = false;
+		return;
+	}
 
-	if (m_wavpackUsed) {
-		if (tryParsingWvFile(m_fileName))
-			m_wavOk = true;
-		else
-			m_wavOk = false;
+	if (reader.isWavpack()) {
+		m_wavpackUsed = true;
+		m_wavOk = tryParsingWvFile(reader);
+	} else {
+		m_wavOk = tryParsingFile(reader);
+	}
+
+	// loops and cues are read from the same chunks whether the wave is wrapped in wavpack or not
+	if (m_wavOk) {
+		const RiffChunk *smplChunk = reader.findChunk("smpl");
+		if (smplChunk)
+			parseSmplChunk(*smplChunk);
+		const RiffChunk *cueChunk = reader.findChunk("cue ");
+		if (cueChunk)
+			parseCueChunk(*cueChunk);
 	}
 }
 
@@ -56,190 +94,272 @@ unsigned WAVfileParser::getNumberOfFrames() {
 	return m_numberOfFrames;
 }
 
+unsigned short WAVfileParser::getAudioFormat() {
+	return m_AudioFormat;
+}
+
+unsigned short WAVfileParser::getSampleFormat() {
+	return m_sampleFormat;
+}
+
+unsigned short WAVfileParser::getNumberOfChannels() {
+	return m_NumChannels;
+}
+
+unsigned WAVfileParser::getSampleRate() {
+	return m_SampleRate;
+}
+
+unsigned short WAVfileParser::getBitsPerSample() {
+	return m_BitsPerSample;
+}
+
+bool WAVfileParser::isWavpack() {
+	return m_wavpackUsed;
+}
+
 wxString WAVfileParser::getErrorMessage() {
 	return m_errorMessage;
 }
 
-bool WAVfileParser::tryParsingFile(wxString file) {
-	wxFFileInputStream waveFile(file);
-
-	if (waveFile.IsOk()) {
-		char fourCBuffer[4];
-		unsigned uBuffer;
-		m_dataSize = 0;
-		bool dataFound = false;
-		bool fmtFound = false;
-		
-		waveFile.Read(fourCBuffer, 4);
-		if (waveFile.LastRead() != 4 || !WAVE_RIFF.IsSameAs(fourCBuffer)) {
-			if (WVPK_ID.IsSameAs(fourCBuffer))
-				m_wavpackUsed = true;
-			else
-				m_errorMessage = wxT("Not a RIFF file or a wavpack file.");
-			return false;
-		}
+const std::list<Loop>& WAVfileParser::getLoops() {
+	return m_loops;
+}
 
-		waveFile.Read(&uBuffer, 4); // filesize - 8 bytes
-		if (waveFile.LastRead() != 4) {
-			m_errorMessage = wxT("Couldn't read filesize.");
-			return false;
-		}
+int WAVfileParser::getCuePoint() {
+	return m_cuePoint;
+}
 
-		waveFile.Read(fourCBuffer, 4);
-		if (waveFile.LastRead() != 4 || !WAVE_ID.IsSameAs(fourCBuffer)) {
-			m_errorMessage = wxT("Not a WAVE file.");
-			return false;
-		}
-		
-		while (!waveFile.Eof()) {
-			// get next fourcc chunk
-			waveFile.Read(fourCBuffer, 4);
-			if (waveFile.LastRead() == 4) {
-				if (WAVE_FMT.IsSameAs(fourCBuffer) && !fmtFound) {
-					if (parseFmtChunk(waveFile)) {
-						fmtFound = true;
-						continue;
-					} else {
-						// if fmt chunk couldn't be parsed error message should already have been set
-						return false;
-					}
-				} else if (WAVE_DATA.IsSameAs(fourCBuffer) && !dataFound && fmtFound) {
-					dataFound = true;
-				}
-
-			} else {
-				break;
-			}
-
-			// get size of chunk so we know how far to skip until next chunk
-			waveFile.Read(&uBuffer, 4);
-			if (waveFile.LastRead() == 4) {
-				if (dataFound && m_dataSize == 0)
-					m_dataSize = uBuffer;
-			} else {
-				break;
-			}
-
-			waveFile.SeekI(uBuffer + (uBuffer & 1), wxFromCurrent);
-		}
-		
-		if (fmtFound && dataFound) {
-			m_numberOfFrames = m_dataSize / m_BlockAlign;
-			return true;
-		} else {
-			m_errorMessage = wxT("Chunks for fmt and/or data couldn't be found.");
-			return false;
-		}
-	} else {
-		m_errorMessage = wxT("Failed to open stream.");
+unsigned WAVfileParser::getMidiUnityNote() {
+	return m_midiUnityNote;
+}
+
+unsigned WAVfileParser::getMidiPitchFraction() {
+	return m_midiPitchFraction;
+}
+
+wxFileOffset WAVfileParser::getDataOffset() {
+	return m_dataOffset;
+}
+
+bool WAVfileParser::tryParsingFile(RiffChunkReader &reader) {
+	if (!reader.isRiff()) {
+		m_errorMessage = wxT("Not a RIFF file or a wavpack file.");
 		return false;
 	}
-}
 
-bool WAVfileParser::tryParsingWvFile(wxString file) {
-	wxFFileInputStream wvFile(file);
-	
-	if (wvFile.IsOk()) {
-		char fourCBuffer[4];
-		unsigned uBuffer;
-		
-		wvFile.Read(fourCBuffer, 4);
-		if (wvFile.LastRead() != 4 || !WVPK_ID.IsSameAs(fourCBuffer)) {
-			return false;
-		}
-		
-		wvFile.SeekI(8, wxFromCurrent);
-		
-		wvFile.Read(&uBuffer, 4);
-		if (wvFile.LastRead() != 4) {
-			return false;
-		}
-		
-		m_numberOfFrames = uBuffer;
-		
-		if (m_numberOfFrames == UINT_MAX)
-			return false;
-		else
-			return true;
-	} else {
+	if (!reader.hasFormType("WAVE")) {
+		m_errorMessage = wxT("Not a WAVE file.");
+		return false;
+	}
+
+	// only a data chunk coming after the fmt chunk is used
+	unsigned fmtIndex = 0;
+	const RiffChunk *fmtChunk = reader.findChunk("fmt ", 0, &fmtIndex);
+	const RiffChunk *dataChunk = fmtChunk ? reader.findChunk("data", fmtIndex + 1) : NULL;
+	if (!fmtChunk || !dataChunk) {
+		m_errorMessage = wxT("Chunks for fmt and/or data couldn't be found.");
+		return false;
+	}
+
+	if (!parseFmtChunk(*fmtChunk)) {
+		// if fmt chunk couldn't be parsed error message should already have been set
+		return false;
+	}
+
+	if (reader.isTruncated()) {
+		m_errorMessage = wxT("The file is truncated, a chunk goes past its end.");
 		return false;
 	}
+
+	m_dataSize = dataChunk->size;
+	m_dataOffset = dataChunk->offset;
+	m_numberOfFrames = m_dataSize / m_BlockAlign;
+	return true;
 }
 
-bool WAVfileParser::parseFmtChunk(wxFFileInputStream &wavFile) {
-	unsigned uBuffer;
-	unsigned short uShBuffer;
+bool WAVfileParser::tryParsingWvFile(RiffChunkReader &reader) {
+	if (reader.getNumberOfWavpackBlocks() == 0) {
+		m_errorMessage = wxT("No valid wavpack block found.");
+		return false;
+	}
 
-	wavFile.Read(&uBuffer, 4);
-	if (wavFile.LastRead() != 4 || uBuffer < 16) {
-		m_errorMessage = wxT("Couldn't read fmt chunk size.");
+	if (reader.isTruncated()) {
+		m_errorMessage = wxT("The file is truncated, the last wavpack block goes past its end.");
 		return false;
 	}
-	unsigned fmtChunkSize = uBuffer;
 
-	wavFile.Read(&uShBuffer, 2);
-	if (wavFile.LastRead() == 2) {
-		if(uShBuffer == 1 || uShBuffer == 3 || uShBuffer == 65534)
-			m_AudioFormat = uShBuffer; // we only support PCM, IEEE_FLOAT and EXTENSIBLE
-		else {
-			m_errorMessage = wxT("Unsupported wave format detected.");
+	const WavpackBlock &firstBlock = reader.getWavpackBlockAt(0);
+	if (firstBlock.version < WAVPACK_MIN_VERSION || firstBlock.version > WAVPACK_MAX_VERSION) {
+		m_errorMessage = wxT("Unsupported wavpack version.");
+		return false;
+	}
+	if (firstBlock.flags & WAVPACK_DSD_FLAG) {
+		m_errorMessage = wxT("Wavpack DSD audio is not supported.");
+		return false;
+	}
+
+	// the channels of a multichannel file are spread over several blocks with the same samples
+	unsigned samplesInBlocks = 0;
+	for (unsigned i = 0; i < reader.getNumberOfWavpackBlocks(); i++) {
+		const WavpackBlock &block = reader.getWavpackBlockAt(i);
+		if (block.flags & WAVPACK_INITIAL_BLOCK)
+			samplesInBlocks += block.blockSamples;
+	}
+
+	// the total is unknown if the encoder couldn't go back to write it, then the blocks are counted
+	if (firstBlock.totalSamples != UINT_MAX && firstBlock.blockIndex == 0) {
+		m_numberOfFrames = firstBlock.totalSamples;
+		if (samplesInBlocks < m_numberOfFrames) {
+			m_errorMessage = wxT("The file is truncated, wavpack blocks are missing at its end.");
 			return false;
 		}
 	} else {
-		m_errorMessage = wxT("Couldn't read audio format.");
-		return false;
+		m_numberOfFrames = samplesInBlocks;
 	}
 
-	wavFile.Read(&uShBuffer, 2);
-	if (wavFile.LastRead() == 2) {
-		m_NumChannels = uShBuffer;
-	} else {
-		m_errorMessage = wxT("Couldn't read number of channels.");
+	if (!parseWavpackFlags(firstBlock)) {
+		// if the flags couldn't be parsed error message should already have been set
 		return false;
 	}
 
-	wavFile.Read(&uBuffer, 4);
-	if (wavFile.LastRead() == 4) {
-		m_SampleRate = uBuffer;
-	} else {
-		m_errorMessage = wxT("Couldn't read samplerate.");
-		return false;
+	// the stored riff header has the format exactly as in the original wave file
+	const RiffChunk *fmtChunk = reader.findChunk("fmt ");
+	if (fmtChunk) {
+		unsigned short audioFormat = m_AudioFormat;
+		unsigned short numChannels = m_NumChannels;
+		unsigned sampleRate = m_SampleRate;
+		unsigned short bitsPerSample = m_BitsPerSample;
+		if (!parseFmtChunk(*fmtChunk)) {
+			m_AudioFormat = audioFormat;
+			m_sampleFormat = audioFormat;
+			m_NumChannels = numChannels;
+			m_SampleRate = sampleRate;
+			m_BitsPerSample = bitsPerSample;
+			m_BlockAlign = m_NumChannels * ((m_BitsPerSample + 7) / 8);
+			m_ByteRate = m_BlockAlign * m_SampleRate;
+			m_errorMessage = wxEmptyString;
+		}
 	}
+	m_dataSize = m_numberOfFrames * m_BlockAlign;
 
-	wavFile.Read(&uBuffer, 4);
-	if (wavFile.LastRead() == 4) {
-		m_ByteRate = uBuffer;
+	return true;
+}
+
+bool WAVfileParser::parseWavpackFlags(const WavpackBlock &block) {
+	unsigned bytesPerSample = (block.flags & WAVPACK_BYTES_STORED) + 1;
+	unsigned shift = (block.flags & WAVPACK_SHIFT_MASK) >> WAVPACK_SHIFT_LSB;
+	unsigned rateIndex = (block.flags & WAVPACK_SRATE_MASK) >> WAVPACK_SRATE_LSB;
+
+	if (block.flags & WAVPACK_FLOAT_DATA) {
+		m_AudioFormat = 3;
+		m_sampleFormat = 3;
+		m_BitsPerSample = 32;
 	} else {
-		m_errorMessage = wxT("Couldn't read byte rate.");
+		m_AudioFormat = 1;
+		m_sampleFormat = 1;
+		m_BitsPerSample = bytesPerSample * 8 > shift ? bytesPerSample * 8 - shift : bytesPerSample * 8;
+	}
+
+	if (block.numberOfChannels)
+		m_NumChannels = block.numberOfChannels;
+	else
+		m_NumChannels = (block.flags & WAVPACK_MONO_FLAG) ? 1 : 2;
+
+	if (rateIndex < WAVPACK_NUMBER_OF_RATES)
+		m_SampleRate = WAVPACK_SAMPLE_RATES[rateIndex];
+	else
+		m_SampleRate = block.sampleRate;
+
+	if (m_SampleRate == 0) {
+		m_errorMessage = wxT("Wavpack sample rate couldn't be found.");
 		return false;
 	}
 
-	wavFile.Read(&uShBuffer, 2);
-	if (wavFile.LastRead() == 2) {
-		m_BlockAlign = uShBuffer;
-	} else {
-		m_errorMessage = wxT("Couldn't read block align.");
+	m_BlockAlign = m_NumChannels * bytesPerSample;
+	m_ByteRate = m_BlockAlign * m_SampleRate;
+	return true;
+}
+
+bool WAVfileParser::parseFmtChunk(const RiffChunk &fmtChunk) {
+	if (fmtChunk.size < 16 || !fmtChunk.data) {
+		m_errorMessage = wxT("Couldn't read fmt chunk size.");
 		return false;
 	}
+	const unsigned char *fmt = fmtChunk.data;
 
-	wavFile.Read(&uShBuffer, 2);
-	if (wavFile.LastRead() == 2) {
-		m_BitsPerSample = uShBuffer;
-	} else {
-		m_errorMessage = wxT("Couldn't read bits per sample.");
+	unsigned short audioFormat = RiffChunkReader::readUnsignedShort(fmt);
+	if (audioFormat == 1 || audioFormat == 3 || audioFormat == 65534)
+		m_AudioFormat = audioFormat; // we only support PCM, IEEE_FLOAT and EXTENSIBLE
+	else {
+		m_errorMessage = wxT("Unsupported wave format detected.");
 		return false;
 	}
 
-	if (m_BlockAlign != (m_NumChannels * m_BitsPerSample / 8)) {
+	m_NumChannels = RiffChunkReader::readUnsignedShort(fmt + 2);
+	m_SampleRate = RiffChunkReader::readUnsigned(fmt + 4);
+	m_ByteRate = RiffChunkReader::readUnsigned(fmt + 8);
+	m_BlockAlign = RiffChunkReader::readUnsignedShort(fmt + 12);
+	m_BitsPerSample = RiffChunkReader::readUnsignedShort(fmt + 14);
+
+	// the extensible format tells the real one in the first bytes of its sub format guid
+	m_sampleFormat = m_AudioFormat;
+	if (m_AudioFormat == 65534 && fmtChunk.size >= 26)
+		m_sampleFormat = RiffChunkReader::readUnsignedShort(fmt + 24);
+
+	if (m_BlockAlign == 0 || m_BlockAlign != (m_NumChannels * m_BitsPerSample / 8)) {
 		m_errorMessage = wxT("Block align doesn't match (nChannels*bitsPerSample/8).");
 		return false;
 	}
 
-	if (fmtChunkSize > 16) {
-		unsigned bytesToSkip = fmtChunkSize - 16;
-		wavFile.SeekI(bytesToSkip + (bytesToSkip & 1), wxFromCurrent);
-		return true;
+	return true;
+}
+
+void WAVfileParser::parseSmplChunk(const RiffChunk &smplChunk) {
+	if (smplChunk.size < 36 || !smplChunk.data)
+		return;
+	const unsigned char *smpl = smplChunk.data;
+
+	m_midiUnityNote = RiffChunkReader::readUnsigned(smpl + 12);
+	m_midiPitchFraction = RiffChunkReader::readUnsigned(smpl + 16);
+	unsigned numberOfLoops = RiffChunkReader::readUnsigned(smpl + 28);
+
+	// each loop is id, type, start, end, fraction and play count
+	const unsigned char *loopData = smpl + 36;
+	unsigned loopsInChunk = (smplChunk.size - 36) / 24;
+	if (numberOfLoops > loopsInChunk)
+		numberOfLoops = loopsInChunk;
+
+	for (unsigned i = 0; i < numberOfLoops; i++) {
+		unsigned start = RiffChunkReader::readUnsigned(loopData + i * 24 + 8);
+		unsigned end = RiffChunkReader::readUnsigned(loopData + i * 24 + 12);
+		if (start >= end || (m_numberOfFrames && end >= m_numberOfFrames))
+			continue;
+
+		Loop loop;
+		loop.start = start;
+		loop.end = end;
+		m_loops.push_back(loop);
 	}
+}
 
-	return true;
+void WAVfileParser::parseCueChunk(const RiffChunk &cueChunk) {
+	if (cueChunk.size < 4 || !cueChunk.data)
+		return;
+	const unsigned char *cue = cueChunk.data;
+
+	// each cue point is id, position, chunk id, chunk start, block start and sample offset
+	unsigned numberOfCues = RiffChunkReader::readUnsigned(cue);
+	unsigned cuesInChunk = (cueChunk.size - 4) / 24;
+	if (numberOfCues > cuesInChunk)
+		numberOfCues = cuesInChunk;
+
+	// the last cue point in the sample is where the release starts
+	for (unsigned i = 0; i < numberOfCues; i++) {
+		unsigned sampleOffset = RiffChunkReader::readUnsigned(cue + 4 + i * 24 + 20);
+		if (sampleOffset > INT_MAX || (m_numberOfFrames && sampleOffset >= m_numberOfFrames))
+			continue;
+		if ((int) sampleOffset > m_cuePoint)
+			m_cuePoint = sampleOffset;
+	}
 }
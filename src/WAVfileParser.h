@@ -22,13 +22,9 @@
 #define WAVFILEPARSER_H
 
 #include <wx/wx.h>
-#include <wx/wfstream.h>
-
-extern wxString const WAVE_RIFF;
-extern wxString const WAVE_ID;
-extern wxString const WAVE_FMT;
-extern wxString const WAVE_DATA;
-extern wxString const WVPK_ID;
+#include "RiffChunkReader.h"
+#include "Loop.h"
+#include <list>
 
 class WAVfileParser {
 
@@ -38,7 +34,21 @@ public:
 	
 	bool isWavOk();
 	unsigned getNumberOfFrames();
+	unsigned short getAudioFormat();
+	// PCM = 1 or IEEE_FLOAT = 3, also when the format is EXTENSIBLE
+	unsigned short getSampleFormat();
+	unsigned short getNumberOfChannels();
+	unsigned getSampleRate();
+	unsigned short getBitsPerSample();
+	bool isWavpack();
 	wxString getErrorMessage();
+	// loops and cue point as stored in the smpl and cue chunks, the cue point is -1 if there is none
+	const std::list<Loop>& getLoops();
+	int getCuePoint();
+	unsigned getMidiUnityNote();
+	unsigned getMidiPitchFraction();
+	// where the audio data starts in the file, -1 if it's compressed by wavpack
+	wxFileOffset getDataOffset();
 
 private:
 	bool m_wavOk;
@@ -51,12 +61,21 @@ private:
 	unsigned m_ByteRate;
 	unsigned short m_BlockAlign;
 	unsigned short m_BitsPerSample;
+	unsigned short m_sampleFormat;
 	unsigned m_dataSize;
+	wxFileOffset m_dataOffset;
 	unsigned m_numberOfFrames;
+	std::list<Loop> m_loops;
+	int m_cuePoint;
+	unsigned m_midiUnityNote;
+	unsigned m_midiPitchFraction;
 	
-	bool tryParsingFile(wxString file);
-	bool tryParsingWvFile(wxString file);
-	bool parseFmtChunk(wxFFileInputStream &wavFile);
+	bool tryParsingFile(RiffChunkReader &reader);
+	bool tryParsingWvFile(RiffChunkReader &reader);
+	bool parseWavpackFlags(const WavpackBlock &block);
+	bool parseFmtChunk(const RiffChunk &fmtChunk);
+	void parseSmplChunk(const RiffChunk &smplChunk);
+	void parseCueChunk(const RiffChunk &cueChunk);
 };
 
 #endif
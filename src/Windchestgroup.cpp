@@ -58,7 +58,7 @@ void Windchestgroup::write(wxTextFile *outFile) {
 	}
 }
 
-void Windchestgroup::read(wxFileConfig *cfg) {
+void Windchestgroup::read(OdfReader *cfg) {
 	name = cfg->Read("Name", wxEmptyString);
 	int nbrEnclosures = static_cast<int>(cfg->ReadLong("NumberOfEnclosures", 0));
 	if (nbrEnclosures > 50)
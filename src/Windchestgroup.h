@@ -23,7 +23,7 @@
 
 #include <wx/wx.h>
 #include <wx/textfile.h>
-#include <wx/fileconf.h>
+#include "OdfReader.h"
 #include <list>
 #include "Enclosure.h"
 #include "Tremulant.h"
@@ -34,7 +34,7 @@ public:
 	~Windchestgroup();
 
 	void write(wxTextFile *outFile);
-	void read(wxFileConfig *cfg);
+	void read(OdfReader *cfg);
 
 	Enclosure* getEnclosureAt(unsigned index);
 	unsigned getNumberOfEnclosures();
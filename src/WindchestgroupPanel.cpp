@@ -253,6 +253,9 @@ void WindchestgroupPanel::OnRemoveReferencedTremulant(wxCommandEvent& WXUNUSED(e
 void WindchestgroupPanel::OnRemoveWindchestBtn(wxCommandEvent& WXUNUSED(event)) {
 	wxMessageDialog msg(this, wxT("Are you really sure you want to delete this windchestgroup?"), wxT("Are you sure?"), wxYES_NO|wxCENTRE|wxICON_EXCLAMATION);
 	if (msg.ShowModal() == wxID_YES) {
+		// the pipes not read yet can reference the windchest too
+		if (!::wxGetApp().m_frame->ReadUnreadPipes())
+			return;
 		// first remove all possible references to this windchest from ranks
 		unsigned numberOfRanks = ::wxGetApp().m_frame->m_organ->getNumberOfRanks();
 		for (unsigned i = 0; i < numberOfRanks; i++) {
@@ -260,7 +263,7 @@ void WindchestgroupPanel::OnRemoveWindchestBtn(wxCommandEvent& WXUNUSED(event))
 				::wxGetApp().m_frame->m_organ->getOrganRankAt(i)->setWindchest(NULL);
 			}
 			// also remove any possible reference in any pipe of this rank
-			for (Pipe p : ::wxGetApp().m_frame->m_organ->getOrganRankAt(i)->m_pipes) {
+			for (Pipe& p : ::wxGetApp().m_frame->m_organ->getOrganRankAt(i)->m_pipes) {
 				if (p.windchest == m_windchest)
 					p.windchest = NULL;
 			}
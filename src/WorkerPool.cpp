@@ -0,0 +1,134 @@
+/*
+ * WorkerPool.cpp is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#include "WorkerPool.h"
+#include <atomic>
+#include <exception>
+
+WorkerPool::WorkerPool(unsigned numberOfThreads) {
+	m_activeJobs = 0;
+	m_stopping = false;
+
+	if (numberOfThreads == 0)
+		numberOfThreads = std::thread::hardware_concurrency();
+	if (numberOfThreads == 0)
+		numberOfThreads = 2;
+
+	for (unsigned i = 0; i < numberOfThreads; i++)
+		m_threads.push_back(std::thread(&WorkerPool::workerLoop, this));
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_jobAvailable.notify_all();
+
+	for (std::thread& t : m_threads)
+		t.join();
+}
+
+unsigned WorkerPool::getNumberOfThreads() {
+	return m_threads.size();
+}
+
+void WorkerPool::submit(std::function<void()> job) {
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_jobs.push_back(job);
+	}
+	m_jobAvailable.notify_one();
+}
+
+void WorkerPool::waitUntilIdle() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]() { return m_jobs.empty() && m_activeJobs == 0; });
+}
+
+void WorkerPool::parallelFor(unsigned count, std::function<void(unsigned)> job) {
+	if (count == 0)
+		return;
+
+	// every runner keeps taking the next free index so that slow items
+	// don't leave the other threads waiting
+	std::atomic<unsigned> nextIndex(0);
+	unsigned runners = count < m_threads.size() ? count : m_threads.size();
+	unsigned finishedRunners = 0;
+	std::mutex finishedMutex;
+	std::condition_variable allFinished;
+	std::exception_ptr firstError;
+
+	for (unsigned i = 0; i < runners; i++) {
+		submit([&]() {
+			try {
+				unsigned index;
+				while ((index = nextIndex++) < count)
+					job(index);
+			} catch (...) {
+				// no more items are started once one has failed
+				nextIndex = count;
+				std::unique_lock<std::mutex> lock(finishedMutex);
+				if (!firstError)
+					firstError = std::current_exception();
+			}
+
+			std::unique_lock<std::mutex> lock(finishedMutex);
+			finishedRunners++;
+			allFinished.notify_one();
+		});
+	}
+
+	std::unique_lock<std::mutex> lock(finishedMutex);
+	allFinished.wait(lock, [&]() { return finishedRunners == runners; });
+	// what went wrong is handled on the thread that asked for the work
+	if (firstError)
+		std::rethrow_exception(firstError);
+}
+
+void WorkerPool::workerLoop() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_jobAvailable.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+			if (m_stopping && m_jobs.empty())
+				return;
+
+			job = m_jobs.front();
+			m_jobs.pop_front();
+			m_activeJobs++;
+		}
+
+		// a job that throws must not take the thread, and with it the whole program, down
+		try {
+			job();
+		} catch (...) {
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_activeJobs--;
+			if (m_jobs.empty() && m_activeJobs == 0)
+				m_idle.notify_all();
+		}
+	}
+}
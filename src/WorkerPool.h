@@ -0,0 +1,61 @@
+/*
+ * WorkerPool.h is part of GOODF.
+ * Copyright (C) 2023 Lars Palo
+ *
+ * GOODF is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GOODF is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GOODF.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * You can contact the author on larspalo(at)yahoo.se
+ */
+
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <deque>
+
+// A fixed set of worker threads that jobs can be handed to. The threads are
+// started once and kept waiting for work until the pool is destroyed.
+class WorkerPool {
+public:
+	WorkerPool(unsigned numberOfThreads = 0);
+	~WorkerPool();
+
+	unsigned getNumberOfThreads();
+	// what a submitted job throws is lost, so it must catch what it can't let go
+	void submit(std::function<void()> job);
+	void waitUntilIdle();
+
+	// runs job(0) ... job(count - 1) spread over the threads and returns when all are done,
+	// if a job throws no more are started and the first exception is thrown again here
+	// it must not be called from a job of the same pool, which would wait for itself
+	void parallelFor(unsigned count, std::function<void(unsigned)> job);
+
+private:
+	std::vector<std::thread> m_threads;
+	std::deque<std::function<void()>> m_jobs;
+	std::mutex m_mutex;
+	std::condition_variable m_jobAvailable;
+	std::condition_variable m_idle;
+	unsigned m_activeJobs;
+	bool m_stopping;
+
+	void workerLoop();
+};
+
+#endif